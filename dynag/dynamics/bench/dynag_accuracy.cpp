@@ -0,0 +1,208 @@
+/*
+* DynaG Dynamics C++ / Accuracy
+*
+* Accuracy regression harness of fast math kernels. Each scenario is flown by a
+* reference instance with standard library math and a candidate instance with fast
+* math from the same seed and actions. Normalized states of both instances are
+* compared at each step and the harness fails if any error exceeds the tolerance.
+* Open loop trajectories diverge from trim after a while, so small differences grow
+* with horizon and default horizon is 10 seconds.
+*
+* Reference trajectories can be saved into a file and the candidate can be compared
+* against that file instead. If this build does not compile fast math kernels, the
+* candidate uses standard library math, so the file compares two builds, e.g. with
+* different compiler flags.
+*
+* Usage : dynag_accuracy [--yaml PATH] [--steps N] [--tolerance VALUE]
+*                        [--save FILE] [--reference FILE]
+*
+* `DYNAG_RESOURCE_DIR` should be set as in Python side to load terrain maps.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+*/
+
+#include "dyn_api.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+
+struct Scenario
+{
+	std::string sName;
+	// Trim condition of scenario as yaml node, variable and value.
+	std::vector<std::tuple<std::string, std::string, float>> vTrimCondition;
+	// Standard deviation of random walk of actions at each step. Zero holds trim actions.
+	float fActionWalk;
+};
+
+struct AccuracyOptions
+{
+	std::string sYamlPath = "../helis/aw109.yaml";
+	std::string sSavePath = "";
+	std::string sReferencePath = "";
+	int iSteps = 1000;
+	float fTolerance = 1e-3f;
+};
+
+struct ScenarioResult
+{
+	float fMaxError = 0.0f;
+	int iWorstStep = -1, iWorstState = -1, iFirstFailedStep = -1;
+};
+
+// Flying scenario with one instance and writing normalized states of each step into `vTrajectory`.
+static void fly(const Scenario& scenario, const AccuracyOptions& options, bool bFastMath, std::vector<float>& vTrajectory,
+	std::vector<std::string>& vStateNames)
+{
+	float fDt = 0.01f;
+	HelicopterDynamics* HD = createHelicopterDynamics((char*)options.sYamlPath.c_str(), &fDt);
+	for (const auto& condition : scenario.vTrimCondition)
+		HD->setValueInYamlNode(std::get<0>(condition), std::get<1>(condition), std::get<2>(condition));
+	HD->bFastMath = bFastMath;
+	HD->setSeed(1);
+	HD->reset();
+
+	const int iStateSize = (int)HD->vsState.vValues.size();
+	vStateNames.resize(iStateSize);
+	for (int i = 0; i < iStateSize; i++) vStateNames[i] = HD->vsState.getVectorName(i);
+
+	std::vector<float> fActions(HD->vsAction.vValues.data(), HD->vsAction.vValues.data() + HD->vsAction.vValues.size());
+	std::mt19937 mGenerator(1);
+	std::normal_distribution<float> ndWalk(0.0f, 1.0f);
+
+	vTrajectory.resize((size_t)options.iSteps * iStateSize);
+	for (int s = 0; s < options.iSteps; s++)
+	{
+		for (float& fAction : fActions) fAction = std::min(1.0f, std::max(-1.0f, fAction + scenario.fActionWalk * ndWalk(mGenerator)));
+		step(HD, fActions.data());
+		for (int i = 0; i < iStateSize; i++) vTrajectory[(size_t)s * iStateSize + i] = HD->vsState.getNormalizedValue(i);
+	}
+	destroyDynamicSystem(HD);
+}
+
+// Comparing candidate trajectory against reference trajectory.
+static ScenarioResult compare(const std::vector<float>& vReference, const std::vector<float>& vCandidate, int iStateSize, float fTolerance)
+{
+	ScenarioResult result;
+	for (size_t k = 0; k < vReference.size(); k++)
+	{
+		// NaN is counted as infinite error.
+		float fError = std::fabs(vCandidate[k] - vReference[k]);
+		if (!(fError == fError)) fError = INFINITY;
+		if (fError > fTolerance && result.iFirstFailedStep < 0) result.iFirstFailedStep = (int)(k / iStateSize);
+		if (fError > result.fMaxError)
+		{
+			result.fMaxError = fError;
+			result.iWorstStep = (int)(k / iStateSize);
+			result.iWorstState = (int)(k % iStateSize);
+		}
+	}
+	return result;
+}
+
+static void parseArguments(int argc, char** argv, AccuracyOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string sArg = argv[i];
+		bool bHasValue = i + 1 < argc;
+		if (sArg == "--yaml" && bHasValue) options.sYamlPath = argv[++i];
+		else if (sArg == "--save" && bHasValue) options.sSavePath = argv[++i];
+		else if (sArg == "--reference" && bHasValue) options.sReferencePath = argv[++i];
+		else if (sArg == "--steps" && bHasValue) options.iSteps = std::max(1, std::atoi(argv[++i]));
+		else if (sArg == "--tolerance" && bHasValue) options.fTolerance = (float)std::atof(argv[++i]);
+		else
+		{
+			std::cerr << "Usage : dynag_accuracy [--yaml PATH] [--steps N] [--tolerance VALUE] [--save FILE] [--reference FILE]" << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	AccuracyOptions options;
+	parseArguments(argc, argv, options);
+
+	if (!std::getenv("DYNAG_RESOURCE_DIR"))
+	{
+		std::cerr << "DYNAG_RESOURCE_DIR should be set to load terrain maps!" << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+	if (!DYNAG_FAST_MATH)
+		std::cout << "Fast math kernels are not compiled, candidate uses standard library math." << std::endl;
+
+	const std::vector<Scenario> vScenarios = {
+		{ "hover", {}, 0.0f },
+		{ "forward_flight", { std::make_tuple("TRIM", "N_VEL", 100.0f) }, 0.0f },
+		{ "climb", { std::make_tuple("TRIM", "N_VEL", 60.0f), std::make_tuple("TRIM", "D_VEL", -10.0f) }, 0.0f },
+		{ "hover_maneuver", {}, 0.002f },
+	};
+
+	std::ofstream fileSave;
+	std::ifstream fileReference;
+	if (!options.sSavePath.empty()) fileSave.open(options.sSavePath, std::ios::binary);
+	if (!options.sReferencePath.empty()) fileReference.open(options.sReferencePath, std::ios::binary);
+	if ((!options.sSavePath.empty() && !fileSave) || (!options.sReferencePath.empty() && !fileReference))
+	{
+		std::cerr << "Trajectory file cannot be opened!" << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	// File starts with step count, so trajectories of different lengths are not compared.
+	if (!options.sSavePath.empty()) fileSave.write(reinterpret_cast<const char*>(&options.iSteps), sizeof(int));
+	if (!options.sReferencePath.empty())
+	{
+		int iFileSteps = 0;
+		fileReference.read(reinterpret_cast<char*>(&iFileSteps), sizeof(int));
+		if (!fileReference || iFileSteps != options.iSteps)
+		{
+			std::cerr << "Reference file has " << iFileSteps << " steps, but " << options.iSteps << " steps are flown!" << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+	}
+
+	bool bPassed = true;
+	std::printf("%-16s %12s %8s %-10s %s\n", "scenario", "max_error", "step", "state", "result");
+	for (const Scenario& scenario : vScenarios)
+	{
+		std::vector<float> vReference, vCandidate;
+		std::vector<std::string> vStateNames;
+		fly(scenario, options, true, vCandidate, vStateNames);
+		const int iStateSize = (int)vStateNames.size();
+
+		if (!options.sSavePath.empty())
+		{
+			fly(scenario, options, false, vReference, vStateNames);
+			fileSave.write(reinterpret_cast<const char*>(vReference.data()), vReference.size() * sizeof(float));
+		}
+		else if (!options.sReferencePath.empty())
+		{
+			vReference.resize(vCandidate.size());
+			fileReference.read(reinterpret_cast<char*>(vReference.data()), vReference.size() * sizeof(float));
+			if (!fileReference)
+			{
+				std::cerr << "Reference file does not match states of scenarios!" << std::endl;
+				std::exit(EXIT_FAILURE);
+			}
+		}
+		else
+		{
+			fly(scenario, options, false, vReference, vStateNames);
+		}
+
+		ScenarioResult result = compare(vReference, vCandidate, iStateSize, options.fTolerance);
+		bool bScenarioPassed = result.iFirstFailedStep < 0;
+		bPassed = bPassed && bScenarioPassed;
+		std::printf("%-16s %12.3e %8d %-10s %s", scenario.sName.c_str(), result.fMaxError, result.iWorstStep,
+			result.iWorstState >= 0 ? vStateNames[result.iWorstState].c_str() : "-", bScenarioPassed ? "PASS" : "FAIL");
+		if (!bScenarioPassed) std::printf(" (first exceeded at step %d)", result.iFirstFailedStep);
+		std::printf("\n");
+	}
+
+	return bPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
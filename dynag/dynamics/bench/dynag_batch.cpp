@@ -0,0 +1,329 @@
+/*
+* DynaG Dynamics C++ / Batch
+*
+* Correctness harness of batched reset and stepping paths. Each check compares a
+* path with its plain equivalent and the harness fails if any check fails.
+*
+*   pooled_reset : Episodes which are reset from a reset pool with background workers
+*                  are flown bit-identical to episodes which are reset in calling thread
+*                  with the same sampled parameters and seeds.
+*   auto_reset   : `stepBatchAutoReset` resets failed and terminated systems from pool,
+*                  marks them done and returns their last observations. Terminated
+*                  systems are not stepped and other systems are stepped as usual.
+*   async_batch  : Systems which are sent to and received from an async batch in
+*                  finishing order are flown bit-identical to systems which are stepped
+*                  one by one with the same actions.
+*   attitude_batch : Euler angles and DCMs of `getAttitudeBatch`, which uses batched
+*                  kinematics kernels, match the kernels of single quaternions.
+*
+* Mean times of pooled and synchronous resets are reported too.
+*
+* Usage : dynag_batch [--yaml PATH] [--episodes N] [--steps N]
+*
+* `DYNAG_RESOURCE_DIR` should be set as in Python side to load terrain maps.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Adding async batch check. // @MGokcayK
+* Update : 19/10/2026 - Adding batched attitude check. // @MGokcayK
+*/
+
+#include "dyn_api.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+struct BatchOptions
+{
+	std::string sYamlPath = "../helis/aw109.yaml";
+	int iEpisodes = 5;
+	int iSteps = 200;
+};
+
+// Randomized parameters of pools as yaml node, variable, distribution, a and b.
+static const std::vector<std::tuple<std::string, std::string, int, float, float>> vRandomization = {
+	std::make_tuple("HELI", "WT", (int)ResetPool::DISTRIBUTION_UNIFORM, 3500.0f, 5401.0f),
+	std::make_tuple("HELI", "FS_CG", (int)ResetPool::DISTRIBUTION_UNIFORM, 128.7f, 136.7f),
+	std::make_tuple("TRIM", "GR_ALT", (int)ResetPool::DISTRIBUTION_UNIFORM, 100.0f, 4000.0f),
+	std::make_tuple("TRIM", "N_POS", (int)ResetPool::DISTRIBUTION_NORMAL, 0.0f, 200.0f),
+};
+
+static ResetPool* createPool(HelicopterDynamics* HD, int iCapacity, int iWorkers, unsigned int iSeed)
+{
+	std::vector<ResetPool::RandomParameter> vParameters;
+	for (const auto& parameter : vRandomization)
+		vParameters.push_back({ HD->getParameterId(std::get<0>(parameter), std::get<1>(parameter)), std::get<2>(parameter),
+			std::get<3>(parameter), std::get<4>(parameter), -1e9f, 1e9f });
+	return new ResetPool(HD, vParameters, iCapacity, iWorkers, iSeed);
+}
+
+static bool report(const std::string& sName, bool bPassed, const std::string& sDetail)
+{
+	std::printf("%-24s %-48s %s\n", sName.c_str(), sDetail.c_str(), bPassed ? "PASS" : "FAIL");
+	return bPassed;
+}
+
+// Pooled resets against resets in calling thread. A pool without workers resets every
+// time in calling thread, and it samples the same sequence as a pool with workers.
+static bool checkPooledReset(HelicopterDynamics* HD, const BatchOptions& options)
+{
+	ResetPool* pooled = createPool(HD, 4, 1, 7);
+	ResetPool* synchronous = createPool(HD, 4, 0, 7);
+	DynamicSystem* A = HD->clone();
+	DynamicSystem* B = HD->clone();
+	std::vector<float> vActions(HD->vsAction.vValues.size(), 0.0f);
+	vActions[0] = 0.1f;
+
+	int iMismatches = 0;
+	double fPooledTime = 0.0, fSynchronousTime = 0.0;
+	for (int e = 0; e < options.iEpisodes; e++)
+	{
+		while (pooled->getSize() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		auto tpStart = std::chrono::steady_clock::now();
+		pooled->reset(A);
+		auto tpMiddle = std::chrono::steady_clock::now();
+		synchronous->reset(B);
+		auto tpEnd = std::chrono::steady_clock::now();
+		fPooledTime += std::chrono::duration<double, std::micro>(tpMiddle - tpStart).count();
+		fSynchronousTime += std::chrono::duration<double, std::micro>(tpEnd - tpMiddle).count();
+
+		for (int s = 0; s < options.iSteps; s++)
+		{
+			A->vsAction.setValues(vActions.data()); A->step();
+			B->vsAction.setValues(vActions.data()); B->step();
+		}
+		for (int i = 0; i < (int)A->vsState.vValues.size(); i++)
+			iMismatches += A->vsState.vValues[i] != B->vsState.vValues[i];
+	}
+
+	char sDetail[128];
+	std::snprintf(sDetail, sizeof(sDetail), "mismatches %d, reset %.1f us vs %.1f us", iMismatches,
+		fPooledTime / options.iEpisodes, fSynchronousTime / options.iEpisodes);
+	bool bPassed = report("pooled_reset", iMismatches == 0 && pooled->getMisses() == 0, sDetail);
+
+	delete A; delete B;
+	delete pooled; delete synchronous;
+	return bPassed;
+}
+
+// Auto-reset of failed and terminated systems. System 0 is forced to fail with huge
+// actions and system 1 is terminated at the first step.
+static bool checkAutoReset(HelicopterDynamics* HD, const BatchOptions& options)
+{
+	const int N = 4;
+	const int iActionSize = (int)HD->vsAction.vValues.size();
+	const int iObservationSize = (int)HD->vsObservation.vValues.size();
+	ResetPool* pool = createPool(HD, 8, 2, 1);
+
+	DynamicSystem* batch[N];
+	for (int k = 0; k < N; k++)
+	{
+		batch[k] = HD->clone();
+		pool->reset(batch[k]);
+	}
+	std::vector<float> vActions(N * iActionSize, 0.0f);
+	for (int j = 0; j < iActionSize; j++) vActions[j] = 1e4f;
+	std::vector<int> vTerminated(N, 0), vDones(N, 0);
+	std::vector<float> vFinalObservations(N * iObservationSize, 0.0f), vLastObservations(N * iObservationSize, 0.0f);
+
+	int iFailed = 0, iWrong = 0;
+	for (int s = 0; s < options.iSteps; s++)
+	{
+		for (int k = 0; k < N; k++)
+			std::memcpy(vLastObservations.data() + k * iObservationSize, batch[k]->vsObservation.vNormalizedValues.data(), iObservationSize * sizeof(float));
+		vTerminated[1] = (s == 0) ? 1 : 0;
+		std::vector<float> vState1(batch[1]->vsState.vValues.data(), batch[1]->vsState.vValues.data() + batch[1]->vsState.vValues.size());
+
+		stepBatchAutoReset(pool, batch, N, vActions.data(), vTerminated.data(), vDones.data(), vFinalObservations.data());
+
+		for (int k = 0; k < N; k++)
+		{
+			if (!vDones[k]) continue;
+			// Reset system is flyable and its final observation is its last observation.
+			iWrong += batch[k]->iStatus != STATUS_OK;
+			iWrong += std::memcmp(vFinalObservations.data() + k * iObservationSize, vLastObservations.data() + k * iObservationSize,
+				iObservationSize * sizeof(float)) != 0;
+		}
+		iFailed += vDones[0];
+		iWrong += vDones[1] != vTerminated[1];
+		iWrong += vDones[2] + vDones[3];
+		// Terminated system is reset, not stepped, so its state is a new initial state.
+		if (vTerminated[1])
+			iWrong += std::equal(vState1.begin(), vState1.end(), batch[1]->vsState.vValues.data());
+	}
+
+	char sDetail[128];
+	std::snprintf(sDetail, sizeof(sDetail), "failed %d of %d steps, wrong %d", iFailed, options.iSteps, iWrong);
+	bool bPassed = report("auto_reset", iFailed > 0 && iWrong == 0, sDetail);
+
+	for (int k = 0; k < N; k++) delete batch[k];
+	delete pool;
+	return bPassed;
+}
+
+// Action of system `k` at step `s`, so each system flies its own actions.
+static void getAction(int k, int s, std::vector<float>& vActions, int iOffset, int iActionSize)
+{
+	for (int j = 0; j < iActionSize; j++) vActions[iOffset + j] = 0.05f * std::sin(0.37f * s + 1.3f * k + j);
+}
+
+// Async batch against stepping one by one. Systems are received in small groups and sent
+// again as soon as they are received, so they finish in a different order at each step.
+static bool checkAsyncBatch(HelicopterDynamics* HD, const BatchOptions& options)
+{
+	const int N = 16;
+	const int iActionSize = (int)HD->vsAction.vValues.size();
+	const int iObservationSize = (int)HD->vsObservation.vValues.size();
+	DynamicSystem* vReference[N];
+	DynamicSystem* vAsync[N];
+	for (int k = 0; k < N; k++)
+	{
+		vReference[k] = HD->clone();
+		vAsync[k] = HD->clone();
+		vReference[k]->setSeed(k); vReference[k]->reset();
+		vAsync[k]->setSeed(k); vAsync[k]->reset();
+	}
+
+	std::vector<float> vActions(N * iActionSize);
+	for (int s = 0; s < options.iSteps; s++)
+	{
+		for (int k = 0; k < N; k++)
+		{
+			getAction(k, s, vActions, 0, iActionSize);
+			vReference[k]->vsAction.setValues(vActions.data());
+			vReference[k]->step();
+		}
+	}
+
+	AsyncBatch* batch = new AsyncBatch(std::vector<DynamicSystem*>(vAsync, vAsync + N), 4, nullptr);
+	std::vector<int> vSteps(N, 0), vIds(N), vDones(N), vSendIds;
+	std::vector<float> vObservations(N * iObservationSize);
+	for (int k = 0; k < N; k++)
+	{
+		vIds[k] = k;
+		getAction(k, 0, vActions, k * iActionSize, iActionSize);
+	}
+	batch->send(vIds.data(), vActions.data(), N);
+
+	int iWrong = 0;
+	while (batch->getInFlight() > 0)
+	{
+		const int n = batch->recv(std::min(4, batch->getInFlight()), 8, vIds.data(), vObservations.data(), vDones.data(), nullptr);
+		vSendIds.clear();
+		for (int i = 0; i < n; i++)
+		{
+			const int k = vIds[i];
+			iWrong += std::memcmp(vObservations.data() + i * iObservationSize, vAsync[k]->vsObservation.vNormalizedValues.data(),
+				iObservationSize * sizeof(float)) != 0;
+			if (++vSteps[k] == options.iSteps) continue;
+			getAction(k, vSteps[k], vActions, (int)vSendIds.size() * iActionSize, iActionSize);
+			vSendIds.push_back(k);
+		}
+		if (!vSendIds.empty()) batch->send(vSendIds.data(), vActions.data(), (int)vSendIds.size());
+	}
+	delete batch;
+
+	int iMismatches = 0;
+	for (int k = 0; k < N; k++)
+		for (int i = 0; i < (int)vReference[k]->vsState.vValues.size(); i++)
+			iMismatches += vReference[k]->vsState.vValues[i] != vAsync[k]->vsState.vValues[i];
+
+	char sDetail[128];
+	std::snprintf(sDetail, sizeof(sDetail), "mismatches %d, wrong observations %d", iMismatches, iWrong);
+	bool bPassed = report("async_batch", iMismatches == 0 && iWrong == 0, sDetail);
+
+	for (int k = 0; k < N; k++)
+	{
+		delete vReference[k];
+		delete vAsync[k];
+	}
+	return bPassed;
+}
+
+// Batched attitude against kernels of single quaternions of systems which fly different actions.
+static bool checkAttitudeBatch(HelicopterDynamics* HD, const BatchOptions& options)
+{
+	const int N = 16;
+	const int iActionSize = (int)HD->vsAction.vValues.size();
+	DynamicSystem* batch[N];
+	std::vector<float> vActions(iActionSize);
+	for (int k = 0; k < N; k++)
+	{
+		batch[k] = HD->clone();
+		batch[k]->setSeed(k); batch[k]->reset();
+		for (int s = 0; s < options.iSteps; s++)
+		{
+			getAction(k, s, vActions, 0, iActionSize);
+			batch[k]->vsAction.setValues(vActions.data());
+			batch[k]->step();
+		}
+	}
+
+	std::vector<float> vEuler(3 * N), vDCM(9 * N);
+	getAttitudeBatch(batch, N, vEuler.data(), vDCM.data());
+
+	const Eigen::Index iQuat = HD->vsState.mapInfo.at("quat").index;
+	float fMaxError = 0.0f;
+	for (int k = 0; k < N; k++)
+	{
+		const Eigen::Vector<float, 4> vQuat = batch[k]->vsState.vValues.segment<4>(iQuat);
+		Eigen::Vector<float, 3> vEulerAngles;
+		Eigen::Matrix<float, 3, 3, Eigen::RowMajor> mDCM;
+		unitQuaternion2Euler(vEulerAngles, vQuat.normalized());
+		quaternion2DCM(mDCM, vQuat);
+		for (int c = 0; c < 3; c++) fMaxError = std::max(fMaxError, std::abs(vEuler[c * N + k] - vEulerAngles(c)));
+		for (int c = 0; c < 9; c++) fMaxError = std::max(fMaxError, std::abs(vDCM[c * N + k] - mDCM(c / 3, c % 3)));
+	}
+
+	char sDetail[128];
+	std::snprintf(sDetail, sizeof(sDetail), "max error %.3g", fMaxError);
+	bool bPassed = report("attitude_batch", fMaxError <= 1e-5f, sDetail);
+
+	for (int k = 0; k < N; k++) delete batch[k];
+	return bPassed;
+}
+
+static void parseArguments(int argc, char** argv, BatchOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string sArg = argv[i];
+		bool bHasValue = i + 1 < argc;
+		if (sArg == "--yaml" && bHasValue) options.sYamlPath = argv[++i];
+		else if (sArg == "--episodes" && bHasValue) options.iEpisodes = std::max(1, std::atoi(argv[++i]));
+		else if (sArg == "--steps" && bHasValue) options.iSteps = std::max(1, std::atoi(argv[++i]));
+		else
+		{
+			std::cerr << "Usage : dynag_batch [--yaml PATH] [--episodes N] [--steps N]" << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BatchOptions options;
+	parseArguments(argc, argv, options);
+
+	if (!std::getenv("DYNAG_RESOURCE_DIR"))
+	{
+		std::cerr << "DYNAG_RESOURCE_DIR should be set to load terrain maps!" << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	float fDt = 0.01f;
+	HelicopterDynamics* HD = createHelicopterDynamics((char*)options.sYamlPath.c_str(), &fDt);
+	HD->reset();
+
+	bool bPassed = true;
+	bPassed &= checkPooledReset(HD, options);
+	bPassed &= checkAutoReset(HD, options);
+	bPassed &= checkAsyncBatch(HD, options);
+	bPassed &= checkAttitudeBatch(HD, options);
+
+	delete HD;
+	return bPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
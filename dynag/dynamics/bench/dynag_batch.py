@@ -0,0 +1,67 @@
+#
+# DynaG Dynamics Python / Batch
+#
+# Smoke check of Python batch wrappers. It constructs an `AsyncBatch` of helicopters,
+# sends actions of all of them once and receives them, then compares received
+# observations with helicopters which are stepped one by one with the same actions.
+# `dynag_batch` checks C++ side of batches in detail.
+#
+# Usage : python3 dynag_batch.py [--heli NAME] [--envs N] [--workers N]
+#
+# `DYNAG_RESOURCE_DIR` should be set as in Python side to load terrain maps.
+#
+# Author : @MGokcayK
+# C.Date : 19/10/2026
+# Update : 19/10/2026 - Initialization & Implementation // @MGokcayK
+#
+
+import os
+import sys
+import argparse
+import numpy as np
+
+# Dynamics package is imported without `dynag` package, which needs gym.
+sys.path.insert(0, os.path.abspath(os.path.join(os.path.dirname(__file__), os.pardir, os.pardir)))
+
+from dynamics import dynamicsAPI
+from dynamics.dynamics_impl import Helicopter, AsyncBatch
+
+def report(name, passed, detail):
+    print("%-24s %-48s %s" % (name, detail, "PASS" if passed else "FAIL"))
+    return passed
+
+def checkAsyncBatch(heli_name, n_envs, workers):
+    # Forks have the same state and random generators, so batch and references fly alike.
+    base = Helicopter(heli_name, 0.01)
+    helicopters, references = base.fork(n_envs), base.fork(n_envs)
+    n_act = len(dynamicsAPI.getAllAction(helicopters[0].heliDyn))
+    actions = np.stack([0.05 * np.sin(1.3 * k + np.arange(n_act)) for k in range(n_envs)]).astype(np.float32)
+
+    batch = AsyncBatch(helicopters, workers)
+    batch.send(np.arange(n_envs), actions)
+    env_ids, observations, dones, _ = batch.recv(min_count=n_envs)
+    in_flight = batch.in_flight
+    batch.close()
+
+    mismatches = 0
+    for row, k in enumerate(env_ids):
+        dynamicsAPI.step(references[k].heliDyn, actions[k])
+        expected = dynamicsAPI.getAllNormalizedObservation(references[k].heliDyn)
+        mismatches += int(np.count_nonzero(observations[row] != expected))
+
+    for heli in helicopters + references + [base]:
+        heli.close()
+
+    passed = len(env_ids) == n_envs and sorted(env_ids.tolist()) == list(range(n_envs)) and \
+        in_flight == 0 and not dones.any() and mismatches == 0
+    return report("py_async_batch", passed, "received %d of %d, mismatches %d" % (len(env_ids), n_envs, mismatches))
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--heli", default="aw109")
+    parser.add_argument("--envs", type=int, default=4)
+    parser.add_argument("--workers", type=int, default=2)
+    args = parser.parse_args()
+
+    passed = checkAsyncBatch(args.heli, args.envs, args.workers)
+    sys.exit(0 if passed else 1)
@@ -0,0 +1,418 @@
+/*
+* DynaG Dynamics C++ / Benchmark
+*
+* Benchmark suite for hot paths of dynamics library. Each benchmark is run until
+* its minimum time is reached, then it is repeated and per-operation times are
+* reported. Results are written as Google Benchmark compatible JSON, so they can be
+* compared between commits with its `compare.py` tool.
+*
+* Usage : dynag_bench [--yaml PATH] [--filter TEXT] [--min-time SECONDS]
+*                     [--repetitions N] [--out FILE]
+*
+* `DYNAG_RESOURCE_DIR` should be set as in Python side to load terrain maps.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Adding fast math step benchmark. // @MGokcayK
+* Update : 19/10/2026 - Adding double precision step benchmark. // @MGokcayK
+* Update : 19/10/2026 - Adding multi-rate step benchmark. // @MGokcayK
+* Update : 19/10/2026 - Adding masked observation step benchmark. // @MGokcayK
+*/
+
+#include "dyn_api.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+// Sink of benchmark results to keep compiler from removing measured code.
+static volatile float fSink = 0.0f;
+
+struct Benchmark
+{
+	std::string sName;
+	// Running the benchmark `iIterations` times.
+	std::function<void(long long iIterations)> fRun;
+};
+
+struct BenchmarkResult
+{
+	std::string sName;
+	long long iIterations;
+	std::vector<double> vRealTimes, vCpuTimes; // [ns] per operation of each repetition
+};
+
+struct BenchmarkOptions
+{
+	std::string sYamlPath = "../helis/aw109.yaml";
+	std::string sFilter = "";
+	std::string sOutPath = "";
+	double fMinTime = 0.5; // [s]
+	int iRepetitions = 5;
+};
+
+// Measuring wall and process cpu time of `iIterations` runs in seconds.
+static void measure(const Benchmark& bench, long long iIterations, double& fRealTime, double& fCpuTime)
+{
+	std::clock_t cpuStart = std::clock();
+	auto tpStart = std::chrono::steady_clock::now();
+	bench.fRun(iIterations);
+	auto tpEnd = std::chrono::steady_clock::now();
+	std::clock_t cpuEnd = std::clock();
+
+	fRealTime = std::chrono::duration<double>(tpEnd - tpStart).count();
+	fCpuTime = (double)(cpuEnd - cpuStart) / CLOCKS_PER_SEC;
+}
+
+// Running benchmark w.r.t options. Iteration count is grown until minimum time is reached.
+static BenchmarkResult run(const Benchmark& bench, const BenchmarkOptions& options)
+{
+	BenchmarkResult result;
+	result.sName = bench.sName;
+
+	long long iIterations = 1;
+	double fRealTime = 0.0, fCpuTime = 0.0;
+	while (true)
+	{
+		measure(bench, iIterations, fRealTime, fCpuTime);
+		if (fRealTime >= options.fMinTime || iIterations >= 1000000000LL) break;
+
+		double fScale = (fRealTime > 0.0) ? 1.4 * options.fMinTime / fRealTime : 10.0;
+		fScale = std::min(std::max(fScale, 2.0), 10.0);
+		iIterations = (long long)(iIterations * fScale);
+	}
+	result.iIterations = iIterations;
+
+	for (int r = 0; r < options.iRepetitions; r++)
+	{
+		measure(bench, iIterations, fRealTime, fCpuTime);
+		result.vRealTimes.push_back(fRealTime * 1e9 / iIterations);
+		result.vCpuTimes.push_back(fCpuTime * 1e9 / iIterations);
+	}
+	return result;
+}
+
+static double mean(const std::vector<double>& v)
+{
+	double fSum = 0.0;
+	for (double f : v) fSum += f;
+	return fSum / v.size();
+}
+
+static double median(std::vector<double> v)
+{
+	std::sort(v.begin(), v.end());
+	size_t n = v.size();
+	return (n % 2) ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+static double stddev(const std::vector<double>& v)
+{
+	if (v.size() < 2) return 0.0;
+	double fMean = mean(v), fSum = 0.0;
+	for (double f : v) fSum += (f - fMean) * (f - fMean);
+	return std::sqrt(fSum / (v.size() - 1));
+}
+
+// Writing one entry of `benchmarks` array in Google Benchmark JSON format.
+static void writeEntry(std::ostream& os, const BenchmarkResult& result, const std::string& sSuffix, int iRepetitionIndex,
+	long long iIterations, double fRealTime, double fCpuTime, bool bAggregate, bool bLast)
+{
+	os << "    {\n";
+	os << "      \"name\": \"" << result.sName << sSuffix << "\",\n";
+	os << "      \"run_name\": \"" << result.sName << "\",\n";
+	os << "      \"run_type\": \"" << (bAggregate ? "aggregate" : "iteration") << "\",\n";
+	if (bAggregate) os << "      \"aggregate_name\": \"" << sSuffix.substr(1) << "\",\n";
+	else os << "      \"repetition_index\": " << iRepetitionIndex << ",\n";
+	os << "      \"repetitions\": " << result.vRealTimes.size() << ",\n";
+	os << "      \"threads\": 1,\n";
+	os << "      \"iterations\": " << iIterations << ",\n";
+	os << "      \"real_time\": " << fRealTime << ",\n";
+	os << "      \"cpu_time\": " << fCpuTime << ",\n";
+	os << "      \"time_unit\": \"ns\"\n";
+	os << "    }" << (bLast ? "" : ",") << "\n";
+}
+
+static void writeJson(std::ostream& os, const std::vector<BenchmarkResult>& vResults, const BenchmarkOptions& options)
+{
+	char cDate[64];
+	std::time_t tNow = std::time(nullptr);
+	std::strftime(cDate, sizeof(cDate), "%Y-%m-%dT%H:%M:%S", std::localtime(&tNow));
+
+	os << "{\n";
+	os << "  \"context\": {\n";
+	os << "    \"date\": \"" << cDate << "\",\n";
+	os << "    \"executable\": \"dynag_bench\",\n";
+	os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#if defined(__clang__)
+	os << "    \"compiler\": \"clang " << __clang_major__ << "." << __clang_minor__ << "\",\n";
+#elif defined(__GNUC__)
+	os << "    \"compiler\": \"gcc " << __GNUC__ << "." << __GNUC_MINOR__ << "\",\n";
+#elif defined(_MSC_VER)
+	os << "    \"compiler\": \"msvc " << _MSC_VER << "\",\n";
+#endif
+#ifdef NDEBUG
+	os << "    \"library_build_type\": \"release\",\n";
+#else
+	os << "    \"library_build_type\": \"debug\",\n";
+#endif
+	os << "    \"yaml_path\": \"" << options.sYamlPath << "\",\n";
+	os << "    \"min_time\": " << options.fMinTime << "\n";
+	os << "  },\n";
+	os << "  \"benchmarks\": [\n";
+	for (size_t b = 0; b < vResults.size(); b++)
+	{
+		const BenchmarkResult& result = vResults[b];
+		for (size_t r = 0; r < result.vRealTimes.size(); r++)
+			writeEntry(os, result, "", (int)r, result.iIterations, result.vRealTimes[r], result.vCpuTimes[r], false, false);
+		writeEntry(os, result, "_mean", 0, result.iIterations, mean(result.vRealTimes), mean(result.vCpuTimes), true, false);
+		writeEntry(os, result, "_median", 0, result.iIterations, median(result.vRealTimes), median(result.vCpuTimes), true, false);
+		writeEntry(os, result, "_stddev", 0, result.iIterations, stddev(result.vRealTimes), stddev(result.vCpuTimes), true,
+			b == vResults.size() - 1);
+	}
+	os << "  ]\n";
+	os << "}\n";
+}
+
+static void parseArguments(int argc, char** argv, BenchmarkOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string sArg = argv[i];
+		bool bHasValue = i + 1 < argc;
+		if (sArg == "--yaml" && bHasValue) options.sYamlPath = argv[++i];
+		else if (sArg == "--filter" && bHasValue) options.sFilter = argv[++i];
+		else if (sArg == "--out" && bHasValue) options.sOutPath = argv[++i];
+		else if (sArg == "--min-time" && bHasValue) options.fMinTime = std::atof(argv[++i]);
+		else if (sArg == "--repetitions" && bHasValue) options.iRepetitions = std::max(1, std::atoi(argv[++i]));
+		else
+		{
+			std::cerr << "Usage : dynag_bench [--yaml PATH] [--filter TEXT] [--min-time SECONDS] [--repetitions N] [--out FILE]" << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkOptions options;
+	parseArguments(argc, argv, options);
+
+	if (!std::getenv("DYNAG_RESOURCE_DIR"))
+	{
+		std::cerr << "DYNAG_RESOURCE_DIR should be set to load terrain maps!" << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	float fDt = 0.01f;
+	HelicopterDynamics* HD = createHelicopterDynamics((char*)options.sYamlPath.c_str(), &fDt);
+	HD->setSeed(1);
+
+	// Snapshots of untrimmed and trimmed states. Stepping benchmarks load trimmed
+	// snapshot periodically, so they do not measure diverged or crashed helicopter.
+	std::vector<char> cUntrimmed(HD->getStateSize()), cTrimmed(HD->getStateSize());
+	HD->bTrimOnReset = false;
+	HD->reset();
+	HD->saveState(cUntrimmed.data());
+	HD->bTrimOnReset = true;
+	HD->reset();
+	HD->saveState(cTrimmed.data());
+	const int iRestorePeriod = 256;
+
+	// Double precision instance with the same parameters and trimmed snapshot.
+	double fDoubleDt = fDt;
+	HelicopterDynamicsT<double>* HDD = new HelicopterDynamicsT<double>(HD->shareParams(), &fDoubleDt);
+	HDD->setSeed(1);
+	HDD->reset();
+	std::vector<char> cDoubleTrimmed(HDD->getStateSize());
+	HDD->saveState(cDoubleTrimmed.data());
+
+	std::vector<float> fTrimAction(HD->vsAction.vValues.data(), HD->vsAction.vValues.data() + HD->vsAction.vValues.size());
+	std::vector<float> fObservations(HD->getNumberOfObservations());
+
+	std::shared_ptr<const HelicopterParams> spParams = HD->getParams();
+	std::mt19937 mGenerator(1);
+
+	// Random ground locations in terrain bounds.
+	const int iLocationCount = 1024;
+	std::vector<Eigen::Vector<float, 3>> vLocations(iLocationCount);
+	std::uniform_real_distribution<float> disNS(-spParams->NS_MAX, spParams->NS_MAX), disEW(-spParams->EW_MAX, spParams->EW_MAX);
+	for (auto& vLocation : vLocations) vLocation = { disNS(mGenerator), disEW(mGenerator), 0.0f };
+
+	// Random and slowly changing keys of turbulence lookup table.
+	const int iKeyCount = 1024;
+	std::vector<float> fRandomRows(iKeyCount), fRandomCols(iKeyCount), fSweepCols(iKeyCount);
+	std::uniform_real_distribution<float> disRow(1.0f, 7.0f), disCol(500.0f, 80000.0f);
+	for (int i = 0; i < iKeyCount; i++)
+	{
+		fRandomRows[i] = disRow(mGenerator);
+		fRandomCols[i] = disCol(mGenerator);
+		fSweepCols[i] = 500.0f + 79500.0f * i / iKeyCount;
+	}
+	std::vector<float> fBatchKeys(fRandomRows);
+	fBatchKeys.insert(fBatchKeys.end(), fRandomCols.begin(), fRandomCols.end());
+
+	std::vector<Benchmark> vBenchmarks = {
+		{ "DynamicSystem/step", [&](long long n) {
+			HD->loadState(cTrimmed.data());
+			for (long long i = 0; i < n; i++)
+			{
+				if (i % iRestorePeriod == iRestorePeriod - 1) HD->loadState(cTrimmed.data());
+				HD->step();
+			}
+			fSink = HD->vsState.vValues[0];
+		} },
+		{ "DynamicSystem/step/fast_math", [&](long long n) {
+			HD->bFastMath = true;
+			HD->loadState(cTrimmed.data());
+			for (long long i = 0; i < n; i++)
+			{
+				if (i % iRestorePeriod == iRestorePeriod - 1) HD->loadState(cTrimmed.data());
+				HD->step();
+			}
+			HD->bFastMath = false;
+			fSink = HD->vsState.vValues[0];
+		} },
+		{ "DynamicSystem/step/multi_rate", [&](long long n) {
+			HD->setFastSubsteps(4);
+			HD->loadState(cTrimmed.data());
+			for (long long i = 0; i < n; i++)
+			{
+				if (i % iRestorePeriod == iRestorePeriod - 1) HD->loadState(cTrimmed.data());
+				HD->step();
+			}
+			HD->setFastSubsteps(1);
+			fSink = HD->vsState.vValues[0];
+		} },
+		{ "DynamicSystem/step/masked", [&](long long n) {
+			// Position and velocity are the usual minimal observation of policies.
+			HD->setObservationMask({ "xyz", "uvw" });
+			HD->loadState(cTrimmed.data());
+			for (long long i = 0; i < n; i++)
+			{
+				if (i % iRestorePeriod == iRestorePeriod - 1) HD->loadState(cTrimmed.data());
+				HD->step();
+			}
+			HD->setObservationMask({});
+			fSink = HD->vsState.vValues[0];
+		} },
+		{ "DynamicSystem/step/double", [&](long long n) {
+			HDD->loadState(cDoubleTrimmed.data());
+			for (long long i = 0; i < n; i++)
+			{
+				if (i % iRestorePeriod == iRestorePeriod - 1) HDD->loadState(cDoubleTrimmed.data());
+				HDD->step();
+			}
+			fSink = (float)HDD->vsState.vValues[0];
+		} },
+		{ "HelicopterDynamics/reset/trim", [&](long long n) {
+			for (long long i = 0; i < n; i++) HD->reset();
+			fSink = HD->vsState.vValues[0];
+		} },
+		{ "HelicopterDynamics/reset/no_trim", [&](long long n) {
+			HD->bTrimOnReset = false;
+			for (long long i = 0; i < n; i++) HD->reset();
+			HD->bTrimOnReset = true;
+			fSink = HD->vsState.vValues[0];
+		} },
+		{ "HelicopterDynamics/trim", [&](long long n) {
+			// Loading untrimmed snapshot is included, it is small against trim.
+			for (long long i = 0; i < n; i++)
+			{
+				HD->loadState(cUntrimmed.data());
+				HD->trim();
+			}
+			fSink = HD->vsState.vValues[0];
+		} },
+		{ "HelicopterDynamics/getGroundHeightNormal", [&](long long n) {
+			float fHeight = 0.0f, fSum = 0.0f;
+			Eigen::Vector<float, 3> vNormal;
+			for (long long i = 0; i < n; i++)
+			{
+				HD->getGroundHeightNormal(vLocations[i % iLocationCount], fHeight, vNormal);
+				fSum += fHeight + vNormal[2];
+			}
+			fSink = fSum;
+		} },
+		{ "LookUpTable/get/random", [&](long long n) {
+			const LookUpTable<2>& table = HelicopterParams::getTurbulenceExceedenceProbability();
+			LookUpTable<2>::Hint hint;
+			float fSum = 0.0f;
+			for (long long i = 0; i < n; i++)
+				fSum += table.get({ fRandomRows[i % iKeyCount], fRandomCols[i % iKeyCount] }, hint);
+			fSink = fSum;
+		} },
+		{ "LookUpTable/get/sweep", [&](long long n) {
+			const LookUpTable<2>& table = HelicopterParams::getTurbulenceExceedenceProbability();
+			LookUpTable<2>::Hint hint;
+			float fSum = 0.0f;
+			for (long long i = 0; i < n; i++)
+				fSum += table.get({ 4.0f, fSweepCols[i % iKeyCount] }, hint);
+			fSink = fSum;
+		} },
+		{ "LookUpTable/get/no_hint", [&](long long n) {
+			const LookUpTable<2>& table = HelicopterParams::getTurbulenceExceedenceProbability();
+			float fSum = 0.0f;
+			for (long long i = 0; i < n; i++)
+				fSum += table.get({ fRandomRows[i % iKeyCount], fRandomCols[i % iKeyCount] });
+			fSink = fSum;
+		} },
+		{ "LookUpTable/get/batch", [&](long long n) {
+			// Time per query of batches of `iKeyCount` random queries.
+			const LookUpTable<2>& table = HelicopterParams::getTurbulenceExceedenceProbability();
+			std::vector<float> fValues(iKeyCount);
+			long long i = 0;
+			for (; i + iKeyCount <= n; i += iKeyCount) table.get(fBatchKeys.data(), fValues.data(), iKeyCount);
+			table.get(fBatchKeys.data(), fValues.data(), (int)(n - i));
+			fSink = fValues[0];
+		} },
+		{ "VectorSpace/axpy", [&](long long n) {
+			// Same expression as RK4 stages, `vsState = vsState0 + vsStateDot * dt`.
+			VectorSpace vsX, vsY, vsTarget;
+			vsX.init(HD->vsState);
+			vsY.init(HD->vsStateDot);
+			vsTarget.init(HD->vsState);
+			for (long long i = 0; i < n; i++) vsTarget = vsX + vsY * fDt;
+			fSink = vsTarget.vValues[0];
+		} },
+		{ "C-API/step+getAllObservation", [&](long long n) {
+			int iSize = 0;
+			HD->loadState(cTrimmed.data());
+			for (long long i = 0; i < n; i++)
+			{
+				if (i % iRestorePeriod == iRestorePeriod - 1) HD->loadState(cTrimmed.data());
+				step(HD, fTrimAction.data());
+				float* fObservationPtr = getAllObservation(HD, &iSize);
+				std::copy(fObservationPtr, fObservationPtr + iSize, fObservations.begin());
+			}
+			fSink = fObservations[0];
+		} },
+	};
+
+	std::vector<BenchmarkResult> vResults;
+	for (const Benchmark& bench : vBenchmarks)
+	{
+		if (!options.sFilter.empty() && bench.sName.find(options.sFilter) == std::string::npos) continue;
+
+		BenchmarkResult result = run(bench, options);
+		std::cerr << bench.sName << " : " << median(result.vRealTimes) << " ns (median of " << options.iRepetitions
+			<< " x " << result.iIterations << " iterations)" << std::endl;
+		vResults.push_back(result);
+	}
+
+	if (options.sOutPath.empty()) writeJson(std::cout, vResults, options);
+	else
+	{
+		std::ofstream file(options.sOutPath);
+		writeJson(file, vResults, options);
+	}
+
+	delete HDD;
+	destroyDynamicSystem(HD);
+	return 0;
+}
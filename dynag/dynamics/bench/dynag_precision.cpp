@@ -0,0 +1,184 @@
+/*
+* DynaG Dynamics C++ / Precision
+*
+* Precision report of scalar types of dynamics. Each scenario is flown by float and
+* double instances at several step sizes from the same seed and trim. Normalized states
+* are compared with a double reference which is flown at a small step size, so error of
+* each run is the sum of its truncation error and its rounding error. Difference of
+* float and double runs at the same step size is the rounding error of float alone.
+* Turbulence and random wind direction are disabled, since their random samples depend
+* on step size. Mean step time of each run is reported too.
+*
+* Compared runs can use multi-rate integration with `--substeps`, so larger step sizes
+* with sub-stepped fast states can be compared with the reference which does not.
+*
+* Usage : dynag_precision [--yaml PATH] [--time SECONDS] [--reference-dt VALUE]
+*                         [--substeps N]
+*
+* `DYNAG_RESOURCE_DIR` should be set as in Python side to load terrain maps.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Adding multi-rate integration option. // @MGokcayK
+*/
+
+#include "dyn_api.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+struct Scenario
+{
+	std::string sName;
+	// Trim condition of scenario as yaml node, variable and value.
+	std::vector<std::tuple<std::string, std::string, float>> vTrimCondition;
+};
+
+struct PrecisionOptions
+{
+	std::string sYamlPath = "../helis/aw109.yaml";
+	double fTime = 5.0; // [s]
+	double fReferenceDt = 0.0025; // [s]
+	int iSubsteps = 1; // fast sub-steps of compared runs
+};
+
+// Step sizes which are compared. States are compared at multiples of the largest one.
+static const std::vector<double> vStepSizes = { 0.005, 0.01, 0.02, 0.04 };
+
+struct Flight
+{
+	// Normalized states at each sample time.
+	std::vector<double> vTrajectory;
+	double fStepTime = 0.0; // [ns] mean time of a step
+};
+
+// Flying scenario with instance of scalar type `T` and sampling normalized states at
+// each `fSampleDt` seconds.
+template<typename T>
+static Flight fly(const Scenario& scenario, const PrecisionOptions& options, double fStepDt, double fSampleDt, int iSubsteps,
+	std::vector<std::string>& vStateNames)
+{
+	T fDt = (T)fStepDt;
+	HelicopterDynamicsT<T>* HD = new HelicopterDynamicsT<T>((char*)options.sYamlPath.c_str(), &fDt);
+	HD->setValueInYamlNode("ENV", "TURB_LVL", 0.0f);
+	HD->setValueInYamlNode("ENV", "WIND_DIR_RND", 0.0f);
+	for (const auto& condition : scenario.vTrimCondition)
+		HD->setValueInYamlNode(std::get<0>(condition), std::get<1>(condition), std::get<2>(condition));
+	HD->setSeed(1);
+	HD->reset();
+	HD->setFastSubsteps(iSubsteps);
+
+	const int iStateSize = (int)HD->vsState.vValues.size();
+	vStateNames.resize(iStateSize);
+	for (int i = 0; i < iStateSize; i++) vStateNames[i] = HD->vsState.getVectorName(i);
+
+	const int iSteps = (int)std::lround(options.fTime / fStepDt);
+	const int iSamplePeriod = (int)std::lround(fSampleDt / fStepDt);
+
+	Flight flight;
+	flight.vTrajectory.reserve((size_t)(iSteps / iSamplePeriod) * iStateSize);
+	double fElapsed = 0.0;
+	for (int s = 1; s <= iSteps; s++)
+	{
+		auto tpStart = std::chrono::steady_clock::now();
+		HD->step();
+		fElapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - tpStart).count();
+
+		if (s % iSamplePeriod == 0)
+			for (int i = 0; i < iStateSize; i++) flight.vTrajectory.push_back((double)HD->vsState.getNormalizedValue(i));
+	}
+	flight.fStepTime = fElapsed * 1e9 / iSteps;
+	delete HD;
+	return flight;
+}
+
+// Getting maximum absolute difference of trajectories and its state. NaN is counted as
+// infinite error.
+static double maxError(const std::vector<double>& vReference, const std::vector<double>& vCandidate, int iStateSize, int& iWorstState)
+{
+	double fMaxError = 0.0;
+	iWorstState = -1;
+	for (size_t k = 0; k < vReference.size(); k++)
+	{
+		double fError = std::fabs(vCandidate[k] - vReference[k]);
+		if (!(fError == fError)) fError = INFINITY;
+		if (fError > fMaxError)
+		{
+			fMaxError = fError;
+			iWorstState = (int)(k % iStateSize);
+		}
+	}
+	return fMaxError;
+}
+
+static void parseArguments(int argc, char** argv, PrecisionOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string sArg = argv[i];
+		bool bHasValue = i + 1 < argc;
+		if (sArg == "--yaml" && bHasValue) options.sYamlPath = argv[++i];
+		else if (sArg == "--time" && bHasValue) options.fTime = std::max(vStepSizes.back(), std::atof(argv[++i]));
+		else if (sArg == "--reference-dt" && bHasValue) options.fReferenceDt = std::atof(argv[++i]);
+		else if (sArg == "--substeps" && bHasValue) options.iSubsteps = std::max(1, std::atoi(argv[++i]));
+		else
+		{
+			std::cerr << "Usage : dynag_precision [--yaml PATH] [--time SECONDS] [--reference-dt VALUE] [--substeps N]" << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+	}
+
+	// Reference should sample the same times as the compared step sizes.
+	const double fRatio = vStepSizes.back() / options.fReferenceDt;
+	if (!(options.fReferenceDt > 0.0) || std::fabs(fRatio - std::round(fRatio)) > 1e-9)
+	{
+		std::cerr << "Reference step size should divide " << vStepSizes.back() << " seconds!" << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	PrecisionOptions options;
+	parseArguments(argc, argv, options);
+
+	if (!std::getenv("DYNAG_RESOURCE_DIR"))
+	{
+		std::cerr << "DYNAG_RESOURCE_DIR should be set to load terrain maps!" << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	const std::vector<Scenario> vScenarios = {
+		{ "hover", {} },
+		{ "forward_flight", { std::make_tuple("TRIM", "N_VEL", 100.0f) } },
+		{ "climb", { std::make_tuple("TRIM", "N_VEL", 60.0f), std::make_tuple("TRIM", "D_VEL", -10.0f) } },
+	};
+	const double fSampleDt = vStepSizes.back();
+
+	std::printf("%-16s %8s %14s %14s %14s %-10s %12s %12s\n", "scenario", "dt", "float_error", "double_error",
+		"rounding", "state", "float_ns", "double_ns");
+	for (const Scenario& scenario : vScenarios)
+	{
+		std::vector<std::string> vStateNames;
+		Flight reference = fly<double>(scenario, options, options.fReferenceDt, fSampleDt, 1, vStateNames);
+		const int iStateSize = (int)vStateNames.size();
+
+		for (double fStepDt : vStepSizes)
+		{
+			Flight single = fly<float>(scenario, options, fStepDt, fSampleDt, options.iSubsteps, vStateNames);
+			Flight dual = fly<double>(scenario, options, fStepDt, fSampleDt, options.iSubsteps, vStateNames);
+
+			int iFloatState, iDoubleState, iRoundingState;
+			double fFloatError = maxError(reference.vTrajectory, single.vTrajectory, iStateSize, iFloatState);
+			double fDoubleError = maxError(reference.vTrajectory, dual.vTrajectory, iStateSize, iDoubleState);
+			double fRoundingError = maxError(dual.vTrajectory, single.vTrajectory, iStateSize, iRoundingState);
+			std::printf("%-16s %8.4f %14.3e %14.3e %14.3e %-10s %12.1f %12.1f\n", scenario.sName.c_str(), fStepDt,
+				fFloatError, fDoubleError, fRoundingError, iRoundingState >= 0 ? vStateNames[iRoundingState].c_str() : "-",
+				single.fStepTime, dual.fStepTime);
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -8,6 +8,22 @@
 # Author : @ugurcanozalp (uurcann94@gmail.com)
 # C.Date : 21/09/2021
 # Update : 21/09/2021 - Initialization & Implementation // @MGokcayK
+# Update : 19/10/2026 - Adding state snapshot, fork and seed methods // @MGokcayK
+# Update : 19/10/2026 - Adding cloneHelicopterDynamics method // @MGokcayK
+# Update : 19/10/2026 - Adding destroy and pooled instance methods // @MGokcayK
+# Update : 19/10/2026 - Adding compiled parameter methods // @MGokcayK
+# Update : 19/10/2026 - Adding setParametersBatch method // @MGokcayK
+# Update : 19/10/2026 - Adding getStatus and getStatusMessage methods // @MGokcayK
+# Update : 19/10/2026 - Adding getProfile and resetProfile methods // @MGokcayK
+# Update : 19/10/2026 - Adding setTurbulenceFieldOrigin method // @MGokcayK
+# Update : 19/10/2026 - Adding setFastMath method // @MGokcayK
+# Update : 19/10/2026 - Adding setFastSubsteps method // @MGokcayK
+# Update : 19/10/2026 - Adding setObservationMask method // @MGokcayK
+# Update : 19/10/2026 - Adding observation history methods // @MGokcayK
+# Update : 19/10/2026 - Adding reset pool and auto-reset batch step methods // @MGokcayK
+# Update : 19/10/2026 - Adding asynchronous send and receive step methods // @MGokcayK
+# Update : 19/10/2026 - Taking instance in ready method // @MGokcayK
+# Update : 19/10/2026 - Adding getAttitudeBatch method // @MGokcayK
 #
 # Last update information of API can find from `src/dyn_api.h`
 
@@ -37,17 +53,75 @@ def _to_encode(str_to_encode, encode_type = 'utf-8'):
     return str_to_encode.encode(encode_type)
 
 ###################################################################################
-lib.ready.argtypes = []
+lib.ready.argtypes = [ctypes.c_void_p]
 lib.ready.restype = ctypes.c_bool
 
-def ready():
+def ready(DynamicSystem):
     """
-        Getting if system is ready to simulation.
+        Getting if system is ready to simulation, i.e. its status is OK.
         >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
 
         It returns the status for simulation
     """
-    return lib.ready()
+    return lib.ready(DynamicSystem)
+
+###################################################################################
+lib.getStatus.argtypes = [ctypes.c_void_p, c_int_p]
+lib.getStatus.restype = ctypes.c_int
+
+def getStatus(DynamicSystem):
+    """
+        Getting status of DynamicsSystem which is checked once per step.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+
+        It returns status code and index of diverged state. Codes are 0 for ok, 1 for
+        NaN, 2 for Inf and 3 for limit. Index is -1 if status is ok.
+    """
+    index = ctypes.c_int(-1)
+    status = lib.getStatus(DynamicSystem, ctypes.byref(index))
+    return status, index.value
+
+###################################################################################
+lib.getStatusMessage.argtypes = [ctypes.c_void_p]
+lib.getStatusMessage.restype = ctypes.c_char_p
+
+def getStatusMessage(DynamicSystem):
+    """
+        Getting status message of DynamicsSystem which explains diverged state.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+
+        It returns the message as string.
+    """
+    return lib.getStatusMessage(DynamicSystem).decode('utf-8')
+
+###################################################################################
+lib.getProfile.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_char_p), ctypes.POINTER(ctypes.c_double)]
+lib.getProfile.restype = ctypes.c_int
+
+def getProfile(DynamicSystem):
+    """
+        Getting profiling counters of DynamicsSystem.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+
+        It returns dictionary of accumulated timestamp counter ticks w.r.t section names.
+        It is empty if library is built without `DYNAG_PROFILE`.
+    """
+    count = lib.getProfile(DynamicSystem, None, None)
+    names = (ctypes.c_char_p * count)()
+    values = (ctypes.c_double * count)()
+    lib.getProfile(DynamicSystem, names, values)
+    return {names[i].decode('utf-8') : values[i] for i in range(count)}
+
+###################################################################################
+lib.resetProfile.argtypes = [ctypes.c_void_p]
+lib.resetProfile.restype = ctypes.c_void_p
+
+def resetProfile(DynamicSystem):
+    """
+        Resetting profiling counters of DynamicsSystem.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+    """
+    lib.resetProfile(DynamicSystem)
 
 ###################################################################################
 lib.createHelicopterDynamics.argtypes = [ctypes.c_char_p, c_float_p]
@@ -63,6 +137,80 @@ def createHelicopterDynamics(yaml_path, dt):
     """
     return lib.createHelicopterDynamics(ctypes.c_char_p(_to_encode(yaml_path)), ctypes.c_float(dt) )
 
+###################################################################################
+lib.cloneHelicopterDynamics.argtypes = [ctypes.c_void_p]
+lib.cloneHelicopterDynamics.restype = ctypes.c_void_p
+
+def cloneHelicopterDynamics(HelicopterDynamics):
+    """
+        Creating Helicopter Dynamics which shares parameters and terrain of existing 
+        one. It is much cheaper than `createHelicopterDynamics` since yaml file is not 
+        parsed again. State of the clone is initial state, so it should be reset.
+        >>> HelicopterDynamics : Address of HelicopterDynamics object to clone.
+
+        It returns the address of created HelicopterDynamics object.
+    """
+    return lib.cloneHelicopterDynamics(HelicopterDynamics)
+
+###################################################################################
+lib.acquireHelicopterDynamics.argtypes = [ctypes.c_char_p, c_float_p]
+lib.acquireHelicopterDynamics.restype = ctypes.c_void_p
+
+def acquireHelicopterDynamics(yaml_path, dt):
+    """
+        Getting Helicopter Dynamics from pool. Released instance of the same yaml file
+        is re-initialized in place if it exists, otherwise new instance is created.
+        >>> yaml_path : Path of yaml file which stores helicopter & wind parameters.
+        >>> dt        : Step size/time of helicopter calculations which calculated by 1/FPS.
+
+        It returns the address of HelicopterDynamics object.
+    """
+    return lib.acquireHelicopterDynamics(ctypes.c_char_p(_to_encode(yaml_path)), ctypes.c_float(dt) )
+
+###################################################################################
+lib.releaseHelicopterDynamics.argtypes = [ctypes.c_void_p]
+lib.releaseHelicopterDynamics.restype = ctypes.c_void_p
+
+def releaseHelicopterDynamics(HelicopterDynamics):
+    """
+        Releasing Helicopter Dynamics into pool to be recycled. Address should not be
+        used after releasing.
+        >>> HelicopterDynamics : Address of HelicopterDynamics object to release.
+    """
+    lib.releaseHelicopterDynamics(HelicopterDynamics)
+
+###################################################################################
+lib.setHelicopterPoolCapacity.argtypes = [ctypes.c_int]
+lib.setHelicopterPoolCapacity.restype = ctypes.c_void_p
+
+def setHelicopterPoolCapacity(capacity):
+    """
+        Setting maximum number of released instances which are kept for each yaml file.
+        >>> capacity : Maximum number of kept instances.
+    """
+    lib.setHelicopterPoolCapacity(capacity)
+
+###################################################################################
+lib.clearHelicopterPool.argtypes = []
+lib.clearHelicopterPool.restype = ctypes.c_void_p
+
+def clearHelicopterPool():
+    """
+        Deleting all released instances in pool.
+    """
+    lib.clearHelicopterPool()
+
+###################################################################################
+lib.destroyDynamicSystem.argtypes = [ctypes.c_void_p]
+lib.destroyDynamicSystem.restype = ctypes.c_void_p
+
+def destroyDynamicSystem(DynamicSystem):
+    """
+        Destroying DynamicsSystem. Address should not be used after destroying.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+    """
+    lib.destroyDynamicSystem(DynamicSystem)
+
 ###################################################################################
 lib.getAllAction.argtypes = [ctypes.c_void_p, c_int_p]
 lib.getAllAction.restype = np.ctypeslib.ndpointer(dtype=np.float32, ndim=1, shape=(100), flags='C_CONTIGUOUS')
@@ -340,6 +488,58 @@ def setValueInYamlNode(DynamicSystem, node_name, variable_name, value):
     """
     lib.setValueInYamlNode(DynamicSystem, ctypes.c_char_p(_to_encode(node_name)), ctypes.c_char_p(_to_encode(variable_name)), ctypes.c_float(value))
 
+###################################################################################
+lib.getParameterId.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p]
+lib.getParameterId.restype = ctypes.c_int
+
+def getParameterId(DynamicSystem, node_name, var_name):
+    """
+        Getting id of compiled parameter of DynamicsSystem.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> node_name     : Name of node which stores the variable.
+        >>> var_name      : Name of variable.
+
+        It returns id of parameter or -1 if the variable is not compiled.
+    """
+    return lib.getParameterId(DynamicSystem, ctypes.c_char_p(_to_encode(node_name)), ctypes.c_char_p(_to_encode(var_name)))
+
+###################################################################################
+lib.setParameters.argtypes = [ctypes.c_void_p, c_int_p, c_float_p, ctypes.c_int]
+lib.setParameters.restype = ctypes.c_void_p
+
+def setParameters(DynamicSystem, ids, values):
+    """
+        Setting compiled parameters of DynamicsSystem in one call. Only derived 
+        parameters which depend on them are calculated again.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> ids           : Ids of parameters from `getParameterId`.
+        >>> values        : New values of parameters.
+    """
+    n = len(ids)
+    ids = (ctypes.c_int * n)(*ids)
+    values = (ctypes.c_float * n)(*values)
+    lib.setParameters(DynamicSystem, ids, values, n)
+
+###################################################################################
+lib.setParametersBatch.argtypes = [ctypes.POINTER(ctypes.c_void_p), ctypes.c_int, c_int_p, ctypes.c_int, c_float_p]
+lib.setParametersBatch.restype = ctypes.c_void_p
+
+def setParametersBatch(batch, ids, values):
+    """
+        Setting compiled parameters of batch of DynamicsSystems in one call. It is equal
+        to `setParameters` for each system, so derived parameters of each system are
+        calculated one system at a time.
+        >>> batch  : List of addresses of DynamicSystem objects like HelicopterDynamics.
+        >>> ids    : Ids of parameters from `getParameterId`.
+        >>> values : Values of parameters with shape of (len(ids), len(batch)). Row `p` 
+            stores values of parameter `ids[p]` for all envs.
+    """
+    n_envs, n_params = len(batch), len(ids)
+    values = np.ascontiguousarray(values, dtype=np.float32).reshape(n_params, n_envs)
+    batch = (ctypes.c_void_p * n_envs)(*batch)
+    ids = (ctypes.c_int * n_params)(*ids)
+    lib.setParametersBatch(batch, n_envs, ids, n_params, values.ctypes.data_as(c_float_p))
+
 ###################################################################################
 lib.step.argtypes = [ctypes.c_void_p, np.ctypeslib.ndpointer(dtype=np.float32, flags='C_CONTIGUOUS')]
 lib.step.restype = ctypes.c_void_p
@@ -382,3 +582,405 @@ def getNumberOfObservations(DynamicSystem):
         It returns the number of observation of DynamicsSystem as integer.
     """
     return lib.getNumberOfObservations(DynamicSystem)
+
+###################################################################################
+lib.getStateSize.argtypes = [ctypes.c_void_p]
+lib.getStateSize.restype = ctypes.c_int
+
+def getStateSize(DynamicSystem):
+    """
+        Getting size of state snapshot of DynamicsSystem in bytes.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+    """
+    return lib.getStateSize(DynamicSystem)
+
+###################################################################################
+lib.saveState.argtypes = [ctypes.c_void_p, np.ctypeslib.ndpointer(dtype=np.uint8, flags='C_CONTIGUOUS')]
+lib.saveState.restype = ctypes.c_void_p
+
+def saveState(DynamicSystem, buffer=None):
+    """
+        Saving state of DynamicsSystem into flat buffer. State includes states, state
+        dots, actions, observations and hidden states such as random number generator.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> buffer        : Optional uint8 numpy buffer which has `getStateSize` bytes 
+                            to reuse. If it is None, new buffer is created.
+
+        It returns the buffer.
+    """
+    if buffer is None:
+        buffer = np.empty(getStateSize(DynamicSystem), dtype=np.uint8)
+    lib.saveState(DynamicSystem, buffer)
+    return buffer
+
+###################################################################################
+lib.loadState.argtypes = [ctypes.c_void_p, np.ctypeslib.ndpointer(dtype=np.uint8, flags='C_CONTIGUOUS')]
+lib.loadState.restype = ctypes.c_void_p
+
+def loadState(DynamicSystem, buffer):
+    """
+        Loading state of DynamicsSystem from buffer which is filled by `saveState`.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> buffer        : uint8 numpy buffer of state.
+    """
+    lib.loadState(DynamicSystem, buffer)
+
+###################################################################################
+lib.forkDynamicSystem.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_void_p)]
+lib.forkDynamicSystem.restype = ctypes.c_void_p
+
+def forkDynamicSystem(DynamicSystem, n):
+    """
+        Forking DynamicsSystem `n` times with its current state. Forks share immutable
+        data such as terrain.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> n             : Number of forks.
+
+        It returns the list of addresses of forked DynamicSystem objects.
+    """
+    forks = (ctypes.c_void_p * n)()
+    lib.forkDynamicSystem(DynamicSystem, n, forks)
+    return list(forks)
+
+###################################################################################
+lib.setSeed.argtypes = [ctypes.c_void_p, ctypes.c_uint]
+lib.setSeed.restype = ctypes.c_void_p
+
+def setSeed(DynamicSystem, seed):
+    """
+        Setting seed of random number generator of DynamicsSystem.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> seed          : Seed of random number generator.
+    """
+    lib.setSeed(DynamicSystem, seed)
+
+###################################################################################
+lib.setTurbulenceFieldOrigin.argtypes = [ctypes.c_void_p, np.ctypeslib.ndpointer(dtype=np.float32, flags='C_CONTIGUOUS')]
+lib.setTurbulenceFieldOrigin.restype = ctypes.c_void_p
+
+def setTurbulenceFieldOrigin(HelicopterDynamics, origin):
+    """
+        Setting origin of frozen turbulence field of HelicopterDynamics. Helicopters with
+        same origin fly through same turbulence if `TURB_FIELD_RND` is 0.
+        >>> HelicopterDynamics : Address of HelicopterDynamics object.
+        >>> origin             : Origin of field in NED frame [ft] which has 3 values.
+    """
+    lib.setTurbulenceFieldOrigin(HelicopterDynamics, np.ascontiguousarray(origin, dtype=np.float32))
+
+###################################################################################
+lib.setFastMath.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+lib.setFastMath.restype = ctypes.c_void_p
+
+def setFastMath(HelicopterDynamics, enable):
+    """
+        Setting fast math kernels of HelicopterDynamics. They approximate transcendental
+        functions in hot paths, so trajectories differ slightly from standard math. It has
+        effect only if library is built with `DYNAG_FAST_MATH`.
+        >>> HelicopterDynamics : Address of HelicopterDynamics object.
+        >>> enable             : True to use fast math kernels.
+    """
+    lib.setFastMath(HelicopterDynamics, enable)
+
+###################################################################################
+lib.setFastSubsteps.argtypes = [ctypes.c_void_p, ctypes.c_int]
+lib.setFastSubsteps.restype = ctypes.c_void_p
+
+def setFastSubsteps(DynamicSystem, substeps):
+    """
+        Setting number of sub-steps of fast states in a step of DynamicSystem. Fast states
+        such as actuators, inflows and flapping are integrated with `substeps` sub-steps
+        while the others are integrated with one step, so larger step size can be used.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> substeps      : Number of sub-steps. 1 integrates all states together.
+    """
+    lib.setFastSubsteps(DynamicSystem, substeps)
+
+###################################################################################
+lib.setObservationMask.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int]
+lib.setObservationMask.restype = ctypes.c_void_p
+
+def setObservationMask(DynamicSystem, names=None):
+    """
+        Setting observed groups of DynamicSystem. Unobserved groups are not calculated
+        and keep their registered values, so observation vector keeps its size.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> names         : Names of observed groups such as `eulerangles`. None or empty
+                            list observes all groups.
+    """
+    names = [] if names is None else list(names)
+    n = len(names)
+    names = (ctypes.c_char_p * n)(*[_to_encode(name) for name in names])
+    lib.setObservationMask(DynamicSystem, names, n)
+
+###################################################################################
+lib.setHistoryLength.argtypes = [ctypes.c_void_p, ctypes.c_int]
+lib.setHistoryLength.restype = ctypes.c_void_p
+
+def setHistoryLength(DynamicSystem, length):
+    """
+        Setting number of frames in observation history of DynamicSystem. A frame is
+        normalized observation followed by normalized action which led to it. History
+        is kept in C++ during step and filled with the first frame on reset.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> length        : Number of frames. 0 disables history.
+    """
+    lib.setHistoryLength(DynamicSystem, length)
+
+###################################################################################
+lib.getHistory.argtypes = [ctypes.c_void_p, c_int_p, c_int_p]
+lib.getHistory.restype = c_float_p
+
+def getHistory(DynamicSystem):
+    """
+        Getting observation history of DynamicSystem without copying.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+
+        It returns numpy view with shape of (length, frame_size) from oldest to newest
+        frame, or None if history is disabled. View is valid until the next step or
+        reset, so it should be copied to keep it.
+    """
+    length, frame_size = ctypes.c_int(0), ctypes.c_int(0)
+    history = lib.getHistory(DynamicSystem, ctypes.byref(length), ctypes.byref(frame_size))
+    if not history:
+        return None
+    return np.ctypeslib.as_array(history, shape=(length.value, frame_size.value))
+
+###################################################################################
+lib.getHistoryBatch.argtypes = [ctypes.POINTER(ctypes.c_void_p), ctypes.c_int, c_float_p]
+lib.getHistoryBatch.restype = ctypes.c_void_p
+
+def getHistoryBatch(batch, out=None):
+    """
+        Getting observation histories of batch of DynamicSystems in one call.
+        >>> batch : List of addresses of DynamicSystem objects like HelicopterDynamics.
+        >>> out   : Optional float32 numpy buffer with shape of (len(batch), length, 
+                    frame_size) to reuse. If it is None, new buffer is created.
+
+        It returns the buffer.
+    """
+    n_envs = len(batch)
+    if out is None:
+        length, frame_size = ctypes.c_int(0), ctypes.c_int(0)
+        lib.getHistory(batch[0], ctypes.byref(length), ctypes.byref(frame_size))
+        out = np.empty((n_envs, length.value, frame_size.value), dtype=np.float32)
+    batch = (ctypes.c_void_p * n_envs)(*batch)
+    lib.getHistoryBatch(batch, n_envs, out.ctypes.data_as(c_float_p))
+    return out
+
+###################################################################################
+lib.createResetPool.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.c_uint, c_int_p, c_int_p, 
+                                c_float_p, c_float_p, c_float_p, c_float_p, ctypes.c_int]
+lib.createResetPool.restype = ctypes.c_void_p
+
+def createResetPool(DynamicSystem, parameters=None, capacity=16, workers=2, seed=0):
+    """
+        Creating pool of pre-trimmed initial states of configuration of DynamicSystem. 
+        Background workers randomize parameters, reset and trim clones of it and keep 
+        `capacity` states ready.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+        >>> parameters    : List of randomized parameters as (id, distribution, a, b, low, high)
+                            tuples. Ids are from `getParameterId`. Distribution is 0 for uniform
+                            in [a, b) and 1 for normal with mean `a` and standard deviation `b`.
+                            Samples are clipped into [low, high].
+        >>> capacity      : Number of states which are kept ready.
+        >>> workers       : Number of background threads.
+        >>> seed          : Seed of parameter samples and turbulence of states.
+
+        It returns address of pool.
+    """
+    parameters = [] if parameters is None else list(parameters)
+    n = len(parameters)
+    ids = (ctypes.c_int * n)(*[int(p[0]) for p in parameters])
+    distributions = (ctypes.c_int * n)(*[int(p[1]) for p in parameters])
+    a, b, low, high = [(ctypes.c_float * n)(*[float(p[i]) for p in parameters]) for i in range(2, 6)]
+    return lib.createResetPool(DynamicSystem, capacity, workers, seed, ids, distributions, a, b, low, high, n)
+
+###################################################################################
+lib.destroyResetPool.argtypes = [ctypes.c_void_p]
+lib.destroyResetPool.restype = ctypes.c_void_p
+
+def destroyResetPool(ResetPool):
+    """
+        Destroying pool. It waits for workers which are trimming.
+        >>> ResetPool : Address of ResetPool object.
+    """
+    lib.destroyResetPool(ResetPool)
+
+###################################################################################
+lib.resetFromPool.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+lib.resetFromPool.restype = ctypes.c_void_p
+
+def resetFromPool(ResetPool, DynamicSystem):
+    """
+        Resetting DynamicSystem with a pre-trimmed state of pool. It is reset and trimmed in
+        calling thread if pool is empty.
+        >>> ResetPool     : Address of ResetPool object.
+        >>> DynamicSystem : Address of DynamicSystem object like HelicopterDynamics.
+    """
+    lib.resetFromPool(ResetPool, DynamicSystem)
+
+###################################################################################
+lib.getResetPoolSize.argtypes = [ctypes.c_void_p]
+lib.getResetPoolSize.restype = ctypes.c_int
+
+def getResetPoolSize(ResetPool):
+    """
+        Getting number of ready states of pool.
+        >>> ResetPool : Address of ResetPool object.
+    """
+    return lib.getResetPoolSize(ResetPool)
+
+###################################################################################
+lib.getResetPoolMisses.argtypes = [ctypes.c_void_p]
+lib.getResetPoolMisses.restype = ctypes.c_int
+
+def getResetPoolMisses(ResetPool):
+    """
+        Getting number of resets which did not find a ready state in pool.
+        >>> ResetPool : Address of ResetPool object.
+    """
+    return lib.getResetPoolMisses(ResetPool)
+
+###################################################################################
+lib.stepBatchAutoReset.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_void_p), ctypes.c_int, c_float_p, c_int_p, c_int_p, c_float_p]
+lib.stepBatchAutoReset.restype = ctypes.c_void_p
+
+def stepBatchAutoReset(ResetPool, batch, actions, final_observations=None, terminated=None):
+    """
+        Stepping batch of DynamicSystems and resetting failed or terminated ones from pool in one call.
+        >>> ResetPool          : Address of ResetPool object.
+        >>> batch              : List of addresses of DynamicSystem objects like HelicopterDynamics.
+        >>> actions            : Actions with shape of (len(batch), action_size).
+        >>> final_observations : Optional float32 numpy buffer with shape of (len(batch),
+                                 observation_size) to reuse. If it is None, new buffer is created.
+        >>> terminated         : Optional boolean mask with shape of (len(batch),). Systems whose
+                                 task is ended (failed, successed, time up) are reset instead of
+                                 being stepped.
+
+        It returns `dones` and `final_observations`. Reset systems have `dones` of True and 
+        their last normalized observations in `final_observations`. Failed step does not
+        calculate observations, so failed systems have observations of the step before it.
+        Other rows are not written.
+    """
+    n_envs = len(batch)
+    actions = np.ascontiguousarray(actions, dtype=np.float32)
+    if final_observations is None:
+        final_observations = np.zeros((n_envs, lib.getNumberOfObservations(batch[0])), dtype=np.float32)
+    terminated_p = None
+    if terminated is not None:
+        terminated = np.ascontiguousarray(terminated, dtype=np.int32)
+        terminated_p = terminated.ctypes.data_as(c_int_p)
+    dones = np.zeros(n_envs, dtype=np.int32)
+    batch = (ctypes.c_void_p * n_envs)(*batch)
+    lib.stepBatchAutoReset(ResetPool, batch, n_envs, actions.ctypes.data_as(c_float_p), terminated_p,
+                           dones.ctypes.data_as(c_int_p), final_observations.ctypes.data_as(c_float_p))
+    return dones.astype(bool), final_observations
+
+###################################################################################
+lib.getAttitudeBatch.argtypes = [ctypes.POINTER(ctypes.c_void_p), ctypes.c_int, c_float_p, c_float_p]
+lib.getAttitudeBatch.restype = ctypes.c_void_p
+
+def getAttitudeBatch(batch, euler=None, dcm=None):
+    """
+        Calculating Euler angles and DCMs of batch of DynamicSystems from their quaternion states
+        with batched kinematics kernels.
+        >>> batch : List of addresses of DynamicSystem objects like HelicopterDynamics.
+        >>> euler : Optional float32 numpy buffer with shape of (3, len(batch)) to reuse.
+        >>> dcm   : Optional float32 numpy buffer with shape of (9, len(batch)) to reuse.
+
+        It returns `euler` and `dcm`. Column `k` has Euler angles (phi, theta, psi) and row-major
+        DCM components of system `k`.
+    """
+    n_envs = len(batch)
+    if euler is None:
+        euler = np.zeros((3, n_envs), dtype=np.float32)
+    if dcm is None:
+        dcm = np.zeros((9, n_envs), dtype=np.float32)
+    batch = (ctypes.c_void_p * n_envs)(*batch)
+    lib.getAttitudeBatch(batch, n_envs, euler.ctypes.data_as(c_float_p), dcm.ctypes.data_as(c_float_p))
+    return euler, dcm
+
+###################################################################################
+lib.createAsyncBatch.argtypes = [ctypes.POINTER(ctypes.c_void_p), ctypes.c_int, ctypes.c_int, ctypes.c_void_p]
+lib.createAsyncBatch.restype = ctypes.c_void_p
+
+def createAsyncBatch(batch, workers=2, ResetPool=None):
+    """
+        Creating batch of DynamicSystems which are stepped by background workers.
+        >>> batch     : List of addresses of DynamicSystem objects like HelicopterDynamics.
+                        Systems should have same action and observation sizes.
+        >>> workers   : Number of background threads.
+        >>> ResetPool : Optional address of ResetPool object. Failed systems are reset from
+                        it after their step.
+
+        It returns address of async batch.
+    """
+    n_envs = len(batch)
+    batch = (ctypes.c_void_p * n_envs)(*batch)
+    return lib.createAsyncBatch(batch, n_envs, workers, ResetPool)
+
+###################################################################################
+lib.destroyAsyncBatch.argtypes = [ctypes.c_void_p]
+lib.destroyAsyncBatch.restype = ctypes.c_void_p
+
+def destroyAsyncBatch(AsyncBatch):
+    """
+        Destroying async batch. It waits for systems which are being stepped.
+        >>> AsyncBatch : Address of AsyncBatch object.
+    """
+    lib.destroyAsyncBatch(AsyncBatch)
+
+###################################################################################
+lib.sendActions.argtypes = [ctypes.c_void_p, c_int_p, c_float_p, ctypes.c_int]
+lib.sendActions.restype = ctypes.c_void_p
+
+def sendActions(AsyncBatch, env_ids, actions):
+    """
+        Sending actions of systems to workers. It returns immediately.
+        >>> AsyncBatch : Address of AsyncBatch object.
+        >>> env_ids    : Indices of systems in batch. A system should be received before it 
+                         is sent again.
+        >>> actions    : Actions with shape of (len(env_ids), action_size).
+    """
+    env_ids = np.ascontiguousarray(env_ids, dtype=np.int32)
+    actions = np.ascontiguousarray(actions, dtype=np.float32)
+    lib.sendActions(AsyncBatch, env_ids.ctypes.data_as(c_int_p), actions.ctypes.data_as(c_float_p), len(env_ids))
+
+###################################################################################
+lib.recvResults.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, c_int_p, c_float_p, c_int_p, c_float_p]
+lib.recvResults.restype = ctypes.c_int
+
+def recvResults(AsyncBatch, min_count, observations, final_observations=None):
+    """
+        Receiving stepped systems in finishing order. It waits for `min_count` systems.
+        >>> AsyncBatch         : Address of AsyncBatch object.
+        >>> min_count          : Minimum number of received systems. It should not be more
+                                 than number of systems in flight.
+        >>> observations       : Float32 numpy buffer with shape of (max_count, observation_size).
+                                 At most `max_count` systems are received.
+        >>> final_observations : Optional float32 numpy buffer with same shape as `observations`.
+
+        It returns `env_ids`, `observations`, `dones` and `final_observations` of received 
+        systems. Observations are views of the buffers. Done systems have their last normalized 
+        observations in `final_observations`, which are the ones of the step before the failed
+        step. Other rows are not written.
+    """
+    max_count = observations.shape[0]
+    env_ids = np.zeros(max_count, dtype=np.int32)
+    dones = np.zeros(max_count, dtype=np.int32)
+    final_p = None if final_observations is None else final_observations.ctypes.data_as(c_float_p)
+    n = lib.recvResults(AsyncBatch, min_count, max_count, env_ids.ctypes.data_as(c_int_p), 
+                        observations.ctypes.data_as(c_float_p), dones.ctypes.data_as(c_int_p), final_p)
+    final_observations = None if final_observations is None else final_observations[:n]
+    return env_ids[:n], observations[:n], dones[:n].astype(bool), final_observations
+
+###################################################################################
+lib.getAsyncBatchInFlight.argtypes = [ctypes.c_void_p]
+lib.getAsyncBatchInFlight.restype = ctypes.c_int
+
+def getAsyncBatchInFlight(AsyncBatch):
+    """
+        Getting number of systems which are sent and not received.
+        >>> AsyncBatch : Address of AsyncBatch object.
+    """
+    return lib.getAsyncBatchInFlight(AsyncBatch)
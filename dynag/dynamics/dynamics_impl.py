@@ -6,6 +6,22 @@
 # Author : @MGokcayK
 # C.Date : 22/12/2021
 # Update : 22/12/2021 - Initialization & Implementation // @MGokcayK
+# Update : 19/10/2026 - Adding state snapshot and fork methods // @MGokcayK
+# Update : 19/10/2026 - Adding clone method // @MGokcayK
+# Update : 19/10/2026 - Adding pooled creation and close method // @MGokcayK
+# Update : 19/10/2026 - Adding compiled parameter methods // @MGokcayK
+# Update : 19/10/2026 - Adding batched parameter setter // @MGokcayK
+# Update : 19/10/2026 - Using per-instance status for ready // @MGokcayK
+# Update : 19/10/2026 - Adding profiling counters // @MGokcayK
+# Update : 19/10/2026 - Adding turbulence field origin setter // @MGokcayK
+# Update : 19/10/2026 - Adding fast math setter // @MGokcayK
+# Update : 19/10/2026 - Adding fast sub-steps setter // @MGokcayK
+# Update : 19/10/2026 - Adding observation mask // @MGokcayK
+# Update : 19/10/2026 - Adding observation history // @MGokcayK
+# Update : 19/10/2026 - Adding reset pool of pre-trimmed states // @MGokcayK
+# Update : 19/10/2026 - Adding asynchronous batch stepping // @MGokcayK
+# Update : 19/10/2026 - Adding rotor hubs of renderer model for culling // @MGokcayK
+# Update : 19/10/2026 - Fixing observation size of async batch // @MGokcayK
 #
 
 from . import dynamicsAPI
@@ -20,13 +36,44 @@ D2R         = 1/R2D
 FT2MTR      = 0.3048 # ft to meter
 TAU         = 2*math.pi
 
+# Model space hubs which `<heliName>_vertex.vs` shaders rotate rotor blades about.
+ROTOR_HUBS  = {"aw109": [(0.207604, 1.31428, 0.004184), (-6.1315, 0.662, 0.0)]}
+
 class Helicopter():
-    def __init__(self, heliName:str, dt:float) -> None:
+    def __init__(self, heliName:str, dt:float, pooled:bool=False, observations:list=None) -> None:
         self.heliName = heliName
         parent_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), os.pardir))
         yaml_path = os.path.join(parent_dir, "helis", self.heliName + ".yaml")
         self.DT = dt
-        self.heliDyn = dynamicsAPI.createHelicopterDynamics(yaml_path, self.DT)
+        # Pooled helicopters recycle released instances of the same yaml file.
+        self.pooled = pooled
+        if self.pooled:
+            self.heliDyn = dynamicsAPI.acquireHelicopterDynamics(yaml_path, self.DT)
+        else:
+            self.heliDyn = dynamicsAPI.createHelicopterDynamics(yaml_path, self.DT)
+        # Only given observation groups are calculated if they are set.
+        if observations:
+            self.setObservationMask(observations)
+
+    @classmethod
+    def _fromDynamics(cls, heliName:str, dt:float, heliDyn):
+        # Wrap already created helicopter dynamics such as forks.
+        heli = cls.__new__(cls)
+        heli.heliName = heliName
+        heli.DT = dt
+        heli.heliDyn = heliDyn
+        heli.pooled = False
+        return heli
+
+    def close(self):
+        # Release dynamics into pool or destroy it. Helicopter should not be used after it.
+        if self.heliDyn is None:
+            return
+        if self.pooled:
+            dynamicsAPI.releaseHelicopterDynamics(self.heliDyn)
+        else:
+            dynamicsAPI.destroyDynamicSystem(self.heliDyn)
+        self.heliDyn = None
 
     @property
     def getNumberOfDynamicsObservation(self):
@@ -40,12 +87,29 @@ class Helicopter():
         self.helicopterRenderObj = renderer.createModel('/resources/models/'+ self.heliName +'/'+ self.heliName +'.obj',
                                                           '/resources/shaders/'+ self.heliName +'_vertex.vs',
                                                           '/resources/shaders/'+ self.heliName +'_frag.fs')
+        for hub in ROTOR_HUBS.get(self.heliName, []):
+            renderer.addModelRotationPivot(self.helicopterRenderObj, *hub)
 
         renderer.addPermanentObject2Window(self.helicopterRenderObj)
 
     ############################# HELICOPTER - API RELATION ################################
     def ready(self):
-        return dynamicsAPI.ready()
+        return dynamicsAPI.ready(self.heliDyn)
+
+    def getStatus(self):
+        return dynamicsAPI.getStatus(self.heliDyn)
+
+    def getStatusMessage(self):
+        return dynamicsAPI.getStatusMessage(self.heliDyn)
+
+    def getProfile(self):
+        # Fraction of step time w.r.t sections. Sections are inclusive, so they do not sum to one.
+        profile = dynamicsAPI.getProfile(self.heliDyn)
+        step = profile.get('step', 0.0)
+        return {name : (ticks / step if step > 0.0 else 0.0) for name, ticks in profile.items()}
+
+    def resetProfile(self):
+        dynamicsAPI.resetProfile(self.heliDyn)
 
     def getAllHelicopterAction(self):
         return dynamicsAPI.getAllAction(self.heliDyn)
@@ -103,6 +167,56 @@ class Helicopter():
     
     def setValueInYamlFile(self, nodeName:str, variableName:str, value):
         dynamicsAPI.setValueInYamlNode(self.heliDyn, nodeName, variableName, value)
+
+    def getParameterId(self, nodeName:str, variableName:str):
+        return dynamicsAPI.getParameterId(self.heliDyn, nodeName, variableName)
+
+    def setParameters(self, ids, values):
+        dynamicsAPI.setParameters(self.heliDyn, ids, values)
+
+    @staticmethod
+    def setParametersBatch(helicopters, ids, values):
+        # Values has shape of (len(ids), len(helicopters)).
+        dynamicsAPI.setParametersBatch([heli.heliDyn for heli in helicopters], ids, values)
+
+    def saveState(self, buffer=None):
+        return dynamicsAPI.saveState(self.heliDyn, buffer)
+
+    def loadState(self, buffer):
+        dynamicsAPI.loadState(self.heliDyn, buffer)
+
+    def clone(self):
+        return Helicopter._fromDynamics(self.heliName, self.DT, dynamicsAPI.cloneHelicopterDynamics(self.heliDyn))
+
+    def fork(self, n:int):
+        return [Helicopter._fromDynamics(self.heliName, self.DT, heliDyn) for heliDyn in dynamicsAPI.forkDynamicSystem(self.heliDyn, n)]
+
+    def setSeed(self, seed:int):
+        dynamicsAPI.setSeed(self.heliDyn, seed)
+
+    def setTurbulenceFieldOrigin(self, origin):
+        dynamicsAPI.setTurbulenceFieldOrigin(self.heliDyn, origin)
+
+    def setFastMath(self, enable:bool):
+        dynamicsAPI.setFastMath(self.heliDyn, enable)
+
+    def setFastSubsteps(self, substeps:int):
+        dynamicsAPI.setFastSubsteps(self.heliDyn, substeps)
+
+    def setObservationMask(self, observations:list=None):
+        dynamicsAPI.setObservationMask(self.heliDyn, observations)
+
+    def setHistoryLength(self, length:int):
+        dynamicsAPI.setHistoryLength(self.heliDyn, length)
+
+    def getHistory(self):
+        # View of (length, frame_size) history which is valid until the next step or reset.
+        return dynamicsAPI.getHistory(self.heliDyn)
+
+    @staticmethod
+    def getHistoryBatch(helicopters, out=None):
+        # Histories has shape of (len(helicopters), length, frame_size).
+        return dynamicsAPI.getHistoryBatch([heli.heliDyn for heli in helicopters], out)
     
     ##################################################################################
     def render(self, renderer):
@@ -146,3 +260,95 @@ class Helicopter():
 
     def resetHelicopter(self):
         dynamicsAPI.reset(self.heliDyn)
+
+
+class ResetPool():
+    """
+        Pool of pre-trimmed initial states of a helicopter configuration. Background workers
+        randomize parameters, reset and trim clones of the helicopter, so resetting from pool
+        only copies a ready state. Pooled states can be used by helicopters of the same yaml
+        file with the same observation mask and history length.
+
+        >>> helicopter : Helicopter whose configuration is cloned.
+        >>> parameters : List of randomized parameters as (nodeName, variableName, distribution, 
+                         a, b) or (nodeName, variableName, distribution, a, b, low, high) tuples.
+                         Distribution is "uniform" in [a, b) or "normal" with mean `a` and 
+                         standard deviation `b`. Samples are clipped into [low, high].
+        >>> capacity   : Number of states which are kept ready.
+        >>> workers    : Number of background threads.
+        >>> seed       : Seed of parameter samples and turbulence of states.
+    """
+    DISTRIBUTIONS = {"uniform": 0, "normal": 1}
+
+    def __init__(self, helicopter:Helicopter, parameters:list=None, capacity:int=16, workers:int=2, seed:int=0) -> None:
+        params = []
+        for p in (parameters or []):
+            low, high = (p[5], p[6]) if len(p) > 5 else (-np.inf, np.inf)
+            params.append((helicopter.getParameterId(p[0], p[1]), ResetPool.DISTRIBUTIONS[p[2]], p[3], p[4], low, high))
+        self.pool = dynamicsAPI.createResetPool(helicopter.heliDyn, params, capacity, workers, seed)
+
+    def close(self):
+        # Stop workers and destroy pool. Pool should not be used after it.
+        if self.pool is None:
+            return
+        dynamicsAPI.destroyResetPool(self.pool)
+        self.pool = None
+
+    def reset(self, helicopter:Helicopter):
+        dynamicsAPI.resetFromPool(self.pool, helicopter.heliDyn)
+
+    @property
+    def size(self):
+        return dynamicsAPI.getResetPoolSize(self.pool)
+
+    @property
+    def misses(self):
+        return dynamicsAPI.getResetPoolMisses(self.pool)
+
+    def stepBatch(self, helicopters, actions, final_observations=None, terminated=None):
+        # Failed helicopters and helicopters whose `terminated` is True are reset from pool. It 
+        # returns dones and last observations of reset helicopters, whose other rows are not written.
+        return dynamicsAPI.stepBatchAutoReset(self.pool, [heli.heliDyn for heli in helicopters], actions, 
+                                              final_observations, terminated)
+
+
+class AsyncBatch():
+    """
+        Batch of helicopters which are stepped by background workers while the caller does 
+        something else such as policy inference. Actions of some helicopters are sent and 
+        whichever helicopters finish first are received. A helicopter should not be sent 
+        again or used until it is received.
+
+        >>> helicopters : List of helicopters with same action and observation sizes.
+        >>> workers     : Number of background threads.
+        >>> pool        : Optional ResetPool. Failed helicopters are reset from it after their step.
+    """
+    def __init__(self, helicopters:list, workers:int=2, pool:ResetPool=None) -> None:
+        self.helicopters = list(helicopters)
+        self.pool = pool
+        n_obs = self.helicopters[0].getNumberOfDynamicsObservation
+        self.observations = np.zeros((len(self.helicopters), n_obs), dtype=np.float32)
+        self.final_observations = np.zeros((len(self.helicopters), n_obs), dtype=np.float32)
+        self.batch = dynamicsAPI.createAsyncBatch([heli.heliDyn for heli in self.helicopters], workers, 
+                                                  None if pool is None else pool.pool)
+
+    def close(self):
+        # Wait for helicopters which are being stepped and destroy batch.
+        if self.batch is None:
+            return
+        dynamicsAPI.destroyAsyncBatch(self.batch)
+        self.batch = None
+
+    def send(self, env_ids, actions):
+        dynamicsAPI.sendActions(self.batch, env_ids, actions)
+
+    def recv(self, min_count:int=1, max_count:int=None):
+        # It returns env ids, normalized observations, dones and final observations of received 
+        # helicopters. Observations are views which are overwritten by the next `recv`.
+        max_count = len(self.helicopters) if max_count is None else min(max_count, len(self.helicopters))
+        return dynamicsAPI.recvResults(self.batch, min_count, self.observations[:max_count], self.final_observations[:max_count])
+
+    @property
+    def in_flight(self):
+        return dynamicsAPI.getAsyncBatchInFlight(self.batch)
+
@@ -0,0 +1,849 @@
+/*
+* DynaG Dynamics C++ / Native Python Module
+*
+* Native Python module `dynamicsNative` of dynamics library. It is an alternative of
+* ctypes based `dynamicsAPI.py` for training loops, where per call conversion of ctypes
+* dominates the step time of small systems. Inputs are any objects which support buffer
+* protocol such as float32 NumPy arrays, so they are read without copying. Outputs are
+* `Buffer` objects which are views of C++ vectors or own their values. They support
+* buffer protocol and DLPack, so `numpy.asarray` and `torch.from_dlpack` use them
+* without copying. GIL is released while dynamics run, so Python threads step other
+* instances at the same time.
+*
+* Views of observations, states and actions are updated by each step. View of history is
+* valid until the next step. Helicopter counts its views, and `close`, `setObservationMask`
+* and `setHistoryLength` raise BufferError while any of them exists, since they free or
+* reallocate viewed memory. Arrays and tensors which are created from a view keep it alive.
+*
+* Usage :
+*   import dynamicsNative, numpy as np
+*   heli = dynamicsNative.Helicopter("helis/aw109.yaml", 0.01)
+*   obs = np.asarray(heli.getAllNormalizedObservation())
+*   heli.reset()
+*   heli.step(np.zeros(4, dtype=np.float32))
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Counting views of helicopters to keep their memory alive. // @MGokcayK
+* Update : 19/10/2026 - Adding batched attitude readback. // @MGokcayK
+*/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "dyn_api.h"
+#include <algorithm>
+#include <cstring>
+
+// DLPack structures of its 0.8 ABI. They are declared here, so module does not need dlpack.h.
+enum { kDLCPU = 1 };
+enum { kDLFloat = 2 };
+
+struct DLDevice { int32_t device_type; int32_t device_id; };
+struct DLDataType { uint8_t code; uint8_t bits; uint16_t lanes; };
+struct DLTensor
+{
+	void* data;
+	DLDevice device;
+	int32_t ndim;
+	DLDataType dtype;
+	int64_t* shape;
+	int64_t* strides;
+	uint64_t byte_offset;
+};
+struct DLManagedTensor
+{
+	DLTensor dl_tensor;
+	void* manager_ctx;
+	void (*deleter)(DLManagedTensor* self);
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Buffer
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Row-major float32 array which is a view of memory of `owner` or owns its values.
+struct BufferObject
+{
+	PyObject_HEAD
+	float* pData;
+	int iDimensions;
+	Py_ssize_t iShape[3];
+	Py_ssize_t iStrides[3];
+	int64_t iShape64[3];
+	bool bReadOnly;
+	PyObject* owner;              // kept alive while view exists
+	Py_ssize_t* pExports;         // view counter of owner which is decremented at deallocation
+	std::vector<float>* pValues;  // values of buffer if it is not a view
+};
+
+static PyTypeObject BufferType = { PyVarObject_HEAD_INIT(NULL, 0) };
+
+static BufferObject* newBuffer(int iDimensions, const Py_ssize_t* iShape)
+{
+	BufferObject* self = PyObject_New(BufferObject, &BufferType);
+	if (!self) return NULL;
+	self->pData = NULL;
+	self->iDimensions = iDimensions;
+	self->bReadOnly = false;
+	self->owner = NULL;
+	self->pExports = NULL;
+	self->pValues = NULL;
+	Py_ssize_t iStride = sizeof(float);
+	for (int d = iDimensions - 1; d >= 0; d--)
+	{
+		self->iShape[d] = iShape[d];
+		self->iShape64[d] = iShape[d];
+		self->iStrides[d] = iStride;
+		iStride *= iShape[d];
+	}
+	return self;
+}
+
+// Creating view of `pData` which belongs to `owner`. `pExports` of owner counts its views.
+static PyObject* newView(PyObject* owner, Py_ssize_t* pExports, float* pData, int iDimensions, const Py_ssize_t* iShape, bool bReadOnly)
+{
+	BufferObject* self = newBuffer(iDimensions, iShape);
+	if (!self) return NULL;
+	self->pData = pData;
+	self->bReadOnly = bReadOnly;
+	Py_INCREF(owner);
+	self->owner = owner;
+	self->pExports = pExports;
+	(*pExports)++;
+	return (PyObject*)self;
+}
+
+// Creating zero initialized buffer which owns its values.
+static PyObject* newOwnedBuffer(int iDimensions, const Py_ssize_t* iShape)
+{
+	BufferObject* self = newBuffer(iDimensions, iShape);
+	if (!self) return NULL;
+	Py_ssize_t iCount = 1;
+	for (int d = 0; d < iDimensions; d++) iCount *= iShape[d];
+	self->pValues = new std::vector<float>((size_t)iCount, 0.0f);
+	self->pData = self->pValues->data();
+	return (PyObject*)self;
+}
+
+static void Buffer_dealloc(BufferObject* self)
+{
+	if (self->pExports) (*self->pExports)--;
+	Py_XDECREF(self->owner);
+	delete self->pValues;
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int Buffer_getbuffer(BufferObject* self, Py_buffer* view, int iFlags)
+{
+	if ((iFlags & PyBUF_WRITABLE) && self->bReadOnly)
+	{
+		PyErr_SetString(PyExc_BufferError, "Buffer is read-only!");
+		return -1;
+	}
+	Py_ssize_t iCount = 1;
+	for (int d = 0; d < self->iDimensions; d++) iCount *= self->iShape[d];
+
+	view->buf = self->pData;
+	Py_INCREF(self);
+	view->obj = (PyObject*)self;
+	view->len = iCount * (Py_ssize_t)sizeof(float);
+	view->itemsize = sizeof(float);
+	view->readonly = self->bReadOnly ? 1 : 0;
+	view->format = (iFlags & PyBUF_FORMAT) ? (char*)"f" : NULL;
+	view->ndim = self->iDimensions;
+	view->shape = (iFlags & PyBUF_ND) ? self->iShape : NULL;
+	view->strides = (iFlags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->iStrides : NULL;
+	view->suboffsets = NULL;
+	view->internal = NULL;
+	return 0;
+}
+
+static PyBufferProcs BufferProcs = { (getbufferproc)Buffer_getbuffer, NULL };
+
+// Deleter of DLPack tensor. Consumer may call it without GIL.
+static void deleteManagedTensor(DLManagedTensor* pTensor)
+{
+	PyGILState_STATE gilState = PyGILState_Ensure();
+	Py_XDECREF((PyObject*)pTensor->manager_ctx);
+	PyGILState_Release(gilState);
+	delete pTensor;
+}
+
+// Destructor of capsule. Consumer renames capsule after it takes the tensor, so tensor is
+// deleted here only if it is not consumed.
+static void deleteDLPackCapsule(PyObject* capsule)
+{
+	if (!PyCapsule_IsValid(capsule, "dltensor")) return;
+	DLManagedTensor* pTensor = (DLManagedTensor*)PyCapsule_GetPointer(capsule, "dltensor");
+	if (pTensor && pTensor->deleter) pTensor->deleter(pTensor);
+}
+
+static PyObject* Buffer_dlpack(BufferObject* self, PyObject* args, PyObject* kwargs)
+{
+	// Values are on CPU, so `stream` and other keyword arguments are not used.
+	DLManagedTensor* pTensor = new DLManagedTensor();
+	pTensor->dl_tensor.data = self->pData;
+	pTensor->dl_tensor.device = { kDLCPU, 0 };
+	pTensor->dl_tensor.ndim = self->iDimensions;
+	pTensor->dl_tensor.dtype = { kDLFloat, 32, 1 };
+	pTensor->dl_tensor.shape = self->iShape64;
+	pTensor->dl_tensor.strides = NULL; // row-major
+	pTensor->dl_tensor.byte_offset = 0;
+	Py_INCREF(self);
+	pTensor->manager_ctx = self;
+	pTensor->deleter = deleteManagedTensor;
+
+	PyObject* capsule = PyCapsule_New(pTensor, "dltensor", deleteDLPackCapsule);
+	if (!capsule) deleteManagedTensor(pTensor);
+	return capsule;
+}
+
+static PyObject* Buffer_dlpack_device(BufferObject* self, PyObject*)
+{
+	return Py_BuildValue("(ii)", (int)kDLCPU, 0);
+}
+
+static PyObject* Buffer_getShape(BufferObject* self, void*)
+{
+	PyObject* shape = PyTuple_New(self->iDimensions);
+	if (!shape) return NULL;
+	for (int d = 0; d < self->iDimensions; d++) PyTuple_SET_ITEM(shape, d, PyLong_FromSsize_t(self->iShape[d]));
+	return shape;
+}
+
+static PyObject* Buffer_getReadOnly(BufferObject* self, void*)
+{
+	return PyBool_FromLong(self->bReadOnly);
+}
+
+static PyMethodDef BufferMethods[] = {
+	{ "__dlpack__", (PyCFunction)(void(*)(void))Buffer_dlpack, METH_VARARGS | METH_KEYWORDS, "Getting DLPack capsule of buffer." },
+	{ "__dlpack_device__", (PyCFunction)Buffer_dlpack_device, METH_NOARGS, "Getting DLPack device of buffer." },
+	{ NULL }
+};
+
+static PyGetSetDef BufferGetSet[] = {
+	{ "shape", (getter)Buffer_getShape, NULL, "Shape of buffer.", NULL },
+	{ "readonly", (getter)Buffer_getReadOnly, NULL, "True if buffer is a read-only view.", NULL },
+	{ NULL }
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Argument helpers
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Getting C contiguous float32 buffer of `obj` which has `iCount` values.
+static bool getFloatBuffer(PyObject* obj, Py_buffer* view, Py_ssize_t iCount, const char* sName, bool bWritable = false)
+{
+	if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (bWritable ? PyBUF_WRITABLE : 0)) != 0) return false;
+	const char* sFormat = view->format ? view->format : "B";
+	if (sFormat[0] == '<' || sFormat[0] == '=' || sFormat[0] == '@') sFormat++;
+	if (view->itemsize != sizeof(float) || std::strcmp(sFormat, "f") != 0 || view->len != iCount * (Py_ssize_t)sizeof(float))
+	{
+		PyErr_Format(PyExc_ValueError, "`%s` should be contiguous float32 buffer with %zd values!", sName, iCount);
+		PyBuffer_Release(view);
+		return false;
+	}
+	return true;
+}
+
+// Getting writable output `out` with given shape. New buffer is created if `out` is None.
+// Returned object is a new reference and `view` should be released if it is not None.
+static PyObject* getOutput(PyObject* out, int iDimensions, const Py_ssize_t* iShape, Py_buffer* view, float** pData)
+{
+	if (!out || out == Py_None)
+	{
+		PyObject* buffer = newOwnedBuffer(iDimensions, iShape);
+		if (buffer) *pData = ((BufferObject*)buffer)->pData;
+		view->obj = NULL;
+		return buffer;
+	}
+	Py_ssize_t iCount = 1;
+	for (int d = 0; d < iDimensions; d++) iCount *= iShape[d];
+	if (!getFloatBuffer(out, view, iCount, "out", true)) return NULL;
+	*pData = (float*)view->buf;
+	Py_INCREF(out);
+	return out;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Helicopter
+//////////////////////////////////////////////////////////////////////////////////////////
+
+struct HelicopterObject
+{
+	PyObject_HEAD
+	HelicopterDynamics* HD;
+	bool bPooled;
+	Py_ssize_t iExports; // number of views of dynamics
+};
+
+static PyTypeObject HelicopterType = { PyVarObject_HEAD_INIT(NULL, 0) };
+
+// Stepping dynamics with actions. `step` of C API is not called, since libc exports a
+// legacy `step` symbol which can be bound instead of it.
+static void stepDynamics(HelicopterDynamics* HD, float* fActions)
+{
+	HD->vsAction.setValues(fActions);
+	HD->step();
+}
+
+static void releaseDynamics(HelicopterObject* self)
+{
+	if (!self->HD) return;
+	if (self->bPooled) releaseHelicopterDynamics(self->HD);
+	else destroyDynamicSystem(self->HD);
+	self->HD = NULL;
+}
+
+static bool checkHelicopter(HelicopterObject* self)
+{
+	if (self->HD) return true;
+	PyErr_SetString(PyExc_RuntimeError, "Helicopter is not initialized or it is closed!");
+	return false;
+}
+
+// Checking that no view points into dynamics before its memory is freed or reallocated.
+static bool checkExports(HelicopterObject* self, const char* sAction)
+{
+	if (self->iExports == 0) return true;
+	PyErr_Format(PyExc_BufferError, "Helicopter cannot %s while %zd view(s) of it exist!", sAction, self->iExports);
+	return false;
+}
+
+static PyObject* Helicopter_new(PyTypeObject* type, PyObject*, PyObject*)
+{
+	HelicopterObject* self = (HelicopterObject*)type->tp_alloc(type, 0);
+	if (self)
+	{
+		self->HD = NULL;
+		self->bPooled = false;
+		self->iExports = 0;
+	}
+	return (PyObject*)self;
+}
+
+static int Helicopter_init(HelicopterObject* self, PyObject* args, PyObject* kwargs)
+{
+	static const char* sKeywords[] = { "yaml_path", "dt", "pooled", NULL };
+	const char* sYamlPath;
+	float fDt;
+	int iPooled = 0;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "sf|p", (char**)sKeywords, &sYamlPath, &fDt, &iPooled)) return -1;
+	if (!checkExports(self, "be initialized again")) return -1;
+
+	releaseDynamics(self);
+	HelicopterDynamics* HD;
+	Py_BEGIN_ALLOW_THREADS
+	HD = iPooled ? acquireHelicopterDynamics((char*)sYamlPath, &fDt) : createHelicopterDynamics((char*)sYamlPath, &fDt);
+	Py_END_ALLOW_THREADS
+	self->HD = HD;
+	self->bPooled = iPooled != 0;
+	return 0;
+}
+
+static void Helicopter_dealloc(HelicopterObject* self)
+{
+	releaseDynamics(self);
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* Helicopter_close(HelicopterObject* self, PyObject*)
+{
+	if (!checkExports(self, "be closed")) return NULL;
+	releaseDynamics(self);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_step(HelicopterObject* self, PyObject* action)
+{
+	if (!checkHelicopter(self)) return NULL;
+	Py_buffer view;
+	if (!getFloatBuffer(action, &view, (Py_ssize_t)self->HD->vsAction.vValues.size(), "action")) return NULL;
+	HelicopterDynamics* HD = self->HD;
+	Py_BEGIN_ALLOW_THREADS
+	stepDynamics(HD, (float*)view.buf);
+	Py_END_ALLOW_THREADS
+	PyBuffer_Release(&view);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_reset(HelicopterObject* self, PyObject*)
+{
+	if (!checkHelicopter(self)) return NULL;
+	HelicopterDynamics* HD = self->HD;
+	Py_BEGIN_ALLOW_THREADS
+	HD->reset();
+	Py_END_ALLOW_THREADS
+	Py_RETURN_NONE;
+}
+
+// Getting read-only view of all values of a vector space.
+template<VectorSpace DynamicSystem::* VS, bool NORMALIZED>
+static PyObject* Helicopter_getAll(HelicopterObject* self, PyObject*)
+{
+	if (!checkHelicopter(self)) return NULL;
+	VectorSpace& vs = self->HD->*VS;
+	Py_ssize_t iShape[1] = { (Py_ssize_t)vs.vValues.size() };
+	return newView((PyObject*)self, &self->iExports, NORMALIZED ? vs.vNormalizedValues.data() : vs.vValues.data(), 1, iShape, true);
+}
+
+// Getting read-only view of a vector of a vector space w.r.t its name.
+template<VectorSpace DynamicSystem::* VS, bool NORMALIZED>
+static PyObject* Helicopter_get(HelicopterObject* self, PyObject* name)
+{
+	if (!checkHelicopter(self)) return NULL;
+	const char* sName = PyUnicode_AsUTF8(name);
+	if (!sName) return NULL;
+	VectorSpace& vs = self->HD->*VS;
+	auto ind = vs.mapInfo.find(sName);
+	if (ind == vs.mapInfo.end())
+	{
+		PyErr_Format(PyExc_KeyError, "Vector `%s` is not found in %s!", sName, vs.sName.c_str());
+		return NULL;
+	}
+	Py_ssize_t iShape[1] = { (Py_ssize_t)ind->second.size };
+	float* pData = (NORMALIZED ? vs.vNormalizedValues.data() : vs.vValues.data()) + ind->second.index;
+	return newView((PyObject*)self, &self->iExports, pData, 1, iShape, true);
+}
+
+static PyObject* Helicopter_getNumberOfObservations(HelicopterObject* self, PyObject*)
+{
+	if (!checkHelicopter(self)) return NULL;
+	return PyLong_FromLong(getNumberOfObservations(self->HD));
+}
+
+static PyObject* Helicopter_getStatus(HelicopterObject* self, PyObject*)
+{
+	if (!checkHelicopter(self)) return NULL;
+	return Py_BuildValue("(ii)", self->HD->iStatus, self->HD->iStatusIndex);
+}
+
+static PyObject* Helicopter_getStatusMessage(HelicopterObject* self, PyObject*)
+{
+	if (!checkHelicopter(self)) return NULL;
+	return PyUnicode_FromString(self->HD->sStatusMessage.c_str());
+}
+
+static PyObject* Helicopter_setSeed(HelicopterObject* self, PyObject* arg)
+{
+	if (!checkHelicopter(self)) return NULL;
+	unsigned long iSeed = PyLong_AsUnsignedLong(arg);
+	if (PyErr_Occurred()) return NULL;
+	self->HD->setSeed((unsigned int)iSeed);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_setFastMath(HelicopterObject* self, PyObject* arg)
+{
+	if (!checkHelicopter(self)) return NULL;
+	int iEnable = PyObject_IsTrue(arg);
+	if (iEnable < 0) return NULL;
+	setFastMath(self->HD, iEnable);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_setFastSubsteps(HelicopterObject* self, PyObject* arg)
+{
+	if (!checkHelicopter(self)) return NULL;
+	long iSubsteps = PyLong_AsLong(arg);
+	if (PyErr_Occurred()) return NULL;
+	if (iSubsteps < 1)
+	{
+		PyErr_SetString(PyExc_ValueError, "Fast sub-steps should be positive!");
+		return NULL;
+	}
+	setFastSubsteps(self->HD, (int)iSubsteps);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_setObservationMask(HelicopterObject* self, PyObject* args)
+{
+	if (!checkHelicopter(self) || !checkExports(self, "set observation mask")) return NULL;
+	PyObject* names = Py_None;
+	if (!PyArg_ParseTuple(args, "|O", &names)) return NULL;
+
+	// Names are checked here, so unknown names raise instead of exiting.
+	std::vector<std::string> vNames;
+	if (names != Py_None)
+	{
+		PyObject* seq = PySequence_Fast(names, "Observation names should be a sequence!");
+		if (!seq) return NULL;
+		const std::vector<std::string>& vGroups = self->HD->vObservationGroups;
+		for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq); i++)
+		{
+			const char* sName = PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(seq, i));
+			if (!sName) { Py_DECREF(seq); return NULL; }
+			if (std::find(vGroups.begin(), vGroups.end(), sName) == vGroups.end())
+			{
+				PyErr_Format(PyExc_KeyError, "Observation `%s` is not found!", sName);
+				Py_DECREF(seq);
+				return NULL;
+			}
+			vNames.push_back(sName);
+		}
+		Py_DECREF(seq);
+	}
+	self->HD->setObservationMask(vNames);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_setHistoryLength(HelicopterObject* self, PyObject* arg)
+{
+	if (!checkHelicopter(self) || !checkExports(self, "set history length")) return NULL;
+	long iLength = PyLong_AsLong(arg);
+	if (PyErr_Occurred()) return NULL;
+	if (iLength < 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "History length should not be negative!");
+		return NULL;
+	}
+	self->HD->setHistoryLength((int)iLength);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_getHistory(HelicopterObject* self, PyObject*)
+{
+	if (!checkHelicopter(self)) return NULL;
+	if (self->HD->iHistoryLength == 0) Py_RETURN_NONE;
+	Py_ssize_t iShape[2] = { self->HD->iHistoryLength, self->HD->getHistoryFrameSize() };
+	return newView((PyObject*)self, &self->iExports, (float*)self->HD->getHistory(), 2, iShape, true);
+}
+
+static PyObject* Helicopter_getValueFromYamlNode(HelicopterObject* self, PyObject* args)
+{
+	if (!checkHelicopter(self)) return NULL;
+	const char *sNode, *sVariable;
+	if (!PyArg_ParseTuple(args, "ss", &sNode, &sVariable)) return NULL;
+	return PyFloat_FromDouble(self->HD->getValueFromYamlNode(sNode, sVariable));
+}
+
+static PyObject* Helicopter_setValueInYamlNode(HelicopterObject* self, PyObject* args)
+{
+	if (!checkHelicopter(self)) return NULL;
+	const char *sNode, *sVariable;
+	float fValue;
+	if (!PyArg_ParseTuple(args, "ssf", &sNode, &sVariable, &fValue)) return NULL;
+	setValueInYamlNode(self->HD, (char*)sNode, (char*)sVariable, &fValue);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_getParameterId(HelicopterObject* self, PyObject* args)
+{
+	if (!checkHelicopter(self)) return NULL;
+	const char *sNode, *sVariable;
+	if (!PyArg_ParseTuple(args, "ss", &sNode, &sVariable)) return NULL;
+	return PyLong_FromLong(self->HD->getParameterId(sNode, sVariable));
+}
+
+// Getting parameter ids from a sequence of integers.
+static bool getIds(PyObject* ids, std::vector<int>& vIds)
+{
+	PyObject* seq = PySequence_Fast(ids, "Parameter ids should be a sequence!");
+	if (!seq) return false;
+	vIds.resize((size_t)PySequence_Fast_GET_SIZE(seq));
+	for (size_t i = 0; i < vIds.size(); i++)
+	{
+		vIds[i] = (int)PyLong_AsLong(PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i));
+		if (PyErr_Occurred()) { Py_DECREF(seq); return false; }
+	}
+	Py_DECREF(seq);
+	return true;
+}
+
+static PyObject* Helicopter_setParameters(HelicopterObject* self, PyObject* args)
+{
+	if (!checkHelicopter(self)) return NULL;
+	PyObject *ids, *values;
+	if (!PyArg_ParseTuple(args, "OO", &ids, &values)) return NULL;
+	std::vector<int> vIds;
+	if (!getIds(ids, vIds)) return NULL;
+	Py_buffer view;
+	if (!getFloatBuffer(values, &view, (Py_ssize_t)vIds.size(), "values")) return NULL;
+	self->HD->setParameters(vIds.data(), (const float*)view.buf, (int)vIds.size());
+	PyBuffer_Release(&view);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_saveState(HelicopterObject* self, PyObject*)
+{
+	if (!checkHelicopter(self)) return NULL;
+	PyObject* buffer = PyByteArray_FromStringAndSize(NULL, self->HD->getStateSize());
+	if (buffer) self->HD->saveState(PyByteArray_AS_STRING(buffer));
+	return buffer;
+}
+
+static PyObject* Helicopter_loadState(HelicopterObject* self, PyObject* buffer)
+{
+	if (!checkHelicopter(self)) return NULL;
+	Py_buffer view;
+	if (PyObject_GetBuffer(buffer, &view, PyBUF_C_CONTIGUOUS) != 0) return NULL;
+	if (view.len != self->HD->getStateSize())
+	{
+		PyErr_Format(PyExc_ValueError, "State buffer should have %d bytes!", self->HD->getStateSize());
+		PyBuffer_Release(&view);
+		return NULL;
+	}
+	self->HD->loadState((const char*)view.buf);
+	PyBuffer_Release(&view);
+	Py_RETURN_NONE;
+}
+
+static PyObject* Helicopter_clone(HelicopterObject* self, PyObject*)
+{
+	if (!checkHelicopter(self)) return NULL;
+	HelicopterObject* heli = (HelicopterObject*)Helicopter_new(&HelicopterType, NULL, NULL);
+	if (heli) heli->HD = (HelicopterDynamics*)self->HD->clone();
+	return (PyObject*)heli;
+}
+
+#define DYNAG_VIEW_METHODS(NAME, VS) \
+	{ "getAll" #NAME, (PyCFunction)Helicopter_getAll<&DynamicSystem::VS, false>, METH_NOARGS, "Getting view of all values." }, \
+	{ "getAllNormalized" #NAME, (PyCFunction)Helicopter_getAll<&DynamicSystem::VS, true>, METH_NOARGS, "Getting view of all normalized values." }, \
+	{ "get" #NAME, (PyCFunction)Helicopter_get<&DynamicSystem::VS, false>, METH_O, "Getting view of values w.r.t name." }, \
+	{ "getNormalized" #NAME, (PyCFunction)Helicopter_get<&DynamicSystem::VS, true>, METH_O, "Getting view of normalized values w.r.t name." },
+
+static PyMethodDef HelicopterMethods[] = {
+	{ "close", (PyCFunction)Helicopter_close, METH_NOARGS, "Releasing dynamics into pool or destroying it." },
+	{ "step", (PyCFunction)Helicopter_step, METH_O, "Stepping dynamics with float32 action buffer without GIL." },
+	{ "reset", (PyCFunction)Helicopter_reset, METH_NOARGS, "Resetting and trimming dynamics without GIL." },
+	DYNAG_VIEW_METHODS(Observation, vsObservation)
+	DYNAG_VIEW_METHODS(State, vsState)
+	DYNAG_VIEW_METHODS(StateDot, vsStateDot)
+	DYNAG_VIEW_METHODS(Action, vsAction)
+	{ "getNumberOfObservations", (PyCFunction)Helicopter_getNumberOfObservations, METH_NOARGS, "Getting number of observations." },
+	{ "getStatus", (PyCFunction)Helicopter_getStatus, METH_NOARGS, "Getting status and index of failed state." },
+	{ "getStatusMessage", (PyCFunction)Helicopter_getStatusMessage, METH_NOARGS, "Getting status message." },
+	{ "setSeed", (PyCFunction)Helicopter_setSeed, METH_O, "Setting seed of random generators." },
+	{ "setFastMath", (PyCFunction)Helicopter_setFastMath, METH_O, "Selecting fast math kernels." },
+	{ "setFastSubsteps", (PyCFunction)Helicopter_setFastSubsteps, METH_O, "Setting sub-steps of fast states." },
+	{ "setObservationMask", (PyCFunction)Helicopter_setObservationMask, METH_VARARGS, "Setting observed groups, None observes all." },
+	{ "setHistoryLength", (PyCFunction)Helicopter_setHistoryLength, METH_O, "Setting frames of history, zero disables it." },
+	{ "getHistory", (PyCFunction)Helicopter_getHistory, METH_NOARGS, "Getting view of history which is valid until the next step." },
+	{ "getValueFromYamlNode", (PyCFunction)Helicopter_getValueFromYamlNode, METH_VARARGS, "Getting value of yaml node." },
+	{ "setValueInYamlNode", (PyCFunction)Helicopter_setValueInYamlNode, METH_VARARGS, "Setting value in yaml node." },
+	{ "getParameterId", (PyCFunction)Helicopter_getParameterId, METH_VARARGS, "Getting compiled parameter id." },
+	{ "setParameters", (PyCFunction)Helicopter_setParameters, METH_VARARGS, "Setting compiled parameters with float32 values." },
+	{ "saveState", (PyCFunction)Helicopter_saveState, METH_NOARGS, "Saving state snapshot into bytearray." },
+	{ "loadState", (PyCFunction)Helicopter_loadState, METH_O, "Loading state snapshot from buffer." },
+	{ "clone", (PyCFunction)Helicopter_clone, METH_NOARGS, "Cloning helicopter with its parameters." },
+	{ NULL }
+};
+
+#undef DYNAG_VIEW_METHODS
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Batch functions
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Getting dynamics of a sequence of helicopters.
+static bool getHelicopters(PyObject* helicopters, std::vector<HelicopterDynamics*>& vHelicopters)
+{
+	PyObject* seq = PySequence_Fast(helicopters, "Helicopters should be a sequence!");
+	if (!seq) return false;
+	vHelicopters.resize((size_t)PySequence_Fast_GET_SIZE(seq));
+	for (size_t i = 0; i < vHelicopters.size(); i++)
+	{
+		PyObject* heli = PySequence_Fast_GET_ITEM(seq, (Py_ssize_t)i);
+		if (!PyObject_TypeCheck(heli, &HelicopterType) || !checkHelicopter((HelicopterObject*)heli))
+		{
+			if (!PyErr_Occurred()) PyErr_SetString(PyExc_TypeError, "Helicopters should be `Helicopter` objects!");
+			Py_DECREF(seq);
+			return false;
+		}
+		vHelicopters[i] = ((HelicopterObject*)heli)->HD;
+	}
+	Py_DECREF(seq);
+	return true;
+}
+
+static PyObject* stepBatch(PyObject*, PyObject* args)
+{
+	PyObject *helicopters, *actions;
+	if (!PyArg_ParseTuple(args, "OO", &helicopters, &actions)) return NULL;
+	std::vector<HelicopterDynamics*> vHelicopters;
+	if (!getHelicopters(helicopters, vHelicopters)) return NULL;
+	if (vHelicopters.empty()) Py_RETURN_NONE;
+
+	const Py_ssize_t iActionSize = (Py_ssize_t)vHelicopters[0]->vsAction.vValues.size();
+	Py_buffer view;
+	if (!getFloatBuffer(actions, &view, (Py_ssize_t)vHelicopters.size() * iActionSize, "actions")) return NULL;
+	Py_BEGIN_ALLOW_THREADS
+	for (size_t i = 0; i < vHelicopters.size(); i++)
+		stepDynamics(vHelicopters[i], (float*)view.buf + i * iActionSize);
+	Py_END_ALLOW_THREADS
+	PyBuffer_Release(&view);
+	Py_RETURN_NONE;
+}
+
+static PyObject* resetBatch(PyObject*, PyObject* helicopters)
+{
+	std::vector<HelicopterDynamics*> vHelicopters;
+	if (!getHelicopters(helicopters, vHelicopters)) return NULL;
+	Py_BEGIN_ALLOW_THREADS
+	for (HelicopterDynamics* HD : vHelicopters) HD->reset();
+	Py_END_ALLOW_THREADS
+	Py_RETURN_NONE;
+}
+
+static PyObject* getObservationBatch(PyObject*, PyObject* args, PyObject* kwargs)
+{
+	static const char* sKeywords[] = { "helicopters", "out", "normalized", NULL };
+	PyObject *helicopters, *out = Py_None;
+	int iNormalized = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Op", (char**)sKeywords, &helicopters, &out, &iNormalized)) return NULL;
+	std::vector<HelicopterDynamics*> vHelicopters;
+	if (!getHelicopters(helicopters, vHelicopters)) return NULL;
+
+	const Py_ssize_t iSize = vHelicopters.empty() ? 0 : (Py_ssize_t)vHelicopters[0]->vsObservation.vValues.size();
+	for (HelicopterDynamics* HD : vHelicopters)
+		if ((Py_ssize_t)HD->vsObservation.vValues.size() != iSize)
+		{
+			PyErr_SetString(PyExc_ValueError, "Helicopters of batch should have the same number of observations!");
+			return NULL;
+		}
+
+	Py_ssize_t iShape[2] = { (Py_ssize_t)vHelicopters.size(), iSize };
+	Py_buffer view;
+	float* pOut = NULL;
+	PyObject* result = getOutput(out, 2, iShape, &view, &pOut);
+	if (!result) return NULL;
+	for (size_t i = 0; i < vHelicopters.size(); i++)
+	{
+		const VectorSpace& vs = vHelicopters[i]->vsObservation;
+		std::memcpy(pOut + i * iSize, iNormalized ? vs.vNormalizedValues.data() : vs.vValues.data(), iSize * sizeof(float));
+	}
+	if (view.obj) PyBuffer_Release(&view);
+	return result;
+}
+
+static PyObject* getHistoryBatchNative(PyObject*, PyObject* args, PyObject* kwargs)
+{
+	static const char* sKeywords[] = { "helicopters", "out", NULL };
+	PyObject *helicopters, *out = Py_None;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", (char**)sKeywords, &helicopters, &out)) return NULL;
+	std::vector<HelicopterDynamics*> vHelicopters;
+	if (!getHelicopters(helicopters, vHelicopters)) return NULL;
+
+	const int iLength = vHelicopters.empty() ? 0 : vHelicopters[0]->iHistoryLength;
+	const int iFrameSize = vHelicopters.empty() ? 0 : vHelicopters[0]->getHistoryFrameSize();
+	for (HelicopterDynamics* HD : vHelicopters)
+		if (HD->iHistoryLength != iLength || HD->getHistoryFrameSize() != iFrameSize)
+		{
+			PyErr_SetString(PyExc_ValueError, "Helicopters of batch should have the same history length and frame size!");
+			return NULL;
+		}
+
+	Py_ssize_t iShape[3] = { (Py_ssize_t)vHelicopters.size(), iLength, iFrameSize };
+	Py_buffer view;
+	float* pOut = NULL;
+	PyObject* result = getOutput(out, 3, iShape, &view, &pOut);
+	if (!result) return NULL;
+	const size_t iCount = (size_t)iLength * iFrameSize;
+	for (size_t i = 0; i < vHelicopters.size(); i++)
+		if (iCount > 0) std::memcpy(pOut + i * iCount, vHelicopters[i]->getHistory(), iCount * sizeof(float));
+	if (view.obj) PyBuffer_Release(&view);
+	return result;
+}
+
+static PyObject* getAttitudeBatchNative(PyObject*, PyObject* args, PyObject* kwargs)
+{
+	static const char* sKeywords[] = { "helicopters", "euler", "dcm", NULL };
+	PyObject *helicopters, *euler = Py_None, *dcm = Py_None;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OO", (char**)sKeywords, &helicopters, &euler, &dcm)) return NULL;
+	std::vector<HelicopterDynamics*> vHelicopters;
+	if (!getHelicopters(helicopters, vHelicopters)) return NULL;
+
+	// Outputs are (components, n) as in `getAttitudeBatch` of C API.
+	Py_ssize_t iEulerShape[2] = { 3, (Py_ssize_t)vHelicopters.size() };
+	Py_ssize_t iDcmShape[2] = { 9, (Py_ssize_t)vHelicopters.size() };
+	Py_buffer eulerView, dcmView;
+	float *pEuler = NULL, *pDcm = NULL;
+	PyObject* eulerResult = getOutput(euler, 2, iEulerShape, &eulerView, &pEuler);
+	if (!eulerResult) return NULL;
+	PyObject* dcmResult = getOutput(dcm, 2, iDcmShape, &dcmView, &pDcm);
+	if (!dcmResult)
+	{
+		if (eulerView.obj) PyBuffer_Release(&eulerView);
+		Py_DECREF(eulerResult);
+		return NULL;
+	}
+	std::vector<DynamicSystem*> vBatch(vHelicopters.begin(), vHelicopters.end());
+	getAttitudeBatch(vBatch.data(), (int)vBatch.size(), pEuler, pDcm);
+	if (eulerView.obj) PyBuffer_Release(&eulerView);
+	if (dcmView.obj) PyBuffer_Release(&dcmView);
+	return Py_BuildValue("(NN)", eulerResult, dcmResult);
+}
+
+static PyObject* setParametersBatchNative(PyObject*, PyObject* args)
+{
+	PyObject *helicopters, *ids, *values;
+	if (!PyArg_ParseTuple(args, "OOO", &helicopters, &ids, &values)) return NULL;
+	std::vector<HelicopterDynamics*> vHelicopters;
+	if (!getHelicopters(helicopters, vHelicopters)) return NULL;
+	std::vector<int> vIds;
+	if (!getIds(ids, vIds)) return NULL;
+
+	// Values are (parameters, helicopters) as in `setParametersBatch` of C API.
+	Py_buffer view;
+	if (!getFloatBuffer(values, &view, (Py_ssize_t)(vIds.size() * vHelicopters.size()), "values")) return NULL;
+	std::vector<DynamicSystem*> vBatch(vHelicopters.begin(), vHelicopters.end());
+	setParametersBatch(vBatch.data(), (int)vBatch.size(), vIds.data(), (int)vIds.size(), (float*)view.buf);
+	PyBuffer_Release(&view);
+	Py_RETURN_NONE;
+}
+
+static PyMethodDef ModuleMethods[] = {
+	{ "stepBatch", (PyCFunction)stepBatch, METH_VARARGS, "Stepping helicopters with (n, actions) float32 buffer without GIL." },
+	{ "resetBatch", (PyCFunction)resetBatch, METH_O, "Resetting helicopters without GIL." },
+	{ "getObservationBatch", (PyCFunction)(void(*)(void))getObservationBatch, METH_VARARGS | METH_KEYWORDS,
+		"Copying observations of helicopters into (n, observations) buffer." },
+	{ "getHistoryBatch", (PyCFunction)(void(*)(void))getHistoryBatchNative, METH_VARARGS | METH_KEYWORDS,
+		"Copying histories of helicopters into (n, length, frame size) buffer." },
+	{ "getAttitudeBatch", (PyCFunction)(void(*)(void))getAttitudeBatchNative, METH_VARARGS | METH_KEYWORDS,
+		"Calculating Euler angles and DCMs of helicopters into (3, n) and (9, n) buffers." },
+	{ "setParametersBatch", (PyCFunction)setParametersBatchNative, METH_VARARGS,
+		"Setting compiled parameters of helicopters with (parameters, n) float32 buffer." },
+	{ NULL }
+};
+
+static PyModuleDef NativeModule = {
+	PyModuleDef_HEAD_INIT, "dynamicsNative", "Native Python module of DynaG dynamics.", -1, ModuleMethods
+};
+
+PyMODINIT_FUNC PyInit_dynamicsNative(void)
+{
+	BufferType.tp_name = "dynamicsNative.Buffer";
+	BufferType.tp_doc = "Float32 buffer which supports buffer protocol and DLPack.";
+	BufferType.tp_basicsize = sizeof(BufferObject);
+	BufferType.tp_flags = Py_TPFLAGS_DEFAULT;
+	BufferType.tp_dealloc = (destructor)Buffer_dealloc;
+	BufferType.tp_as_buffer = &BufferProcs;
+	BufferType.tp_methods = BufferMethods;
+	BufferType.tp_getset = BufferGetSet;
+
+	HelicopterType.tp_name = "dynamicsNative.Helicopter";
+	HelicopterType.tp_doc = "Helicopter(yaml_path, dt, pooled=False) : helicopter dynamics.";
+	HelicopterType.tp_basicsize = sizeof(HelicopterObject);
+	HelicopterType.tp_flags = Py_TPFLAGS_DEFAULT;
+	HelicopterType.tp_new = Helicopter_new;
+	HelicopterType.tp_init = (initproc)Helicopter_init;
+	HelicopterType.tp_dealloc = (destructor)Helicopter_dealloc;
+	HelicopterType.tp_methods = HelicopterMethods;
+
+	if (PyType_Ready(&BufferType) < 0 || PyType_Ready(&HelicopterType) < 0) return NULL;
+
+	PyObject* module = PyModule_Create(&NativeModule);
+	if (!module) return NULL;
+	Py_INCREF(&BufferType);
+	Py_INCREF(&HelicopterType);
+	if (PyModule_AddObject(module, "Buffer", (PyObject*)&BufferType) < 0 ||
+		PyModule_AddObject(module, "Helicopter", (PyObject*)&HelicopterType) < 0)
+	{
+		Py_DECREF(module);
+		return NULL;
+	}
+	return module;
+}
@@ -0,0 +1,156 @@
+#include "async_batch.h"
+
+AsyncBatch::AsyncBatch(const std::vector<DynamicSystem*>& vSystems, int iWorkers, ResetPool* pool)
+	: vSystems(vSystems), pool(pool), iActionSize(0), iObservationSize(0)
+{
+	try
+	{
+		if (vSystems.empty())
+			gThrow("Async Batch Error : Batch should have at least one system!");
+		iActionSize = vSystems[0]->vsAction.vValues.size();
+		iObservationSize = vSystems[0]->vsObservation.vValues.size();
+		for (DynamicSystem* DS : vSystems)
+		{
+			if (DS->vsAction.vValues.size() != iActionSize || DS->vsObservation.vValues.size() != iObservationSize)
+				gThrow("Async Batch Error : Systems of batch should have same action and observation sizes!");
+		}
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	vActions.resize(vSystems.size() * iActionSize);
+	vFinalObservations.resize(vSystems.size() * iObservationSize);
+	vDones.resize(vSystems.size(), 0);
+	vInFlight.resize(vSystems.size(), 0);
+
+	for (int i = 0; i < std::max(iWorkers, 1); i++) vWorkers.emplace_back(&AsyncBatch::work, this);
+}
+
+AsyncBatch::~AsyncBatch()
+{
+	{
+		std::lock_guard<std::mutex> lock(mtxBatch);
+		bStop = true;
+	}
+	cvTask.notify_all();
+	for (std::thread& worker : vWorkers) worker.join();
+}
+
+void AsyncBatch::send(const int* iEnvIds, const float* fActions, int n)
+{
+	{
+		std::lock_guard<std::mutex> lock(mtxBatch);
+		try
+		{
+			for (int i = 0; i < n; i++)
+			{
+				const int k = iEnvIds[i];
+				if (k < 0 || k >= (int)vSystems.size())
+					gThrow("Async Batch Error : System `" + std::to_string(k) + "` is not in batch!");
+				if (vInFlight[k])
+					gThrow("Async Batch Error : System `" + std::to_string(k) + "` is sent before it is received!");
+				vInFlight[k] = 1;
+			}
+		}
+		catch (std::exception& e) {
+			std::cerr << e.what() << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+
+		for (int i = 0; i < n; i++)
+		{
+			const int k = iEnvIds[i];
+			std::memcpy(vActions.data() + k * iActionSize, fActions + i * iActionSize, iActionSize * sizeof(float));
+			dqTasks.push_back(k);
+		}
+		iInFlight += n;
+	}
+	cvTask.notify_all();
+}
+
+int AsyncBatch::recv(int iMinCount, int iMaxCount, int* iEnvIds, float* fObservations, int* iDones, float* fFinalObservations)
+{
+	std::vector<int> vReceived;
+	{
+		std::unique_lock<std::mutex> lock(mtxBatch);
+		try
+		{
+			if (iMaxCount < iMinCount)
+				gThrow("Async Batch Error : Maximum count `" + std::to_string(iMaxCount) + "` is less than minimum count `" +
+					std::to_string(iMinCount) + "`!");
+			if (iMinCount > iInFlight)
+				gThrow("Async Batch Error : Minimum count `" + std::to_string(iMinCount) + "` is more than `" +
+					std::to_string(iInFlight) + "` systems in flight!");
+		}
+		catch (std::exception& e) {
+			std::cerr << e.what() << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+
+		cvResult.wait(lock, [this, iMinCount] { return (int)dqResults.size() >= iMinCount; });
+		const int n = std::min((int)dqResults.size(), iMaxCount);
+		for (int i = 0; i < n; i++)
+		{
+			const int k = dqResults.front();
+			dqResults.pop_front();
+			vReceived.push_back(k);
+			iDones[i] = vDones[k];
+		}
+	}
+
+	// Received systems are not in flight for workers anymore, so they are copied unlocked.
+	for (int i = 0; i < (int)vReceived.size(); i++)
+	{
+		const int k = vReceived[i];
+		iEnvIds[i] = k;
+		std::memcpy(fObservations + i * iObservationSize, vSystems[k]->vsObservation.vNormalizedValues.data(), iObservationSize * sizeof(float));
+		if (iDones[i] && fFinalObservations)
+			std::memcpy(fFinalObservations + i * iObservationSize, vFinalObservations.data() + k * iObservationSize, iObservationSize * sizeof(float));
+	}
+
+	std::lock_guard<std::mutex> lock(mtxBatch);
+	for (int k : vReceived) vInFlight[k] = 0;
+	iInFlight -= (int)vReceived.size();
+	return (int)vReceived.size();
+}
+
+int AsyncBatch::getInFlight()
+{
+	std::lock_guard<std::mutex> lock(mtxBatch);
+	return iInFlight;
+}
+
+void AsyncBatch::work()
+{
+	while (true)
+	{
+		int k;
+		{
+			std::unique_lock<std::mutex> lock(mtxBatch);
+			cvTask.wait(lock, [this] { return bStop || !dqTasks.empty(); });
+			if (bStop) return;
+			k = dqTasks.front();
+			dqTasks.pop_front();
+		}
+
+		DynamicSystem* DS = vSystems[k];
+		DS->vsAction.setValues(vActions.data() + k * iActionSize);
+		DS->step();
+
+		const bool bDone = DS->iStatus != STATUS_OK;
+		if (bDone)
+		{
+			std::memcpy(vFinalObservations.data() + k * iObservationSize, DS->vsObservation.vNormalizedValues.data(), iObservationSize * sizeof(float));
+			if (pool) pool->reset(DS);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mtxBatch);
+			vDones[k] = bDone ? 1 : 0;
+			dqResults.push_back(k);
+		}
+		cvResult.notify_one();
+	}
+}
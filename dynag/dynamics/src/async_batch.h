@@ -0,0 +1,71 @@
+/*
+* DynaG Dynamics C++ / Async Batch
+*
+* Async Batch steps a batch of dynamic systems with background workers while the caller
+* does something else such as policy inference. Actions of some systems are sent and
+* the call returns immediately. Workers step them in sending order and the caller
+* receives whichever systems finish first. A system is in flight from its send until it
+* is received, and it should not be sent or used while it is in flight.
+*
+* If a reset pool is given, workers reset failed systems from it after their step, so
+* received observations of them are initial observations and their last observations are
+* received separately as final observations. A failed step does not calculate observations,
+* so last observations are the ones of the step before it.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Storing sizes as Eigen index and correcting final observation docs. // @MGokcayK
+*/
+
+#pragma once
+
+#include "reset_pool.h"
+
+class AsyncBatch
+{
+public:
+	// Creating batch of `vSystems` which are stepped by `iWorkers` workers. Systems should
+	// have same action and observation sizes. `pool` can be null to not reset failed systems.
+	AsyncBatch(const std::vector<DynamicSystem*>& vSystems, int iWorkers, ResetPool* pool);
+
+	// Stopping workers. Systems which are being stepped finish their step.
+	~AsyncBatch();
+
+	AsyncBatch(const AsyncBatch&) = delete;
+	void operator=(const AsyncBatch&) = delete;
+
+	// Sending actions of `n` systems `iEnvIds` which has shape of (n, action size) to workers.
+	void send(const int* iEnvIds, const float* fActions, int n);
+
+	// Receiving at least `iMinCount` and at most `iMaxCount` stepped systems in finishing
+	// order. It waits until `iMinCount` systems finish and returns number of received systems.
+	// Rows of outputs are filled in receiving order. `fObservations` and `fFinalObservations`
+	// have normalized observations and row of final observations is written for done systems
+	// with their last observations before failure.
+	int recv(int iMinCount, int iMaxCount, int* iEnvIds, float* fObservations, int* iDones, float* fFinalObservations);
+
+	// Getting number of systems which are sent and not received.
+	int getInFlight();
+
+private:
+	std::vector<DynamicSystem*> vSystems;
+	ResetPool* pool;
+	Eigen::Index iActionSize, iObservationSize;
+
+	// Rows of systems. Row of a system is only used by its worker while it is in flight.
+	std::vector<float> vActions, vFinalObservations;
+	std::vector<char> vDones, vInFlight;
+
+	std::mutex mtxBatch;
+	std::condition_variable cvTask, cvResult;
+	std::deque<int> dqTasks, dqResults;
+	int iInFlight = 0;
+	bool bStop = false;
+
+	std::vector<std::thread> vWorkers;
+
+	// Loop of a worker which steps sent systems until it is stopped.
+	void work();
+};
@@ -5,9 +5,70 @@ HelicopterDynamics* createHelicopterDynamics(char* yaml_path, float* dt)
 	return new HelicopterDynamics(yaml_path, dt);
 }
 
-bool ready()
+HelicopterDynamics* cloneHelicopterDynamics(HelicopterDynamics* HD)
 {
-	return READY;
+	return new HelicopterDynamics(HD->shareParams(), &HD->fDt);
+}
+
+HelicopterDynamics* acquireHelicopterDynamics(char* yaml_path, float* dt)
+{
+	return HelicopterPool::instance().acquire(yaml_path, dt);
+}
+
+void releaseHelicopterDynamics(HelicopterDynamics* HD)
+{
+	HelicopterPool::instance().release(HD);
+}
+
+void setHelicopterPoolCapacity(int capacity)
+{
+	HelicopterPool::instance().setCapacity(capacity);
+}
+
+void clearHelicopterPool()
+{
+	HelicopterPool::instance().clear();
+}
+
+void destroyDynamicSystem(DynamicSystem* DS)
+{
+	delete DS;
+}
+
+bool ready(DynamicSystem* DS)
+{
+	return DS->iStatus == STATUS_OK;
+}
+
+int getStatus(DynamicSystem* DS, int* state_index)
+{
+	*state_index = DS->iStatusIndex;
+	return DS->iStatus;
+}
+
+const char* getStatusMessage(DynamicSystem* DS)
+{
+	return DS->sStatusMessage.c_str();
+}
+
+int getProfile(DynamicSystem* DS, const char** names, double* values)
+{
+#if DYNAG_PROFILE
+	for (int i = 0; i < SECTION_COUNT; i++)
+	{
+		if (names) names[i] = DynamicsProfile::getSectionName(i);
+		if (values) values[i] = (double)DS->profile.iTicks[i];
+	}
+	return SECTION_COUNT;
+#else
+	(void)DS; (void)names; (void)values;
+	return 0;
+#endif
+}
+
+void resetProfile(DynamicSystem* DS)
+{
+	DS->profile.reset();
 }
 
 float* getAllAction(DynamicSystem* DS, int* size_s)
@@ -114,7 +175,27 @@ float getValueFromYamlNode(DynamicSystem* DS, char* node_name, char* var_name)
 void setValueInYamlNode(DynamicSystem* DS, char* node_name, char* var_name, float* value)
 {
 	DS->setValueInYamlNode(node_name, var_name, *value);
-	DS->preCalculations();
+}
+
+int getParameterId(DynamicSystem* DS, char* node_name, char* var_name)
+{
+	return DS->getParameterId(node_name, var_name);
+}
+
+void setParameters(DynamicSystem* DS, int* ids, float* values, int n)
+{
+	DS->setParameters(ids, values, n);
+}
+
+void setParametersBatch(DynamicSystem** batch, int n_envs, int* ids, int n_params, float* values)
+{
+	std::vector<float> vValues(n_params);
+	for (int k = 0; k < n_envs; k++)
+	{
+		for (int p = 0; p < n_params; p++)
+			vValues[p] = values[p * n_envs + k];
+		batch[k]->setParameters(ids, vValues.data(), n_params);
+	}
 }
 
 void step(DynamicSystem* DS, float* action)
@@ -133,3 +214,181 @@ int getNumberOfObservations(DynamicSystem* DS)
 {
 	return DS->getNumberOfObservations();
 }
+
+////////////////////////////////////////////////////////////////////////
+
+int getStateSize(DynamicSystem* DS)
+{
+	return DS->getStateSize();
+}
+
+void saveState(DynamicSystem* DS, char* buffer)
+{
+	DS->saveState(buffer);
+}
+
+void loadState(DynamicSystem* DS, char* buffer)
+{
+	DS->loadState(buffer);
+}
+
+void forkDynamicSystem(DynamicSystem* DS, int n, DynamicSystem** forks)
+{
+	for (int i = 0; i < n; i++)
+		forks[i] = DS->clone();
+}
+
+void setSeed(DynamicSystem* DS, unsigned int seed)
+{
+	DS->setSeed(seed);
+}
+
+void setTurbulenceFieldOrigin(HelicopterDynamics* HD, float* origin)
+{
+	HD->setTurbulenceFieldOrigin(origin);
+}
+
+void setFastMath(HelicopterDynamics* HD, bool enable)
+{
+	HD->bFastMath = enable;
+}
+
+void setFastSubsteps(DynamicSystem* DS, int substeps)
+{
+	DS->setFastSubsteps(substeps);
+}
+
+void setObservationMask(DynamicSystem* DS, char** names, int n)
+{
+	DS->setObservationMask(std::vector<std::string>(names, names + n));
+}
+
+void setHistoryLength(DynamicSystem* DS, int length)
+{
+	DS->setHistoryLength(length);
+}
+
+const float* getHistory(DynamicSystem* DS, int* length, int* frame_size)
+{
+	*length = DS->iHistoryLength;
+	*frame_size = DS->getHistoryFrameSize();
+	return (DS->iHistoryLength > 0) ? DS->getHistory() : nullptr;
+}
+
+void getHistoryBatch(DynamicSystem** batch, int n_envs, float* out)
+{
+	if (n_envs <= 0) return;
+	const int iValues = batch[0]->iHistoryLength * batch[0]->getHistoryFrameSize();
+	try
+	{
+		for (int k = 0; k < n_envs; k++)
+			if (batch[k]->iHistoryLength != batch[0]->iHistoryLength || batch[k]->getHistoryFrameSize() != batch[0]->getHistoryFrameSize())
+				gThrow("Size Error : Histories of batch should have same length and frame size!");
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+	if (iValues <= 0) return;
+	for (int k = 0; k < n_envs; k++)
+		std::memcpy(out + (size_t)k * iValues, batch[k]->getHistory(), iValues * sizeof(float));
+}
+
+ResetPool* createResetPool(DynamicSystem* DS, int capacity, int workers, unsigned int seed, 
+	int* ids, int* distributions, float* a, float* b, float* low, float* high, int n_params)
+{
+	std::vector<ResetPool::RandomParameter> vParameters(std::max(n_params, 0));
+	for (int p = 0; p < n_params; p++)
+		vParameters[p] = { ids[p], distributions[p], a[p], b[p], low[p], high[p] };
+	return new ResetPool(DS, vParameters, capacity, workers, seed);
+}
+
+void destroyResetPool(ResetPool* pool)
+{
+	delete pool;
+}
+
+void resetFromPool(ResetPool* pool, DynamicSystem* DS)
+{
+	pool->reset(DS);
+}
+
+int getResetPoolSize(ResetPool* pool)
+{
+	return pool->getSize();
+}
+
+int getResetPoolMisses(ResetPool* pool)
+{
+	return pool->getMisses();
+}
+
+void stepBatchAutoReset(ResetPool* pool, DynamicSystem** batch, int n_envs, float* actions, int* terminated, int* dones, float* final_observations)
+{
+	for (int k = 0; k < n_envs; k++)
+	{
+		DynamicSystem* DS = batch[k];
+		const size_t iActionSize = DS->vsAction.vValues.size(), iObservationSize = DS->vsObservation.vValues.size();
+		if (terminated && terminated[k] != 0)
+		{
+			dones[k] = 1;
+		}
+		else
+		{
+			DS->vsAction.setValues(actions + k * iActionSize);
+			DS->step();
+			dones[k] = (DS->iStatus != STATUS_OK) ? 1 : 0;
+		}
+		if (dones[k] == 0) continue;
+		std::memcpy(final_observations + k * iObservationSize, DS->vsObservation.vNormalizedValues.data(), iObservationSize * sizeof(float));
+		pool->reset(DS);
+	}
+}
+
+void getAttitudeBatch(DynamicSystem** batch, int n_envs, float* euler, float* dcm)
+{
+	if (n_envs <= 0) return;
+	// Quaternions are gathered as structure of arrays for batched kernels.
+	std::vector<float> vQuat(4 * (size_t)n_envs);
+	try
+	{
+		for (int k = 0; k < n_envs; k++)
+		{
+			auto ind = batch[k]->vsState.mapInfo.find("quat");
+			if (ind == batch[k]->vsState.mapInfo.end() || ind->second.size != 4)
+				gThrow("Not Found : Quaternion state named as 'quat' is not registered in system `" + std::to_string(k) + "` of batch!");
+			for (int c = 0; c < 4; c++) vQuat[c * n_envs + k] = batch[k]->vsState.vValues[ind->second.index + c];
+		}
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+	if (euler) unitQuaternion2Euler(euler, vQuat.data(), n_envs);
+	if (dcm) quaternion2DCM(dcm, vQuat.data(), n_envs);
+}
+
+AsyncBatch* createAsyncBatch(DynamicSystem** batch, int n_envs, int workers, ResetPool* pool)
+{
+	return new AsyncBatch(std::vector<DynamicSystem*>(batch, batch + std::max(n_envs, 0)), workers, pool);
+}
+
+void destroyAsyncBatch(AsyncBatch* async_batch)
+{
+	delete async_batch;
+}
+
+void sendActions(AsyncBatch* async_batch, int* env_ids, float* actions, int n)
+{
+	async_batch->send(env_ids, actions, n);
+}
+
+int recvResults(AsyncBatch* async_batch, int min_count, int max_count, int* env_ids, float* observations, int* dones, float* final_observations)
+{
+	return async_batch->recv(min_count, max_count, env_ids, observations, dones, final_observations);
+}
+
+int getAsyncBatchInFlight(AsyncBatch* async_batch)
+{
+	return async_batch->getInFlight();
+}
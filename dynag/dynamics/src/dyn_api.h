@@ -10,6 +10,22 @@
 * Update : 21/09/2021 - Initialization & Implementation // @MGokcayK
 * Update : 06/11/2021 - Adding new methods for api. // @MGokcayK
 * Update : 22/12/2021 - Adding getAllStates and getAllStateDots methods. // @MGokcayK
+* Update : 19/10/2026 - Adding state snapshot, fork and seed methods. // @MGokcayK
+* Update : 19/10/2026 - Adding cloneHelicopterDynamics method. // @MGokcayK
+* Update : 19/10/2026 - Adding destroy and pooled instance methods. // @MGokcayK
+* Update : 19/10/2026 - Adding compiled parameter methods. // @MGokcayK
+* Update : 19/10/2026 - Adding setParametersBatch method. // @MGokcayK
+* Update : 19/10/2026 - Adding getStatus and getStatusMessage methods. // @MGokcayK
+* Update : 19/10/2026 - Adding getProfile and resetProfile methods. // @MGokcayK
+* Update : 19/10/2026 - Adding setTurbulenceFieldOrigin method. // @MGokcayK
+* Update : 19/10/2026 - Adding setFastMath method. // @MGokcayK
+* Update : 19/10/2026 - Adding setFastSubsteps method. // @MGokcayK
+* Update : 19/10/2026 - Adding setObservationMask method. // @MGokcayK
+* Update : 19/10/2026 - Adding observation history methods. // @MGokcayK
+* Update : 19/10/2026 - Adding reset pool and auto-reset batch step methods. // @MGokcayK
+* Update : 19/10/2026 - Adding asynchronous send and receive step methods. // @MGokcayK
+* Update : 19/10/2026 - Taking instance in ready method instead of global flag. // @MGokcayK
+* Update : 19/10/2026 - Adding getAttitudeBatch method with batched kinematics. // @MGokcayK
 */
 
 #pragma once
@@ -23,15 +39,52 @@
 	#define DYNAMICS_API 
 #endif
 
-#include "helicopter/helicopter_dynamics.h"
+#include "helicopter/helicopter_pool.h"
+#include "reset_pool.h"
+#include "async_batch.h"
 
 // DYNAMICS API for creating shared libraries to call methods from Python.
 
 // Creating Helicopter Dynamics.
 extern "C" DYNAMICS_API HelicopterDynamics* createHelicopterDynamics(char* yaml_path, float* dt);
 
-// return is system is ready to simulation
-extern "C" DYNAMICS_API bool ready(); 
+// Creating Helicopter Dynamics which shares parameters and terrain of `HD`. State of the 
+// new system is initial state as in `createHelicopterDynamics`.
+extern "C" DYNAMICS_API HelicopterDynamics* cloneHelicopterDynamics(HelicopterDynamics* HD);
+
+// Getting Helicopter Dynamics from pool. Released instance of the same yaml file is 
+// re-initialized in place if it exists, otherwise new instance is created.
+extern "C" DYNAMICS_API HelicopterDynamics* acquireHelicopterDynamics(char* yaml_path, float* dt);
+
+// Releasing Helicopter Dynamics into pool to be recycled. `HD` should not be used after it.
+extern "C" DYNAMICS_API void releaseHelicopterDynamics(HelicopterDynamics* HD);
+
+// Setting maximum number of released instances which are kept for each yaml file.
+extern "C" DYNAMICS_API void setHelicopterPoolCapacity(int capacity);
+
+// Deleting all released instances in pool.
+extern "C" DYNAMICS_API void clearHelicopterPool();
+
+// Destroying Dynamic System. `DS` should not be used after it.
+extern "C" DYNAMICS_API void destroyDynamicSystem(DynamicSystem* DS);
+
+// Return if Dynamic System is ready to simulation, i.e. its status is `STATUS_OK`.
+extern "C" DYNAMICS_API bool ready(DynamicSystem* DS);
+
+// Get status code of Dynamic System which is `DynamicSystemStatus`. Index of diverged state is
+// written into `state_index`, it is -1 if status is ok.
+extern "C" DYNAMICS_API int getStatus(DynamicSystem* DS, int* state_index);
+
+// Get status message of Dynamic System which explains the diverged state and the reason.
+extern "C" DYNAMICS_API const char* getStatusMessage(DynamicSystem* DS);
+
+// Get profiling counters of Dynamic System. Section names are written into `names` and 
+// accumulated timestamp counter ticks into `values` if they are not null. It returns the
+// number of sections, which is zero if library is built without `DYNAG_PROFILE`.
+extern "C" DYNAMICS_API int getProfile(DynamicSystem* DS, const char** names, double* values);
+
+// Reset profiling counters of Dynamic System.
+extern "C" DYNAMICS_API void resetProfile(DynamicSystem* DS);
 
 // Get all action of Dynamic System
 extern "C" DYNAMICS_API float* getAllAction(DynamicSystem * DS, int* size_s);
@@ -90,6 +143,19 @@ extern "C" DYNAMICS_API float getValueFromYamlNode(DynamicSystem* DS, char* node
 // Setting value of yaml node from corresponding dynamics system w.r.t node name and variable name.
 extern "C" DYNAMICS_API void setValueInYamlNode(DynamicSystem * DS, char* node_name, char* var_name, float* value);
 
+// Getting id of compiled parameter w.r.t node name and variable name. It returns -1 if it is not compiled.
+extern "C" DYNAMICS_API int getParameterId(DynamicSystem* DS, char* node_name, char* var_name);
+
+// Setting `n` compiled parameters w.r.t their ids. Only derived parameters which depend on them are calculated.
+extern "C" DYNAMICS_API void setParameters(DynamicSystem* DS, int* ids, float* values, int n);
+
+// Setting `n_params` compiled parameters of `n_envs` Dynamic Systems in one call. Value of parameter 
+// `p` of env `k` is `values[p * n_envs + k]`. Each system keeps its own parameter block, so it is 
+// equal to calling `setParameters` for each system: its block is copied if it is shared, and its 
+// dependent derived parameters and pre-calculations are calculated one system at a time, not 
+// vectorized across systems.
+extern "C" DYNAMICS_API void setParametersBatch(DynamicSystem** batch, int n_envs, int* ids, int n_params, float* values);
+
 // Step Dynamic System
 extern "C" DYNAMICS_API void step(DynamicSystem * DS, float* action);
 
@@ -98,3 +164,100 @@ extern "C" DYNAMICS_API void reset(DynamicSystem* DS);
 
 // Get number of obs
 extern "C" DYNAMICS_API int getNumberOfObservations(DynamicSystem* DS);
+
+// Get size of state snapshot of Dynamic System in bytes.
+extern "C" DYNAMICS_API int getStateSize(DynamicSystem* DS);
+
+// Save state of Dynamic System into buffer which has `getStateSize` bytes.
+extern "C" DYNAMICS_API void saveState(DynamicSystem* DS, char* buffer);
+
+// Load state of Dynamic System from buffer which is filled by `saveState`.
+extern "C" DYNAMICS_API void loadState(DynamicSystem* DS, char* buffer);
+
+// Fork Dynamic System `n` times with its current state. Forks share immutable data.
+extern "C" DYNAMICS_API void forkDynamicSystem(DynamicSystem* DS, int n, DynamicSystem** forks);
+
+// Set seed of random number generator of Dynamic System.
+extern "C" DYNAMICS_API void setSeed(DynamicSystem* DS, unsigned int seed);
+
+// Set origin of turbulence field of Helicopter Dynamics. It is used only if `TURB_FIELD` is 1.
+extern "C" DYNAMICS_API void setTurbulenceFieldOrigin(HelicopterDynamics* HD, float* origin);
+
+// Set fast math kernels of Helicopter Dynamics. It has effect only if library is built with `DYNAG_FAST_MATH`.
+extern "C" DYNAMICS_API void setFastMath(HelicopterDynamics* HD, bool enable);
+
+// Set number of sub-steps of fast states in a step of Dynamic System. 1 integrates all states together.
+extern "C" DYNAMICS_API void setFastSubsteps(DynamicSystem* DS, int substeps);
+
+// Set observed groups of Dynamic System w.r.t their names. Unobserved groups are not calculated
+// and keep their registered values. `n` = 0 observes all groups.
+extern "C" DYNAMICS_API void setObservationMask(DynamicSystem* DS, char** names, int n);
+
+// Set number of frames in observation history of Dynamic System. A frame is normalized observation
+// followed by normalized action. 0 disables history.
+extern "C" DYNAMICS_API void setHistoryLength(DynamicSystem* DS, int length);
+
+// Get observation history of Dynamic System from oldest to newest frame as one contiguous array
+// without copying. Pointer is valid until the next step or reset. It returns null if history is disabled.
+extern "C" DYNAMICS_API const float* getHistory(DynamicSystem* DS, int* length, int* frame_size);
+
+// Copy observation histories of batch of Dynamic Systems into `out` which has shape of 
+// (n_envs, length, frame_size). All systems should have same history length and frame size.
+extern "C" DYNAMICS_API void getHistoryBatch(DynamicSystem** batch, int n_envs, float* out);
+
+// Creating Reset Pool of configuration of `DS` which keeps `capacity` pre-trimmed states ready with 
+// `workers` background threads. `n_params` compiled parameters are randomized for each state. Their 
+// `distributions` are 0 for uniform in [a, b) and 1 for normal with mean `a` and standard deviation 
+// `b`, and samples are clipped into [low, high].
+extern "C" DYNAMICS_API ResetPool* createResetPool(DynamicSystem* DS, int capacity, int workers, unsigned int seed, 
+	int* ids, int* distributions, float* a, float* b, float* low, float* high, int n_params);
+
+// Destroying Reset Pool. It waits for workers which are trimming.
+extern "C" DYNAMICS_API void destroyResetPool(ResetPool* pool);
+
+// Resetting Dynamic System with a pre-trimmed state of pool. It is reset in calling thread if pool is empty.
+extern "C" DYNAMICS_API void resetFromPool(ResetPool* pool, DynamicSystem* DS);
+
+// Getting number of ready states of pool.
+extern "C" DYNAMICS_API int getResetPoolSize(ResetPool* pool);
+
+// Getting number of resets which did not find a ready state in pool.
+extern "C" DYNAMICS_API int getResetPoolMisses(ResetPool* pool);
+
+// Stepping batch of Dynamic Systems with `actions` which has shape of (n_envs, action size). Failed 
+// systems are reset from `pool` in the same call. If `terminated` is not null, systems whose 
+// `terminated[k]` is not zero (e.g. their task is failed, successed or its time is up) are reset 
+// from `pool` instead of being stepped. `dones[k]` is 1 for reset systems and their last normalized 
+// observations are written into row `k` of `final_observations` which has shape of (n_envs, 
+// observation size). A failed step does not calculate observations, so observations of failed 
+// systems are the ones of the step before it. Other rows are not written.
+extern "C" DYNAMICS_API void stepBatchAutoReset(ResetPool* pool, DynamicSystem** batch, int n_envs, float* actions, 
+	int* terminated, int* dones, float* final_observations);
+
+// Calculating Euler angles and DCMs of batch of Dynamic Systems from their `quat` states with batched 
+// kinematics kernels. Outputs are structure of arrays as values of `setParametersBatch`, i.e. `euler` 
+// has shape of (3, n_envs) and `dcm` has shape of (9, n_envs) with row-major DCM components. Either 
+// of them can be null.
+extern "C" DYNAMICS_API void getAttitudeBatch(DynamicSystem** batch, int n_envs, float* euler, float* dcm);
+
+// Creating Async Batch of `n_envs` Dynamic Systems which are stepped by `workers` background threads. 
+// Failed systems are reset from `pool` after their step if it is not null.
+extern "C" DYNAMICS_API AsyncBatch* createAsyncBatch(DynamicSystem** batch, int n_envs, int workers, ResetPool* pool);
+
+// Destroying Async Batch. It waits for systems which are being stepped.
+extern "C" DYNAMICS_API void destroyAsyncBatch(AsyncBatch* async_batch);
+
+// Sending `actions` which has shape of (n, action size) of systems `env_ids` to workers. It returns 
+// immediately and a system should be received before it is sent again.
+extern "C" DYNAMICS_API void sendActions(AsyncBatch* async_batch, int* env_ids, float* actions, int n);
+
+// Receiving at least `min_count` and at most `max_count` stepped systems in finishing order. It waits 
+// for `min_count` systems and returns number of received systems. Their ids, normalized observations 
+// and done flags are written into rows of `env_ids`, `observations` and `dones`. For done systems, 
+// last normalized observations are written into `final_observations` if it is not null. A failed 
+// step does not calculate observations, so they are the ones of the step before it.
+extern "C" DYNAMICS_API int recvResults(AsyncBatch* async_batch, int min_count, int max_count, int* env_ids, 
+	float* observations, int* dones, float* final_observations);
+
+// Getting number of systems which are sent and not received.
+extern "C" DYNAMICS_API int getAsyncBatchInFlight(AsyncBatch* async_batch);
@@ -1,6 +1,7 @@
 #include "dynamics.h"
 
-std::unordered_map<std::string, YAML::Node>::const_iterator DynamicSystem::findIndex(const std::string& sNodeName, const std::string& sVariableName)
+template<typename T>
+std::unordered_map<std::string, YAML::Node>::const_iterator DynamicSystemT<T>::findIndex(const std::string& sNodeName, const std::string& sVariableName)
 {
 	std::unordered_map<std::string, YAML::Node>::const_iterator ind = node_map.find(sNodeName);
 	if (ind != node_map.end())
@@ -13,22 +14,26 @@ std::unordered_map<std::string, YAML::Node>::const_iterator DynamicSystem::findI
 	}
 }
 
-DynamicSystem::DynamicSystem(const float& fDt)
+template<typename T>
+DynamicSystemT<T>::DynamicSystemT(const T& fDt)
 {
 	this->fDt = fDt;
 }
 
-void DynamicSystem::setDt(float* fDt)
+template<typename T>
+void DynamicSystemT<T>::setDt(T* fDt)
 {
 	this->fDt = *fDt;
 }
 
-void DynamicSystem::setActionSize(int iNumberOfAct)
+template<typename T>
+void DynamicSystemT<T>::setActionSize(int iNumberOfAct)
 {
 	this->iNumberOfAct = iNumberOfAct;
 }
 
-void DynamicSystem::registerState(const std::string& sName, const Eigen::VectorXf& vValue, const float& fNormalizer)
+template<typename T>
+void DynamicSystemT<T>::registerState(const std::string& sName, const VectorX& vValue, const T& fNormalizer)
 {
 	vsState.registerVector(sName, vValue, fNormalizer);
 	vsStateDot.registerVector(sName, vValue, fNormalizer);
@@ -39,67 +44,416 @@ void DynamicSystem::registerState(const std::string& sName, const Eigen::VectorX
 	vsStateDot3.registerVector(sName, vValue, fNormalizer);
 }
 
-void DynamicSystem::registerObservation(const std::string& sName, const Eigen::VectorXf& vValue, const float& fNormalizer)
+template<typename T>
+void DynamicSystemT<T>::registerObservation(const std::string& sName, const VectorX& vValue, const T& fNormalizer)
 {
+	// Observations are registered again after resetting their VectorSpace, so groups start over.
+	if (vsObservation.mapInfo.empty())
+	{
+		vObservationGroups.clear();
+		vObservationIndices.clear();
+		vObservedGroups.clear();
+	}
+	vObservationGroups.push_back(sName);
+	vObservationIndices.push_back(vsObservation.vValues.size());
+	vObservedGroups.push_back(1);
 	vsObservation.registerVector(sName, vValue, fNormalizer);
 }
 
-void DynamicSystem::registerAction(const std::string& sName, const Eigen::VectorXf& vValue, const float& fNormalizer)
+template<typename T>
+void DynamicSystemT<T>::setObservationMask(const std::vector<std::string>& vNames)
+{
+	std::vector<char> vObserved(vObservationGroups.size(), vNames.empty() ? 1 : 0);
+	try
+	{
+		for (const std::string& sName : vNames)
+		{
+			auto it = std::find(vObservationGroups.begin(), vObservationGroups.end(), sName);
+			if (it == vObservationGroups.end())
+				gThrow("Not Found : Observation named as '" + sName + "' is not registered in " + typeid(*this).name() + "!");
+			vObserved[it - vObservationGroups.begin()] = 1;
+		}
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+	vObservedGroups = vObserved;
+
+	// Unobserved groups are not set anymore, so their stale values are cleared.
+	for (size_t i = 0; i < vObservationGroups.size(); i++)
+	{
+		if (vObservedGroups[i]) continue;
+		const Eigen::Index iSize = vsObservation.mapInfo[vObservationGroups[i]].size;
+		vsObservation.setSegment(vObservationIndices[i], vsObservation.vDefault.segment(vObservationIndices[i], iSize));
+	}
+}
+
+template<typename T>
+void DynamicSystemT<T>::registerAction(const std::string& sName, const VectorX& vValue, const T& fNormalizer)
 {
 	vsAction.registerVector(sName, vValue, fNormalizer);
 	vsAction0.registerVector(sName, vValue, fNormalizer);
 }
 
-void DynamicSystem::step()
+template<typename T>
+void DynamicSystemT<T>::registerFastState(const std::string& sName)
+{
+	try
+	{
+		std::unordered_map<std::string, numberedInfos>::const_iterator ind = vsState.mapInfo.find(sName);
+		if (ind == vsState.mapInfo.end())
+			gThrow("Not Found : State named as '" + sName + "' is not registered in " + typeid(*this).name() + "!");
+
+		// States are registered again during re-initialization, so indices are not duplicated.
+		for (Eigen::Index i = ind->second.index; i < ind->second.index + ind->second.size; i++)
+			if (std::find(iFastStates.begin(), iFastStates.end(), (int)i) == iFastStates.end()) iFastStates.push_back((int)i);
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+}
+
+template<typename T>
+void DynamicSystemT<T>::setFastSubsteps(int iSubsteps)
+{
+	try
+	{
+		if (iSubsteps < 1)
+			gThrow("Value Error : Number of fast sub-steps should be at least 1, but it is " + std::to_string(iSubsteps) + "!");
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+	iFastSubsteps = iSubsteps;
+}
+
+template<typename T>
+void DynamicSystemT<T>::setHistoryLength(int iLength)
 {
+	try
+	{
+		if (iLength < 0)
+			gThrow("Value Error : History length should not be negative, but it is " + std::to_string(iLength) + "!");
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+	iHistoryLength = iLength;
+	vHistory.resize(2 * (Eigen::Index)iHistoryLength * getHistoryFrameSize());
+	resetHistory();
+}
+
+template<typename T>
+void DynamicSystemT<T>::resetHistory()
+{
+	if (iHistoryLength <= 0) return;
+	const Eigen::Index iObservationSize = vsObservation.vNormalizedValues.size(), iFrameSize = getHistoryFrameSize();
+	for (int i = 0; i < 2 * iHistoryLength; i++)
+	{
+		vHistory.segment(i * iFrameSize, iObservationSize) = vsObservation.vNormalizedValues;
+		vHistory.segment(i * iFrameSize + iObservationSize, vsAction.vNormalizedValues.size()) = vsAction.vNormalizedValues;
+	}
+	iHistoryHead = iHistoryLength - 1;
+}
+
+template<typename T>
+void DynamicSystemT<T>::pushHistory()
+{
+	iHistoryHead = (iHistoryHead + 1 == iHistoryLength) ? 0 : iHistoryHead + 1;
+	const Eigen::Index iObservationSize = vsObservation.vNormalizedValues.size(), iFrameSize = getHistoryFrameSize();
+	for (Eigen::Index iFrame : { (Eigen::Index)iHistoryHead, (Eigen::Index)(iHistoryHead + iHistoryLength) })
+	{
+		vHistory.segment(iFrame * iFrameSize, iObservationSize) = vsObservation.vNormalizedValues;
+		vHistory.segment(iFrame * iFrameSize + iObservationSize, vsAction.vNormalizedValues.size()) = vsAction.vNormalizedValues;
+	}
+}
+
+template<typename T>
+void DynamicSystemT<T>::step()
+{
+	// Diverged system is not stepped until it is reset.
+	if (iStatus != STATUS_OK) return;
+
+	DYNAG_PROFILE_SCOPE(profile, SECTION_STEP);
+
+	DYNAG_PROFILE_BEGIN(tStart);
 	getActions(); 
 	stepStart();
 	setActions();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tStart);
 	
+	DYNAG_PROFILE_BEGIN(tCopy);
 	vsState0 = vsState;
+	DYNAG_PROFILE_END(profile, SECTION_RK4, tCopy);
 
 	// No need to set vsState at first step..
+	DYNAG_PROFILE_BEGIN(tGet0);
 	getStates();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tGet0);
 	dynamics(); // Call with x0
+	DYNAG_PROFILE_BEGIN(tSet0);
 	setStateDots();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tSet0);
+	DYNAG_PROFILE_BEGIN(tStage1);
 	vsStateDot0 = vsStateDot; // evaluate k0
-	if (READY == false)	return;
+	DYNAG_PROFILE_END(profile, SECTION_RK4, tStage1);
+
+	// Fast states are integrated through the step first, so slow stages use them instead
+	// of their RK4 stage values.
+	const bool bMultiRate = iFastSubsteps > 1 && !iFastStates.empty();
+	if (bMultiRate) integrateFastStates();
 
+	DYNAG_PROFILE_BEGIN(tStage1Set);
 	vsState = vsState0 + vsStateDot0 * (0.5f * fDt); // find x1, and set it
+	if (bMultiRate) setFastStageValues(vFastMiddle);
+	DYNAG_PROFILE_END(profile, SECTION_RK4, tStage1Set);
+	DYNAG_PROFILE_BEGIN(tGet1);
 	getStates();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tGet1);
 	dynamics();  // call with x1
+	DYNAG_PROFILE_BEGIN(tSet1);
 	setStateDots();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tSet1);
+	DYNAG_PROFILE_BEGIN(tStage2);
 	vsStateDot1 = vsStateDot; // evaluate k1
-	if (READY == false)	return;
 
 	vsState = vsState0 + vsStateDot1 * (0.5f * fDt); // find x2, and set it
+	if (bMultiRate) setFastStageValues(vFastMiddle);
+	DYNAG_PROFILE_END(profile, SECTION_RK4, tStage2);
+	DYNAG_PROFILE_BEGIN(tGet2);
 	getStates();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tGet2);
 	dynamics(); // call with x2
+	DYNAG_PROFILE_BEGIN(tSet2);
 	setStateDots();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tSet2);
+	DYNAG_PROFILE_BEGIN(tStage3);
 	vsStateDot2 = vsStateDot; // evaluate k2
-	if (READY == false)	return;
 
 	vsState = vsState0 + vsStateDot2 * fDt; // find x3, and set it
+	if (bMultiRate) setFastStageValues(vFastEnd);
+	DYNAG_PROFILE_END(profile, SECTION_RK4, tStage3);
+	DYNAG_PROFILE_BEGIN(tGet3);
 	getStates();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tGet3);
 	dynamics();  // call with x3
+	DYNAG_PROFILE_BEGIN(tSet3);
 	setStateDots();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tSet3);
+	DYNAG_PROFILE_BEGIN(tCombine);
 	vsStateDot3 = vsStateDot; // evaluate k3 
-	if (READY == false)	return;
 
-	vsStateDot0 = (vsStateDot0 + vsStateDot1 * 2.0f + vsStateDot2 * 2.0f + vsStateDot3) * 0.16666666666666666f;
-	
-	vsState = vsState0 + vsStateDot0 * fDt;
-	vsStateDot = (vsStateDot0 * (-2.0f) + vsStateDot1 * 2.0f + vsStateDot2 * 2.0f + vsStateDot3) * 0.333333333333333f;
+	if (bMultiRate) combineMultiRateStages();
+	else combineStages();
+	DYNAG_PROFILE_END(profile, SECTION_RK4, tCombine);
 
+	DYNAG_PROFILE_BEGIN(tEnd);
 	getStates();
 	stepEnd();
 	setStates();
-	if (READY == false)	return;
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tEnd);
+	if (iStatus != STATUS_OK) return;
 	
+	DYNAG_PROFILE_BEGIN(tObservation);
 	setObservations();
+	if (iHistoryLength > 0) pushHistory();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tObservation);
+}
+
+template<typename T>
+void DynamicSystemT<T>::combineStages()
+{
+	const int iSize = (int)vsState.vValues.size();
+	const T* fState0 = vsState0.vValues.data();
+	const T* fK1 = vsStateDot1.vValues.data();
+	const T* fK2 = vsStateDot2.vValues.data();
+	const T* fK3 = vsStateDot3.vValues.data();
+	const T* fStateNormalizer = vsState.vNormalizer.data();
+	const T* fStateDotNormalizer = vsStateDot.vNormalizer.data();
+	const T* fK0Normalizer = vsStateDot0.vNormalizer.data();
+	T* fK0 = vsStateDot0.vValues.data();
+	T* fK0Normalized = vsStateDot0.vNormalizedValues.data();
+	T* fState = vsState.vValues.data();
+	T* fStateNormalized = vsState.vNormalizedValues.data();
+	T* fStateDot = vsStateDot.vValues.data();
+	T* fStateDotNormalized = vsStateDot.vNormalizedValues.data();
+
+	int iDiverged = -1;
+	for (int i = 0; i < iSize; i++)
+	{
+		const T fK = (fK0[i] + fK1[i] * 2.0f + fK2[i] * 2.0f + fK3[i]) * T(1.0 / 6.0);
+		fK0[i] = fK;
+		fK0Normalized[i] = fK / (fK0Normalizer[i] + EPS);
+		fState[i] = fState0[i] + fK * fDt;
+		fStateNormalized[i] = fState[i] / (fStateNormalizer[i] + EPS);
+		fStateDot[i] = (fK * (-2.0f) + fK1[i] * 2.0f + fK2[i] * 2.0f + fK3[i]) * T(1.0 / 3.0);
+		fStateDotNormalized[i] = fStateDot[i] / (fStateDotNormalizer[i] + EPS);
+
+		// NaN fails the comparison, so one comparison checks NaN, Inf and limit.
+		if (!(std::fabs(fStateNormalized[i]) <= NORM_LIMIT) && iDiverged < 0) iDiverged = i;
+	}
+	if (iDiverged >= 0) setStatus(iDiverged);
+}
+
+template<typename T>
+void DynamicSystemT<T>::integrateFastStates()
+{
+	DYNAG_PROFILE_SCOPE(profile, SECTION_FAST_STATES);
+
+	const int iFastSize = (int)iFastStates.size();
+	const T fSubDt = fDt / iFastSubsteps;
+	const T* fState0 = vsState0.vValues.data();
+	const T* fStateDot0 = vsStateDot0.vValues.data();
+
+	VectorX& vFast = vFastEnd;
+	vFast.resize(iFastSize);
+	vFastStage.resize(iFastSize);
+	for (int n = 0; n < iFastSize; n++) vFast[n] = fState0[iFastStates[n]];
+
+	for (int j = 0; j < iFastSubsteps; j++)
+	{
+		const T fTime = j * fSubDt;
+
+		// Derivatives at the beginning of step are already calculated by the first stage.
+		if (j == 0)
+		{
+			vFastK[0].resize(iFastSize);
+			for (int n = 0; n < iFastSize; n++) vFastK[0][n] = fStateDot0[iFastStates[n]];
+		}
+		else evaluateFastStates(fTime, vFast, vFastK[0]);
+
+		vFastStage = vFast + vFastK[0] * (0.5f * fSubDt);
+		evaluateFastStates(fTime + 0.5f * fSubDt, vFastStage, vFastK[1]);
+		vFastStage = vFast + vFastK[1] * (0.5f * fSubDt);
+		evaluateFastStates(fTime + 0.5f * fSubDt, vFastStage, vFastK[2]);
+		vFastStage = vFast + vFastK[2] * fSubDt;
+		evaluateFastStates(fTime + fSubDt, vFastStage, vFastK[3]);
+
+		// Middle of step is between sub-steps for even count and in a sub-step for odd count.
+		if (2 * j + 1 == iFastSubsteps) vFastMiddle = vFast;
+		vFast += (vFastK[0] + vFastK[1] * 2.0f + vFastK[2] * 2.0f + vFastK[3]) * (fSubDt * T(1.0 / 6.0));
+		if (2 * j + 1 == iFastSubsteps) vFastMiddle = (vFastMiddle + vFast) * 0.5f;
+		else if (2 * (j + 1) == iFastSubsteps) vFastMiddle = vFast;
+	}
+}
+
+template<typename T>
+void DynamicSystemT<T>::evaluateFastStates(T fTime, const VectorX& vFast, VectorX& vFastDot)
+{
+	vsState.vValues = vsState0.vValues + vsStateDot0.vValues * fTime;
+	setFastStageValues(vFast);
+
+	DYNAG_PROFILE_BEGIN(tGet);
+	getFastStates();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tGet);
+	fastDynamics();
+	DYNAG_PROFILE_BEGIN(tSet);
+	setFastStateDots();
+	DYNAG_PROFILE_END(profile, SECTION_GLUE, tSet);
+
+	const int iFastSize = (int)iFastStates.size();
+	vFastDot.resize(iFastSize);
+	for (int n = 0; n < iFastSize; n++) vFastDot[n] = vsStateDot.vValues[iFastStates[n]];
+}
+
+template<typename T>
+void DynamicSystemT<T>::setFastStageValues(const VectorX& vFast)
+{
+	for (int n = 0; n < (int)iFastStates.size(); n++) vsState.vValues[iFastStates[n]] = vFast[n];
+}
+
+template<typename T>
+void DynamicSystemT<T>::combineMultiRateStages()
+{
+	const int iSize = (int)vsState.vValues.size();
+	if ((int)iFastPositions.size() != iSize)
+	{
+		iFastPositions.assign(iSize, -1);
+		for (int n = 0; n < (int)iFastStates.size(); n++) iFastPositions[iFastStates[n]] = n;
+	}
+
+	const T* fState0 = vsState0.vValues.data();
+	const T* fK1 = vsStateDot1.vValues.data();
+	const T* fK2 = vsStateDot2.vValues.data();
+	const T* fK3 = vsStateDot3.vValues.data();
+	const T* fStateNormalizer = vsState.vNormalizer.data();
+	const T* fStateDotNormalizer = vsStateDot.vNormalizer.data();
+	const T* fK0Normalizer = vsStateDot0.vNormalizer.data();
+	T* fK0 = vsStateDot0.vValues.data();
+	T* fK0Normalized = vsStateDot0.vNormalizedValues.data();
+	T* fState = vsState.vValues.data();
+	T* fStateNormalized = vsState.vNormalizedValues.data();
+	T* fStateDot = vsStateDot.vValues.data();
+	T* fStateDotNormalized = vsStateDot.vNormalizedValues.data();
+
+	int iDiverged = -1;
+	for (int i = 0; i < iSize; i++)
+	{
+		const int n = iFastPositions[i];
+		if (n < 0)
+		{
+			const T fK = (fK0[i] + fK1[i] * 2.0f + fK2[i] * 2.0f + fK3[i]) * T(1.0 / 6.0);
+			fK0[i] = fK;
+			fState[i] = fState0[i] + fK * fDt;
+			fStateDot[i] = (fK * (-2.0f) + fK1[i] * 2.0f + fK2[i] * 2.0f + fK3[i]) * T(1.0 / 3.0);
+		}
+		else
+		{
+			// Mean derivative of fast state through the step.
+			fK0[i] = (vFastEnd[n] - fState0[i]) / fDt;
+			fState[i] = vFastEnd[n];
+			fStateDot[i] = fK3[i];
+		}
+		fK0Normalized[i] = fK0[i] / (fK0Normalizer[i] + EPS);
+		fStateNormalized[i] = fState[i] / (fStateNormalizer[i] + EPS);
+		fStateDotNormalized[i] = fStateDot[i] / (fStateDotNormalizer[i] + EPS);
+
+		// NaN fails the comparison, so one comparison checks NaN, Inf and limit.
+		if (!(std::fabs(fStateNormalized[i]) <= NORM_LIMIT) && iDiverged < 0) iDiverged = i;
+	}
+	if (iDiverged >= 0) setStatus(iDiverged);
+}
+
+template<typename T>
+void DynamicSystemT<T>::setStatus(int iIndex)
+{
+	if (iIndex < 0)
+	{
+		iStatus = STATUS_OK;
+		iStatusIndex = -1;
+		sStatusMessage = "OK";
+		return;
+	}
+
+	const T fValue = vsState.vValues(iIndex);
+	iStatus = std::isnan(fValue) ? STATUS_NAN : (std::isinf(fValue) ? STATUS_INF : STATUS_LIMIT);
+	iStatusIndex = iIndex;
+	sStatusMessage = std::string(iStatus == STATUS_NAN ? "NaN" : (iStatus == STATUS_INF ? "Inf" : "Limit")) + 
+		" : State `" + vsState.getVectorName(iIndex) + "` is " + std::to_string(fValue) + " in " + typeid(*this).name() + "!";
 }
 
-float DynamicSystem::getValueFromYamlNode(const std::string& sNodeName, const std::string& sVariableName)
+template<typename T>
+void DynamicSystemT<T>::checkState()
+{
+	const int iSize = (int)vsState.vNormalizedValues.size();
+	const T* fStateNormalized = vsState.vNormalizedValues.data();
+	for (int i = 0; i < iSize; i++)
+	{
+		if (!(std::fabs(fStateNormalized[i]) <= NORM_LIMIT))
+		{
+			setStatus(i);
+			return;
+		}
+	}
+	setStatus(-1);
+}
+
+template<typename T>
+float DynamicSystemT<T>::getValueFromYamlNode(const std::string& sNodeName, const std::string& sVariableName)
 {
 	try
 	{
@@ -112,7 +466,8 @@ float DynamicSystem::getValueFromYamlNode(const std::string& sNodeName, const st
 	}
 }
 
-void DynamicSystem::setValueInYamlNode(const std::string& sNodeName, const std::string& sVariableName, const float& fValue)
+template<typename T>
+void DynamicSystemT<T>::setValueInYamlNode(const std::string& sNodeName, const std::string& sVariableName, const float& fValue)
 {
 	try
 	{
@@ -125,3 +480,92 @@ void DynamicSystem::setValueInYamlNode(const std::string& sNodeName, const std::
 		std::exit(EXIT_FAILURE);
 	}
 }
+
+template<typename T>
+void DynamicSystemT<T>::setParameters(const int* /*iIds*/, const float* /*fValues*/, int iCount)
+{
+	try
+	{
+		if (iCount > 0)
+			gThrow("Not Found : Compiled parameters not found in " + std::string(typeid(*this).name()) + "!");
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+}
+
+template<typename T>
+int DynamicSystemT<T>::getStateSize()
+{
+	int iValues = (int)(vsState.vValues.size() + vsStateDot.vValues.size() + vsAction.vValues.size() + vsObservation.vValues.size());
+	int iHistoryValues = iHistoryLength * getHistoryFrameSize();
+	return (int)sizeof(StateHeader) + (2 * iValues + iHistoryValues) * (int)sizeof(T);
+}
+
+template<typename T>
+void DynamicSystemT<T>::saveState(char* cBuffer)
+{
+	StateHeader header;
+	header.iMagic = 0x53534744; // "DGSS"
+	header.iSize = getStateSize();
+	header.iStateSize = (int)vsState.vValues.size();
+	header.iActionSize = (int)vsAction.vValues.size();
+	header.iObservationSize = (int)vsObservation.vValues.size();
+	header.iHistoryLength = iHistoryLength;
+	std::memcpy(cBuffer, &header, sizeof(StateHeader));
+	cBuffer += sizeof(StateHeader);
+
+	for (VectorSpace* vs : { &vsState, &vsStateDot, &vsAction, &vsObservation })
+	{
+		std::memcpy(cBuffer, vs->vValues.data(), vs->vValues.size() * sizeof(T));
+		cBuffer += vs->vValues.size() * sizeof(T);
+		std::memcpy(cBuffer, vs->vNormalizedValues.data(), vs->vNormalizedValues.size() * sizeof(T));
+		cBuffer += vs->vNormalizedValues.size() * sizeof(T);
+	}
+
+	// History is saved from oldest to newest frame.
+	if (iHistoryLength > 0) std::memcpy(cBuffer, getHistory(), (size_t)iHistoryLength * getHistoryFrameSize() * sizeof(T));
+}
+
+template<typename T>
+void DynamicSystemT<T>::loadState(const char* cBuffer)
+{
+	try
+	{
+		StateHeader header;
+		std::memcpy(&header, cBuffer, sizeof(StateHeader));
+		if (header.iMagic != 0x53534744 || header.iSize != getStateSize() || 
+			header.iStateSize != vsState.vValues.size() || header.iActionSize != vsAction.vValues.size() ||
+			header.iObservationSize != vsObservation.vValues.size() || header.iHistoryLength != iHistoryLength)
+		{
+			gThrow(std::string("State Error : Buffer is not a state snapshot of ") + typeid(*this).name() + "!");
+		}
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+	cBuffer += sizeof(StateHeader);
+
+	for (VectorSpace* vs : { &vsState, &vsStateDot, &vsAction, &vsObservation })
+	{
+		std::memcpy(vs->vValues.data(), cBuffer, vs->vValues.size() * sizeof(T));
+		cBuffer += vs->vValues.size() * sizeof(T);
+		std::memcpy(vs->vNormalizedValues.data(), cBuffer, vs->vNormalizedValues.size() * sizeof(T));
+		cBuffer += vs->vNormalizedValues.size() * sizeof(T);
+	}
+
+	// Saved frames are written into both halves of history.
+	if (iHistoryLength > 0)
+	{
+		const size_t iBytes = (size_t)iHistoryLength * getHistoryFrameSize() * sizeof(T);
+		std::memcpy(vHistory.data(), cBuffer, iBytes);
+		std::memcpy(vHistory.data() + (size_t)iHistoryLength * getHistoryFrameSize(), cBuffer, iBytes);
+		iHistoryHead = iHistoryLength - 1;
+	}
+	checkState();
+}
+
+template class DynamicSystemT<float>;
+template class DynamicSystemT<double>;
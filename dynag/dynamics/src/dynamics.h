@@ -12,22 +12,67 @@
 * Update : 06/11/2021 - Adding map for yaml nodes. // @MGokcayK
 * Update : 29/11/2021 - Adding Observation, Action register methods and checking yaml file. // @MGokcayK
 * Update : 18/12/2021 - Adding setValueInYamlNode method. // @MGokcayK
+* Update : 19/10/2026 - Adding state snapshot, clone and seed methods. // @MGokcayK
+* Update : 19/10/2026 - Adding compiled parameter methods. // @MGokcayK
+* Update : 19/10/2026 - Adding per-instance status with fused divergence check. // @MGokcayK
+* Update : 19/10/2026 - Adding per-instance profiling counters. // @MGokcayK
+* Update : 19/10/2026 - Templating on scalar type with float and double instantiations. // @MGokcayK
+* Update : 19/10/2026 - Adding multi-rate integration of fast states. // @MGokcayK
+* Update : 19/10/2026 - Adding observation mask of observation groups. // @MGokcayK
+* Update : 19/10/2026 - Adding observation and action history. // @MGokcayK
 */
 
 #pragma once
 
 #include "vectorspace.h"
 #include "kinematics.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstring>
 
-class DynamicSystem
+// Status codes of dynamic system. State is checked once per step for divergence.
+enum DynamicSystemStatus
+{
+	STATUS_OK = 0,		// All states are finite and in limit.
+	STATUS_NAN = 1,		// A state is NaN.
+	STATUS_INF = 2,		// A state is infinite.
+	STATUS_LIMIT = 3	// A normalized state is greater than `NORM_LIMIT`.
+};
+
+// Dynamic system w.r.t scalar type `T`. Yaml parameters and API stay in float, while
+// states, step size and calculations are in `T`.
+template<typename T>
+class DynamicSystemT
 {
 private:
 	// Finding index of map whether if it is exist or not. If not, throw error.
 	std::unordered_map<std::string, YAML::Node>::const_iterator findIndex(const std::string& sNodeName, const std::string& sVariableName);
 
+	// Header of state snapshot which is used for checking the buffer during loading.
+	struct StateHeader
+	{
+		unsigned int iMagic;
+		int iSize, iStateSize, iActionSize, iObservationSize, iHistoryLength;
+	};
+
+	// Combining RK4 stages into new state and state dots. It checks the new state in the
+	// same loop and sets status w.r.t the first diverged state.
+	void combineStages();
+
 public :
+	using VectorX = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+	using VectorSpace = VectorSpaceT<T>;
+
 	int iNumberOfAct = 1; // number of action
 
+	// Status of dynamic system and index of the diverged state in `vsState`.
+	int iStatus = STATUS_OK;
+	int iStatusIndex = -1;
+	std::string sStatusMessage = "OK";
+
+	// Profiling counters of step sections. They are only accumulated if `DYNAG_PROFILE` is enabled.
+	DynamicsProfile profile;
+
 	// Variables of dynamics system for 4th order Runge-Kutta implementation.
 	VectorSpace vsStateDot0 = { std::string{"StateDot0"} }, 
 				vsStateDot1 = { std::string{"StateDot1"} }, 
@@ -37,27 +82,45 @@ public :
 	VectorSpace vsAction0 = { std::string{"Action0"} }; // Used for copying state at the beginning of solving a time step.
 	VectorSpace vsState = { std::string{"State"} };
 	VectorSpace vsStateDot = { std::string{"StatesDot"} };
-	float fDt = 0.01f;
+	T fDt = 0.01f;
 	VectorSpace vsObservation = { std::string{"Observation"} };
 	VectorSpace vsAction = { std::string{"Action"} };
 	VectorSpace vsTrimVariables = { std::string{"TrimVariables"} };
 	VectorSpace vsTrimOutputs = { std::string{"TrimOutputs"} };
 	// VectorSpace vsTrimCondition = { std::string{"Trim Condition"} };
 	VectorSpace vsTrimTargets = { std::string{"TrimTargets"} }; // kind of old trim condition
-	Eigen::VectorXf vReset;
+	VectorX vReset;
+
+	// Indices of fast states in `vsState` which are sub-stepped by multi-rate integration.
+	std::vector<int> iFastStates;
+
+	// Number of sub-steps of fast states in a step. If it is greater than 1 and system has
+	// fast states, fast states are integrated with `iFastSubsteps` RK4 sub-steps while slow
+	// states are integrated with one RK4 step of `fDt`. 1 integrates all states together.
+	int iFastSubsteps = 1;
+
+	// Registered observation groups in registration order, their indices in `vsObservation`
+	// and whether they are observed. Unobserved groups are not calculated and keep their
+	// registered values.
+	std::vector<std::string> vObservationGroups;
+	std::vector<Eigen::Index> vObservationIndices;
+	std::vector<char> vObservedGroups;
 
+	// Number of frames in history. A frame is normalized observation followed by normalized
+	// action which led to it. 0 disables history.
+	int iHistoryLength = 0;
 
 	// Yaml Nodes Map
 	std::unordered_map<std::string, YAML::Node> node_map = {};
 
 	// Constructor of Dynamics System.
-	DynamicSystem(const float& fDt = 0.01f);
+	DynamicSystemT(const T& fDt = 0.01f);
 
 	// Destuctor of Dynamics System.
-	virtual ~DynamicSystem() {};
+	virtual ~DynamicSystemT() {};
 
 	// Setting step size of RK4.
-	void setDt(float* fDt);
+	void setDt(T* fDt);
 
 	// Setting action size of dynamics system.
 	void setActionSize(int iNumberOfAct);
@@ -102,17 +165,65 @@ public :
 	virtual void registerActions() {};
 
 	// Registering the state with normalizer into VectorSpace which also named as state.
-	void registerState(const std::string& sName, const Eigen::VectorXf& vValue, const float& fNormalizer = 1.0f);
+	void registerState(const std::string& sName, const VectorX& vValue, const T& fNormalizer = 1.0f);
 
 	// Registering the observations as VectorSpace.
-	void registerObservation(const std::string& sName, const Eigen::VectorXf& vValue, const float& fNormalizer = 1.0f);
+	void registerObservation(const std::string& sName, const VectorX& vValue, const T& fNormalizer = 1.0f);
 
 	// Registering the actions as VectorSpace.
-	void registerAction(const std::string& sName, const Eigen::VectorXf& vValue, const float& fNormalizer = 1.0f);
+	void registerAction(const std::string& sName, const VectorX& vValue, const T& fNormalizer = 1.0f);
+
+	// Marking registered state as fast state which is sub-stepped by multi-rate integration.
+	void registerFastState(const std::string& sName);
+
+	// Setting observed groups w.r.t their names. Empty list observes all groups.
+	void setObservationMask(const std::vector<std::string>& vNames);
+
+	// Whether observation group at `iGroup` in registration order is observed.
+	bool isObserved(int iGroup) const { return vObservedGroups[iGroup] != 0; };
+
+	// Setting observation group at `iGroup` if it is observed.
+	template<typename Derived>
+	void setObservation(int iGroup, const Eigen::MatrixBase<Derived>& vValue)
+	{
+		if (vObservedGroups[iGroup]) vsObservation.setSegment(vObservationIndices[iGroup], vValue);
+	}
+
+	// Setting number of frames in history. History is filled with current frame.
+	void setHistoryLength(int iLength);
+
+	// Filling all frames of history with current frame. It is called after reset.
+	void resetHistory();
+
+	// Getting the last `iHistoryLength` frames from oldest to newest as one contiguous array.
+	// Pointer is valid until the next step, reset or history length change.
+	const T* getHistory() const { return vHistory.data() + (iHistoryHead + 1) * getHistoryFrameSize(); };
+
+	// Size of a frame of history.
+	int getHistoryFrameSize() const { return (int)(vsObservation.vValues.size() + vsAction.vValues.size()); };
+
+	// Setting number of sub-steps of fast states in a step. It should be at least 1.
+	void setFastSubsteps(int iSubsteps);
+
+	// Base getting states of fast dynamics method. Base method gets all states.
+	virtual void getFastStates() { getStates(); };
+
+	// Base calculation of derivatives of fast states. Other calculations which are not repeated
+	// are held from the last `dynamics` call. Base method calculates whole dynamics.
+	virtual void fastDynamics() { dynamics(); };
+
+	// Base setting statedots of fast dynamics method. Base method sets all statedots.
+	virtual void setFastStateDots() { setStateDots(); };
 
 	// Step RK4.
 	void step();
 
+	// Setting status w.r.t diverged state index. Negative index means that state is ok.
+	void setStatus(int iIndex);
+
+	// Checking whole state once and setting status.
+	void checkState();
+
 	// Base start method for step method. Sometimes some methods should be called before
 	// the RK4 execution such as generating random variables. To handle this, step_start method called.
 	virtual void stepStart() {};
@@ -122,8 +233,67 @@ public :
 	virtual void stepEnd() {};
 
 	// Getting value from yaml node w.r.t node's name and variable name.
-	float getValueFromYamlNode(const std::string& sNodeName, const std::string& sVariableName);
+	virtual float getValueFromYamlNode(const std::string& sNodeName, const std::string& sVariableName);
 
 	// Setting value of yaml node from Python side without changing `.yaml` file.
-	void setValueInYamlNode(const std::string& sNodeName, const std::string& sVariableName, const float& fValue);
+	virtual void setValueInYamlNode(const std::string& sNodeName, const std::string& sVariableName, const float& fValue);
+
+	// Getting id of compiled parameter w.r.t node name and variable name. It returns -1 
+	// if the variable is not compiled.
+	virtual int getParameterId(const std::string& /*sNodeName*/, const std::string& /*sVariableName*/) { return -1; };
+
+	// Setting compiled parameters w.r.t their ids. Systems without compiled parameters 
+	// do not have valid ids.
+	virtual void setParameters(const int* iIds, const float* fValues, int iCount);
+
+	// Size of state snapshot in bytes.
+	virtual int getStateSize();
+
+	// Saving state, statedot, action and observation into the flat buffer which has 
+	// `getStateSize` bytes. Derived systems append their own hidden states.
+	virtual void saveState(char* cBuffer);
+
+	// Loading state from the buffer which is filled by `saveState` of same kind of system.
+	virtual void loadState(const char* cBuffer);
+
+	// Cloning the dynamic system with its current state. Immutable data is shared
+	// between the clones.
+	virtual DynamicSystemT* clone() = 0;
+
+	// Setting seed of random number generator of the dynamic system.
+	virtual void setSeed(unsigned int /*iSeed*/) {};
+
+private:
+	// History has twice `iHistoryLength` frames and each frame is written at `iHistoryHead`
+	// and `iHistoryHead + iHistoryLength`, so the last frames are always contiguous after
+	// `iHistoryHead` without shifting them.
+	VectorX vHistory;
+	int iHistoryHead = 0;
+
+	// Writing current frame into history after a step.
+	void pushHistory();
+
+	// Fast states at the middle and the end of step, and their stage derivatives which are
+	// calculated by multi-rate integration.
+	VectorX vFastMiddle, vFastEnd, vFastStage, vFastK[4];
+
+	// Position of each state in `iFastStates`, or -1 for slow states.
+	std::vector<int> iFastPositions;
+
+	// Sub-stepping fast states through the step with RK4 of `fDt / iFastSubsteps` step size.
+	// Slow states are extrapolated linearly with their derivatives at the beginning of step.
+	void integrateFastStates();
+
+	// Calculating derivatives of fast states at `fTime` seconds after the beginning of step.
+	void evaluateFastStates(T fTime, const VectorX& vFast, VectorX& vFastDot);
+
+	// Writing fast states into `vsState` over the RK4 stage values of slow states.
+	void setFastStageValues(const VectorX& vFast);
+
+	// Combining RK4 stages of slow states and sub-stepped fast states. Derivative of a fast
+	// state at the end of step is its last stage derivative.
+	void combineMultiRateStages();
 };
+
+// Dynamic system of single precision which is used by the library and API.
+using DynamicSystem = DynamicSystemT<float>;
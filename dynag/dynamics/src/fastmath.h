@@ -0,0 +1,173 @@
+/*
+* DynaG Dynamics C++ / Fast Math
+*
+* Polynomial approximations of transcendental functions which are used in hot paths
+* of dynamics. They are branchless inline functions, so loops which call them can
+* be vectorized by the compiler. Coefficients are minimax polynomials of Cephes
+* library and errors are a few ulps in float precision.
+*
+* Fast kernels are compiled only if `DYNAG_FAST_MATH` is non-zero. Instances select
+* them at runtime with their own flag, otherwise standard library is used.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Standard library fallback of kernels for other scalar types. // @MGokcayK
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+
+#ifndef DYNAG_FAST_MATH
+	#define DYNAG_FAST_MATH 1
+#endif
+
+// True if fast kernels are compiled and `bFlag` selects them. It is false at compile
+// time if they are not compiled, so the fast branch is removed.
+#define DYNAG_USE_FAST_MATH(bFlag) (DYNAG_FAST_MATH && (bFlag))
+
+namespace fastmath
+{
+	constexpr float PI = 3.141592653589793f;
+	constexpr float PI_2 = 1.570796326794897f;
+	constexpr float PI_4 = 0.785398163397448f;
+
+	// Sine and cosine of `x`. Argument is reduced into [-pi/4, pi/4] with three part pi/2,
+	// so it is accurate for |x| < 1e5.
+	inline void sincos(float x, float& fSin, float& fCos)
+	{
+		const int q = (int)(x * 0.636619772367581f + (x >= 0.0f ? 0.5f : -0.5f));
+		const float fq = (float)q;
+		const float r = ((x - fq * 1.5703125f) - fq * 4.837512969970703125e-4f) - fq * 7.54978995489188216e-8f;
+		const float z = r * r;
+
+		const float s = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+		const float c = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+
+		const bool bSwap = (q & 1) != 0;
+		const float fS = bSwap ? c : s;
+		const float fC = bSwap ? s : c;
+		fSin = (q & 2) ? -fS : fS;
+		fCos = ((q + 1) & 2) ? -fC : fC;
+	}
+
+	inline float sin(float x) { float s, c; sincos(x, s, c); return s; }
+	inline float cos(float x) { float s, c; sincos(x, s, c); return c; }
+
+	// Arctangent of `x`.
+	inline float atan(float x)
+	{
+		const float ax = std::fabs(x);
+		const bool bLarge = ax > 2.414213562373095f, bMedium = ax > 0.414213562373095f;
+		const float y0 = bLarge ? PI_2 : (bMedium ? PI_4 : 0.0f);
+		const float xr = bLarge ? -1.0f / ax : (bMedium ? (ax - 1.0f) / (ax + 1.0f) : ax);
+		const float z = xr * xr;
+		const float p = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * xr + xr;
+		return std::copysign(y0 + p, x);
+	}
+
+	// Arctangent of `y / x` in [-pi, pi] with signs of both arguments like `std::atan2`.
+	inline float atan2(float y, float x)
+	{
+		const float a = atan(y / x);
+		const float r = (x < 0.0f) ? a + std::copysign(PI, y) : a;
+		return (x == 0.0f && y == 0.0f) ? 0.0f : r;
+	}
+
+	// Arcsine of `x` in [-1, 1].
+	inline float asin(float x)
+	{
+		const float ax = std::fabs(x);
+		const bool bLarge = ax > 0.5f;
+		const float z = bLarge ? 0.5f * (1.0f - ax) : ax * ax;
+		const float s = bLarge ? std::sqrt(z) : ax;
+		const float p = ((((4.2163199048e-2f * z + 2.4181311049e-2f) * z + 4.5470025998e-2f) * z + 7.4953002686e-2f) * z + 1.6666752422e-1f) * z * s + s;
+		return std::copysign(bLarge ? PI_2 - 2.0f * p : p, x);
+	}
+
+	// Base 2 logarithm of positive `x`.
+	inline float log2(float x)
+	{
+		unsigned int iBits;
+		std::memcpy(&iBits, &x, sizeof(float));
+		int e = (int)((iBits >> 23) & 0xFF) - 127;
+		iBits = (iBits & 0x007FFFFFu) | 0x3F800000u;
+		float m;
+		std::memcpy(&m, &iBits, sizeof(float));
+
+		// Mantissa is moved into [sqrt(1/2), sqrt(2)) for the polynomial.
+		const bool bHigh = m > 1.414213562373095f;
+		m = bHigh ? 0.5f * m : m;
+		e = bHigh ? e + 1 : e;
+
+		const float f = m - 1.0f;
+		const float z = f * f;
+		float p = 7.0376836292e-2f;
+		p = p * f - 1.1514610310e-1f;
+		p = p * f + 1.1676998740e-1f;
+		p = p * f - 1.2420140846e-1f;
+		p = p * f + 1.4249322787e-1f;
+		p = p * f - 1.6668057665e-1f;
+		p = p * f + 2.0000714765e-1f;
+		p = p * f - 2.4999993993e-1f;
+		p = p * f + 3.3333331174e-1f;
+		const float fLog = f + (p * f * z - 0.5f * z);
+		return fLog * 1.442695040888963f + (float)e;
+	}
+
+	// Two to the power of `x`. It is clamped into normal float range.
+	inline float exp2(float x)
+	{
+		x = std::fmin(std::fmax(x, -126.0f), 127.0f);
+		const int n = (int)(x + (x >= 0.0f ? 0.5f : -0.5f));
+		const float f = x - (float)n;
+
+		float p = 1.535336188319500e-4f;
+		p = p * f + 1.339887440266574e-3f;
+		p = p * f + 9.618437357674640e-3f;
+		p = p * f + 5.550332471162809e-2f;
+		p = p * f + 2.402264791363012e-1f;
+		p = p * f + 6.931472028550421e-1f;
+		p = p * f + 1.0f;
+
+		const unsigned int iBits = (unsigned int)(n + 127) << 23;
+		float fScale;
+		std::memcpy(&fScale, &iBits, sizeof(float));
+		return p * fScale;
+	}
+
+	// `x` to the power of `y` for positive `x`.
+	inline float pow(float x, float y)
+	{
+		return exp2(y * log2(x));
+	}
+}
+
+// Math kernels which are selected at compile time. Templated kernels take them as
+// parameter, so both variants are generated from the same code.
+template<bool FAST_MATH>
+struct MathKernels
+{
+	template<typename T> static void sincos(T x, T& fSin, T& fCos) { fSin = std::sin(x); fCos = std::cos(x); }
+	template<typename T> static T atan2(T y, T x) { return std::atan2(y, x); }
+	template<typename T> static T asin(T x) { return std::asin(x); }
+	template<typename T> static T pow(T x, T y) { return std::pow(x, y); }
+};
+
+// Fast kernels are single precision, so other scalar types use standard library.
+template<>
+struct MathKernels<true> : MathKernels<false>
+{
+	using MathKernels<false>::sincos;
+	using MathKernels<false>::atan2;
+	using MathKernels<false>::asin;
+	using MathKernels<false>::pow;
+
+	static void sincos(float x, float& fSin, float& fCos) { fastmath::sincos(x, fSin, fCos); }
+	static float atan2(float y, float x) { return fastmath::atan2(y, x); }
+	static float asin(float x) { return fastmath::asin(x); }
+	static float pow(float x, float y) { return fastmath::pow(x, y); }
+};
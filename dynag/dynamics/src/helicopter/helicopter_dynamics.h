@@ -13,17 +13,68 @@
 * Update : 06/11/2021 - Adding map for yaml nodes. // @MGokcayK
 * Update : 23/11/2021 - Adding Quaternion Implementations // @MGokcayK
 * Update : 23/12/2021 - Adding Normal Map from normal map image. // @MGokcayK
+* Update : 19/10/2026 - Adding state snapshot, cloning, shared terrain and per-instance RNG. // @MGokcayK
+* Update : 19/10/2026 - Moving parameters into shared HelicopterParams. // @MGokcayK
+* Update : 19/10/2026 - Adding in-place re-initialization for pooled instances. // @MGokcayK
+* Update : 19/10/2026 - Adding compiled parameter setters. // @MGokcayK
+* Update : 19/10/2026 - Syncing yaml nodes lazily after setting parameters. // @MGokcayK
+* Update : 19/10/2026 - Optional trim on reset and public ground height query for benchmarks. // @MGokcayK
+* Update : 19/10/2026 - Using shared turbulence lookup table with own search hint. // @MGokcayK
+* Update : 19/10/2026 - Advancing Dryden turbulence filters once per step with exact discretization. // @MGokcayK
+* Update : 19/10/2026 - Sampling optional shared frozen turbulence field by position. // @MGokcayK
+* Update : 19/10/2026 - Adding fast math kernels with runtime flag. // @MGokcayK
+* Update : 19/10/2026 - Templating on scalar type with float and double instantiations. // @MGokcayK
+* Update : 19/10/2026 - Adding fast dynamics of multi-rate integration. // @MGokcayK
+* Update : 19/10/2026 - Setting only observed groups and calculating Euler angles once per step. // @MGokcayK
+* Update : 19/10/2026 - Resetting observation history on reset. // @MGokcayK
+* Update : 19/10/2026 - Using per-instance trimming flag. // @MGokcayK
+* Update : 19/10/2026 - Syncing parameters before sharing them with new instances. // @MGokcayK
 */
 
 #pragma once
 
 #include "dynamics.h"
-#include <stb/stb_image.h>
-#include "lookup.h"
+#include "helicopter_params.h"
+#include "../turbulence.h"
 #include <random>
 
-class HelicopterDynamics : public DynamicSystem
+// Helicopter dynamics w.r.t scalar type `T`. Float is the production path and double is
+// the reference path. Parameters, terrain and turbulence field are shared in float.
+template<typename T>
+class HelicopterDynamicsT : public DynamicSystemT<T>
 {
+public :
+	// Members of dependent base are not found without qualification, so they are declared here.
+	using Base = DynamicSystemT<T>;
+	using VectorSpace = VectorSpaceT<T>;
+	using Base::fDt;
+	using Base::node_map;
+	using Base::profile;
+	using Base::vsState;
+	using Base::vsStateDot;
+	using Base::vsState0;
+	using Base::vsStateDot0;
+	using Base::vsStateDot1;
+	using Base::vsStateDot2;
+	using Base::vsStateDot3;
+	using Base::vsObservation;
+	using Base::vsAction;
+	using Base::vsAction0;
+	using Base::setDt;
+	using Base::setActionSize;
+	using Base::setStatus;
+	using Base::checkState;
+	using Base::registerState;
+	using Base::registerObservation;
+	using Base::registerAction;
+	using Base::registerFastState;
+	using Base::iFastSubsteps;
+	using Base::isObserved;
+	using Base::setObservation;
+	using Base::setObservationMask;
+	using Base::setHistoryLength;
+	using Base::resetHistory;
+
 private :
 	static const int iNumberOfAct = 4; // number of action
 	static const int iNumberOfObservation = 34; // number of observation
@@ -35,169 +86,149 @@ private :
 		"N_POS", "E_POS", "ALTITUDE", "GROUND_ALTITUDE",
 		"COLL_ANGLE", "LON_ANGLE", "LAT_ANGLE", "PED_ANGLE",
 		"COLLECTIVE", "LONGITUDINAL", "LATERAL", "PEDAL", "UWIND", "VWIND", "WWIND"};
-	
-	// Yaml Nodes
-	YAML::Node HELI, ENV, TRIM, MR, TR, FUS, HT, VT, WN, LG, FLG;
-
-	// Trim variables
-	float YAW, YAW_RATE, N_VEL, E_VEL, D_VEL, N_POS, E_POS, GR_ALT, PSI_MR, PSI_TR; 
 
-	// Component positions
-	float MR_H, MR_D, FUS_H, FUS_D, WN_H, WN_D, HT_H, HT_D, VT_H, VT_D, TR_H, TR_D;
-	float MR_R, MR_K1, TR_R, MR_TWST, TR_TWST;
-	float WL_CG, FS_CG;
-
-	// Vehicle
-	float M, WT; // mass
-	float VTRANS; // vertical transform
-	float HP_LOSS;
+	// Observation groups in registration order of `registerObservations`.
+	enum ObservationGroup
+	{
+		OBS_TOTALHP, OBS_UVWAIR, OBS_UVW, OBS_ACC, OBS_NEDVEL, OBS_EULERANGLES,
+		OBS_PQR, OBS_XYZ, OBS_GRALT, OBS_SWASHDEF, OBS_SWASHRATE, OBS_WIND
+	};
 	
-	// Gravity Constant
-	float GRAV;
-
-	// Main Rotor params
-	float MR_OMEGA, MR_V_TIP, MR_FR, MR_SOL, MR_A_SIGMA;
-	float MR_GAM_OM16_DRO, MR_DL_DB1, MR_DL_DA1_DRO, MR_COEF_TH;
-	float MR_E, MR_IS;
-
-	// Tail Rotor params
-	float TR_OMEGA, TR_V_TIP, TR_FR, TR_SOL, TR_COEF_TH;
+	// Shared parameters of helicopter. `P` is the raw pointer of `spParams` for
+	// short access in calculations. `bOwnParams` is true if parameters are copied
+	// for this instance to change them.
+	std::shared_ptr<const HelicopterParams> spParams;
+	const HelicopterParams* P = nullptr;
+	bool bOwnParams = false;
 
-	// Fuselage params
-	float FUS_COR, FUS_XUU, FUS_YVV, FUS_ZWW;
-
-	// Horizontal Tail params
-	float HT_ZMAX, HT_ZUU, HT_ZUW;
-
-	// Vertical Tail params
-	float VT_YMAX, VT_YUU, VT_YUV;
-
-	// Wing params
-	float WN_ZMAX, WN_ZUU, WN_ZUW;
-
-	// Landing Gear params
-	float LG_H, LG_D;
-	float LG_C, LG_K;
-	float LG_B; 
-	float LG_MU;
-
-	// Front Landing Gear params
-	float FLG_H, FLG_D;
-	float FLG_C, FLG_K;
-	float FLG_MU;
-	
-	// Input params
-	float COL_OS, COL_H, COL_L, COL_COF;
-	float LON_H, LON_L, LON_COF;
-	float LAT_H, LAT_L, LAT_COF;
-	float PED_OS, PED_H, PED_L, PED_COF;
-
-	// Inertia and Its Reverse;
-	Eigen::Matrix<float, 3, 3, Eigen::RowMajor> I, IINV;
-	
 	// Wind vector in earth frame
-	Eigen::Vector3f vWindNed;
+	Eigen::Vector<T, 3> vWindNed;
 
 	// States for reset
 	VectorSpace vsInitState = { std::string{"Init State"} },
 				vsInitStateDots = { std::string{"Init StateDots"} };
 
 	// Air properties
-	float fAirTemperature, fAirDensity;
-	float T0, LAPSE, RO_SEA, R;
-
-	// Terrain map props
-	float NS_MAX, EW_MAX;
-	float MAX_GR_ALT, MIN_GR_ALT;
-	float fXPerPixel, fYPerPixel; // terrain x & y size per pixel
+	T fAirTemperature, fAirDensity;
 
 	// Ground height parameters, with Landing Gears
 	// float fXLocation, fYLocation;
 	// int iXIndex, iYIndex;
 	// float fHeightMiddle, fHeightNorth, fHeightEast;
-	float fGroundHeight, fGroundHeightRightLandingGear, fGroundHeightLeftLandingGear, fGroundHeightFrontLandingGear;
-	Eigen::Vector<float, 3> vGroundNormal, vGroundNormalRightLandingGear, vGroundNormalLeftLandingGear, vGroundNormalFrontLandingGear;
-	Eigen::Vector<float, 3> vGroundTangent, vGroundTangentRightLandingGear, vGroundTangentLeftLandingGear, vGroundTangentFrontLandingGear;
-
-	// Maps
-	unsigned short* shHeightMapPtr;
-	unsigned char* cNormalMapPtr;
-	Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> mHeightMap;
-	std::vector<std::vector<Eigen::Vector<float, 3>>> mNormalMap;
+	T fGroundHeight, fGroundHeightRightLandingGear, fGroundHeightLeftLandingGear, fGroundHeightFrontLandingGear;
+	Eigen::Vector<T, 3> vGroundNormal, vGroundNormalRightLandingGear, vGroundNormalLeftLandingGear, vGroundNormalFrontLandingGear;
+	Eigen::Vector<T, 3> vGroundTangent, vGroundTangentRightLandingGear, vGroundTangentLeftLandingGear, vGroundTangentFrontLandingGear;
 
 	// Kinematic Matrices
-	Eigen::Matrix<float, 3, 3, Eigen::RowMajor> mEarth2Body, mBody2Earth, mPQR2EulerDot;
-	Eigen::Vector<float, 4> vQuat, vQuatDot; 
+	Eigen::Matrix<T, 3, 3, Eigen::RowMajor> mEarth2Body, mBody2Earth, mPQR2EulerDot;
+	Eigen::Vector<T, 4> vQuat, vQuatDot; 
 
 	// // Dynamic function vectors
-	Eigen::Vector<float, 3> vEulerAngles, vEulerAnglesDot, vPQR, vNEDVel, vUVW, vUVWAir, 
-		vXYZ, vWeight, vGravityForce, vTotalForce, vTotalMoment, vBodyAcceleration; // vXYHObs, 
-	Eigen::Vector<float, 3> vUVWDot, vPQRDot, vXYZDot;
-	Eigen::Vector<float, 2> vBetas;
-	Eigen::Vector<float, 1> vMainRotorVi, vTailRotorVi, vMainRotorPsi, vTailRotorPsi;
-	Eigen::Vector<float, 4> vSwashInput, vSwashDeflection, vSwashRate;
+	// Euler angles are used by the first `dynamics` call before they are calculated from quaternion.
+	Eigen::Vector<T, 3> vEulerAngles = Eigen::Vector<T, 3>::Zero();
+	Eigen::Vector<T, 3> vEulerAnglesDot, vPQR, vNEDVel, vUVW, vUVWAir, 
+		vXYZ, vGravityForce, vTotalForce, vTotalMoment, vBodyAcceleration; // vXYHObs, 
+	Eigen::Vector<T, 3> vUVWDot, vPQRDot, vXYZDot;
+	Eigen::Vector<T, 2> vBetas;
+	Eigen::Vector<T, 1> vMainRotorVi, vTailRotorVi, vMainRotorPsi, vTailRotorPsi;
+	Eigen::Vector<T, 4> vSwashInput, vSwashDeflection, vSwashRate;
 
 	// // Dynamics Function parameters
-	float fTotalPower;
-	Eigen::Vector<float, 1> vTotalPowerHP, vGroundAltitude;
+	T fTotalPower;
+	Eigen::Vector<T, 1> vTotalPowerHP, vGroundAltitude;
 
 	// Main Rotor function parameters
-	float fMainRotorPower;
-	Eigen::Vector<float, 3> vMainRotorForce, vMainRotorMoment;
-	Eigen::Vector<float, 2> vBetasDot;
-	Eigen::Vector<float, 1> vMainRotorViDot, vMainRotorPsiDot;
+	T fMainRotorPower;
+	Eigen::Vector<T, 3> vMainRotorForce, vMainRotorMoment;
+	Eigen::Vector<T, 2> vBetasDot;
+	Eigen::Vector<T, 1> vMainRotorViDot, vMainRotorPsiDot;
 
 	// Tail Rotor function parameters
-	float fTailRotorPower;
-	Eigen::Vector<float, 3> vTailRotorForce, vTailRotorMoment;
-	Eigen::Vector<float, 1> vTailRotorViDot, vTailRotorPsiDot;
+	T fTailRotorPower;
+	Eigen::Vector<T, 3> vTailRotorForce, vTailRotorMoment;
+	Eigen::Vector<T, 1> vTailRotorViDot, vTailRotorPsiDot;
 
 	// Fuselage function parameters
-	float fFuselagePower;
-	Eigen::Vector<float, 3> vFuselageForce, vFuselageMoment;
+	T fFuselagePower;
+	Eigen::Vector<T, 3> vFuselageForce, vFuselageMoment;
 	
 	// Horizontal Tail function parameters
-	Eigen::Vector<float, 3> vHorizontalTailForce, vHorizontalTailMoment;
+	Eigen::Vector<T, 3> vHorizontalTailForce, vHorizontalTailMoment;
 
 	// Vertical Tail function parameters
-	Eigen::Vector<float, 3> vVerticalTailForce, vVerticalTailMoment;
+	Eigen::Vector<T, 3> vVerticalTailForce, vVerticalTailMoment;
 
 	// Wing function parameters
-	float fWingPower;
-	Eigen::Vector<float, 3> vWingForce, vWingMoment;
+	T fWingPower;
+	Eigen::Vector<T, 3> vWingForce, vWingMoment;
 
 	// Landing Gear parameters
-	Eigen::Vector<float, 3> vLandingGearForce, vLandingGearMoment;
+	Eigen::Vector<T, 3> vLandingGearForce, vLandingGearMoment;
 	// Left Landing Gear parameters
-	Eigen::Vector<float, 3> vLeftLandingGearBodyPosition, vLeftLandingGearEarthPosition, vRightLandingGearBodyForce, vLeftLandingGearEarthForce;
+	Eigen::Vector<T, 3> vLeftLandingGearEarthPosition, vRightLandingGearBodyForce, vLeftLandingGearEarthForce;
 	// Left Landing Gear parameters
-	Eigen::Vector<float, 3> vRightLandingGearBodyPosition, vRightLandingGearEarthPosition, vLeftLandingGearBodyForce, vRightLandingGearEarthForce;
+	Eigen::Vector<T, 3> vRightLandingGearEarthPosition, vLeftLandingGearBodyForce, vRightLandingGearEarthForce;
 	// Front Landing Gear parameters
-	Eigen::Vector<float, 3> vFrontLandingGearBodyPosition, vFrontLandingGearEarthPosition, vFrontLandingGearBodyForce, vFrontLandingGearEarthForce; 
+	Eigen::Vector<T, 3> vFrontLandingGearEarthPosition, vFrontLandingGearBodyForce, vFrontLandingGearEarthForce; 
 
 	// Turbulence parameters
-	float fEtaNorm, fTurbulenceLevel, fWindDirection, fWindSpeed, fWindRandomness, fVelocityInfinity;
-	float fWindSpeed20feet, fLengthU, fLengthV, fLengthW, fSigmaU, fSigmaV, fSigmaW, fTurbulenceAzimuth;
+	T fWindDirection, fVelocityInfinity;
+	T fLengthU, fLengthV, fLengthW, fSigmaU, fSigmaV, fSigmaW, fTurbulenceAzimuth;
 
 	// Turbulence vector
-	Eigen::Vector<float, 3> vVelocityInfinityNED, vTurbulenceVelocity, vWindMeanNED, vWind;
-	Eigen::Vector<float, 3> vEta;
-	Eigen::Vector<float, 1> vUsWind, vUsWindDot; 
-	Eigen::Vector<float, 2> vVsWind, vVsWindDot;
-	Eigen::Vector<float, 2> vWsWind, vWsWindDot;
-
-	// Turbulence Exceedence Probability Lookup Table
-	LookUpTable TurbulenceExceedenceProbability = LookUpTable(7, 12);
+	Eigen::Vector<T, 3> vVelocityInfinityNED, vTurbulenceVelocity, vWindMeanNED, vWind;
+	Eigen::Vector<T, 1> vUsWind, vUsWindDot; 
+	Eigen::Vector<T, 2> vVsWind, vVsWindDot;
+	Eigen::Vector<T, 2> vWsWind, vWsWindDot;
+
+	// Dryden filters of turbulence. States of filters are `uswind`, `vswind` and `wswind`.
+	DrydenFilter dfTurbulenceU = DrydenFilter(1), dfTurbulenceV = DrydenFilter(2), dfTurbulenceW = DrydenFilter(2);
+
+	// Origin of turbulence field for this instance and current offset which is the origin
+	// with random offset of reset, convected by mean wind. Field is sampled at `vXYZ + offset`.
+	Eigen::Vector<T, 3> vTurbulenceFieldOrigin = Eigen::Vector<T, 3>::Zero(), vTurbulenceFieldOffset = Eigen::Vector<T, 3>::Zero();
+
+	// Random number generator of turbulence.
+	std::mt19937 mGenerator;
+	std::normal_distribution<float> ndEta = std::normal_distribution<float>(0.0f, 1.0f);
+
+	// Hidden states of helicopter dynamics which are not in vsState. It should be 
+	// trivially copyable to be saved into state snapshot.
+	struct HelicopterStateSnapshot
+	{
+		T vWindMeanNED[3];
+		T vEulerAngles[3], vNEDVel[3], fGroundAltitude;
+		T fWindDirection;
+		DrydenFilter dfTurbulenceU, dfTurbulenceV, dfTurbulenceW;
+		T vTurbulenceFieldOffset[3];
+		std::mt19937 mGenerator;
+		std::normal_distribution<float> ndEta;
+	};
+
+	// Search hint of turbulence lookup table which is shared by all instances.
+	LookUpTable<2>::Hint hTurbulenceHint;
+
+	// Search hint of air density table of parameters.
+	LookUpTable<1>::Hint hAirDensityHint;
 
 	// Trim Vectors and Matrixes;
 	VectorSpace vsStatePerturbation, vsActionPerturbation;
-	Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> mJacobian, mA, mB, mC, mD, mI;
-	Eigen::Vector<float, Eigen::Dynamic> vStep, vStateDotForward, vStateDotBackward, vObservationForward, vObservationBackward;
-	Eigen::Vector<float, Eigen::Dynamic> vTrimOutputs, vTrimOutputsNew, vTrimOutputsForward, vTrimOutputsBackward;
+	Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> mJacobian, mA, mB, mC, mD, mI;
+	Eigen::Vector<T, Eigen::Dynamic> vStep, vStateDotForward, vStateDotBackward, vObservationForward, vObservationBackward;
+	Eigen::Vector<T, Eigen::Dynamic> vTrimOutputs, vTrimOutputsNew, vTrimOutputsForward, vTrimOutputsBackward;
 
 	// Some calculation before starting to calculate dynamics.
 	virtual void preCalculations();
 
+	// Setting node map from yaml nodes of parameters.
+	void setNodes();
+
+	// Getting parameters to change them. Shared parameters are copied before.
+	HelicopterParams* ownParams();
+
+	// Syncing yaml nodes of changed parameters and node map.
+	void syncParams();
+
 	// // Registering states which update numerically in class.
 	void registerStates();
  
@@ -207,14 +238,23 @@ private :
 	// Registering actions
 	void registerActions();
 
+	// Whether fast math kernels are used. Fast kernels are single precision only.
+	bool useFastMath() const { return DYNAG_USE_FAST_MATH(bFastMath) && std::is_same<T, float>::value; }
+
+	// Calculate swashplate deflection rates w.r.t actions.
+	void calculateSwashRate();
+
+	// Calculate Euler angles from quaternion.
+	void calculateEulerAngles();
+
 	// Calculate air properties w.r.t altitude.
 	void calculateAirProperties();
 
 	// Calculate wind / turbulence 
 	void calculateWindTurbulence();
 
-	// Getting ground height values from heigh map of terrain.
-	void getGroundHeightNormal(const Eigen::Vector<float, 3>& vLocation, float& fGroundHeight, Eigen::Vector<float, 3>& vGroundNormal);
+	// Advancing turbulence filters one step w.r.t current altitude and airspeed.
+	void advanceTurbulence();
 
 	// Calculate main rotor force and moments.
 	void calculateMainRotorForceAndMoment();
@@ -237,12 +277,6 @@ private :
 	// Calculate Landing Gear force moments
 	void calculateLandingGearForceMoment();
 
-	// Set HeightMap Matrix from Height Map Image.
-	void setHeightMapMatrixFromHeightMapImage(Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& mTarget, unsigned short* shImagePtr, int& iH, int& iW);
-
-	// Set NormalMap Matrix from Normal Map Image.
-	void setNormalMapMatrixFromNormalMapImage(unsigned char* cImagePtr, int& iH, int& iW, int& iC);
-
 	// get observations of helicopter dynamics.
 	virtual void getActions();
 
@@ -261,19 +295,69 @@ private :
 	// set observations of helicopter dynamics.
 	virtual void setObservations();
 
+	// get states which fast dynamics needs.
+	virtual void getFastStates();
+
+	// set statedots of fast states.
+	virtual void setFastStateDots();
+
+	// Calculating derivatives of actuators, inflows and flapping for multi-rate integration.
+	virtual void fastDynamics();
+
 public :
 	VectorSpace vsDefaultTrimCondition = { std::string{"Default Trim Condition"} };
 
-	// Contructor of Helicopter Dynamics.
-	HelicopterDynamics(char* cHeliYamlPathPtr, float* fDtPtr);
+	// Contructor of Helicopter Dynamics. Parameters of yaml file are parsed once and
+	// shared with the other instances which use the same file.
+	HelicopterDynamicsT(char* cHeliYamlPathPtr, T* fDtPtr);
+
+	// Contructor of Helicopter Dynamics from already calculated parameters.
+	HelicopterDynamicsT(std::shared_ptr<const HelicopterParams> spParams, T* fDtPtr);
+
+	// Re-initializing helicopter dynamics in place as it is constructed from `spParams`.
+	// It is used for recycling instances without allocating them again.
+	void reinitialize(std::shared_ptr<const HelicopterParams> spParams, T* fDtPtr);
+
+	// Getting shared parameters of helicopter dynamics.
+	std::shared_ptr<const HelicopterParams> getParams() const { return spParams; }
+
+	// Getting parameters to share them with a new instance. Yaml nodes of changed parameters
+	// are synced before, so shared parameters are never written.
+	std::shared_ptr<const HelicopterParams> shareParams() { syncParams(); return spParams; }
+
+	// Setting value of yaml node. Shared parameters are copied before changing.
+	virtual void setValueInYamlNode(const std::string& sNodeName, const std::string& sVariableName, const float& fValue);
+
+	// Getting value of yaml node. Compiled parameters are read without yaml nodes.
+	virtual float getValueFromYamlNode(const std::string& sNodeName, const std::string& sVariableName);
+
+	// Getting id of compiled parameter w.r.t node name and variable name.
+	virtual int getParameterId(const std::string& sNodeName, const std::string& sVariableName);
+
+	// Setting compiled parameters. Only derived parameters which depend on them are calculated.
+	virtual void setParameters(const int* iIds, const float* fValues, int iCount);
+
+	// Trimming on reset. If it is false, reset leaves states at their registered defaults.
+	bool bTrimOnReset = true;
+
+	// Using fast math kernels such as polynomial approximations and air density table.
+	// It has effect only if library is built with `DYNAG_FAST_MATH` and `T` is float.
+	bool bFastMath = false;
 
 	// Resetting Helicopter Dynamics w.r.t trim condition.
 	void reset(const VectorSpace& vsTrimCondition = {});
 
+	// Getting ground height values from heigh map of terrain.
+	void getGroundHeightNormal(const Eigen::Vector<T, 3>& vLocation, T& fGroundHeight, Eigen::Vector<T, 3>& vGroundNormal);
+
+	// Setting origin of turbulence field. Instances with same origin fly through same turbulence
+	// if `TURB_FIELD_RND` is 0. It is applied immediately and kept through resets.
+	void setTurbulenceFieldOrigin(const float* fOrigin);
+
 	// Getting number of observation of helicopter dynamics. 
 	virtual int getNumberOfObservations();
 
-	// Overriding the `stepEnd` method for bounding the variables.
+	// Overriding the `stepStart` method for advancing turbulence once per step.
 	virtual void stepStart();
 
 	// Overriding the `stepEnd` method for bounding the variables.
@@ -285,9 +369,29 @@ public :
 	// Trimming the helicopter w.r.t trim condition.
 	void trim();
 
+	// True while trimming. It is per instance, so an instance can be trimmed in a
+	// background thread while others step.
+	bool bTrimming = false;
+
 	// Trim targets of trimming.
-	void getTrimTargets(Eigen::VectorXf& vTrimOutputs);
+	void getTrimTargets(Eigen::Vector<T, Eigen::Dynamic>& vTrimOutputs);
 
-};
+	// Size of state snapshot in bytes.
+	virtual int getStateSize();
+
+	// Saving state with wind and turbulence states and RNG state.
+	virtual void saveState(char* cBuffer);
+
+	// Loading state with wind and turbulence states and RNG state.
+	virtual void loadState(const char* cBuffer);
 
+	// Cloning helicopter dynamics with its state. Parameters and terrain are shared.
+	virtual DynamicSystemT<T>* clone();
+
+	// Setting seed of turbulence random number generator.
+	virtual void setSeed(unsigned int iSeed);
+
+};
 
+// Helicopter dynamics of single precision which is used by the library and API.
+using HelicopterDynamics = HelicopterDynamicsT<float>;
@@ -0,0 +1,530 @@
+#include "helicopter_params.h"
+
+// Yaml locations and dependent groups of compiled parameters. Order should be same
+// as `HelicopterParamId`.
+static const HelicopterParamInfo PARAM_INFOS[PARAM_COUNT] = {
+	{"TRIM", "YAW", GROUP_TRIM}, {"TRIM", "YAW_RATE", GROUP_TRIM}, {"TRIM", "N_VEL", GROUP_TRIM}, 
+	{"TRIM", "E_VEL", GROUP_TRIM}, {"TRIM", "D_VEL", GROUP_TRIM}, {"TRIM", "N_POS", GROUP_TRIM}, 
+	{"TRIM", "E_POS", GROUP_TRIM}, {"TRIM", "GR_ALT", GROUP_TRIM}, {"TRIM", "PSI_MR", GROUP_TRIM}, 
+	{"TRIM", "PSI_TR", GROUP_TRIM},
+
+	{"ENV", "NS_MAX", GROUP_TERRAIN}, {"ENV", "EW_MAX", GROUP_TERRAIN}, 
+	{"ENV", "MAX_GR_ALT", GROUP_TERRAIN}, {"ENV", "MIN_GR_ALT", GROUP_TERRAIN},
+	{"ENV", "GRAV", GROUP_AIR | GROUP_MASS}, {"ENV", "T0", GROUP_AIR}, {"ENV", "LAPSE", GROUP_AIR}, 
+	{"ENV", "RO_SEA", GROUP_AIR}, {"ENV", "R", GROUP_AIR},
+	{"ENV", "TURB_LVL", GROUP_WIND}, {"ENV", "WIND_DIR", GROUP_WIND}, {"ENV", "WIND_SPD", GROUP_WIND}, 
+	{"ENV", "WIND_DIR_RND", GROUP_WIND},
+
+	{"HELI", "COL_OS", GROUP_INPUT}, {"HELI", "COL_H", GROUP_INPUT}, {"HELI", "COL_L", GROUP_INPUT}, 
+	{"HELI", "COL_COF", GROUP_INPUT}, {"HELI", "LON_H", GROUP_INPUT}, {"HELI", "LON_L", GROUP_INPUT}, 
+	{"HELI", "LON_COF", GROUP_INPUT}, {"HELI", "LAT_H", GROUP_INPUT}, {"HELI", "LAT_L", GROUP_INPUT}, 
+	{"HELI", "LAT_COF", GROUP_INPUT}, {"HELI", "PED_OS", GROUP_INPUT}, {"HELI", "PED_H", GROUP_INPUT}, 
+	{"HELI", "PED_L", GROUP_INPUT}, {"HELI", "PED_COF", GROUP_INPUT},
+	{"HELI", "WL_CG", GROUP_POSITION}, {"HELI", "FS_CG", GROUP_POSITION}, {"HELI", "WT", GROUP_MASS}, 
+	{"HELI", "VTRANS", GROUP_MASS}, {"HELI", "HP_LOSS", GROUP_MASS},
+	{"HELI", "IX", GROUP_INERTIA}, {"HELI", "IY", GROUP_INERTIA}, {"HELI", "IZ", GROUP_INERTIA}, 
+	{"HELI", "IXZ", GROUP_INERTIA},
+
+	{"MR", "WL", GROUP_POSITION}, {"MR", "FS", GROUP_POSITION}, {"MR", "R", GROUP_MAIN_ROTOR}, 
+	{"MR", "K1", GROUP_MAIN_ROTOR}, {"MR", "TWST", GROUP_MAIN_ROTOR}, {"MR", "E", GROUP_MAIN_ROTOR}, 
+	{"MR", "IS", GROUP_MAIN_ROTOR}, {"MR", "RPM", GROUP_MAIN_ROTOR}, {"MR", "CD0", GROUP_MAIN_ROTOR}, 
+	{"MR", "B", GROUP_MAIN_ROTOR}, {"MR", "C", GROUP_MAIN_ROTOR}, {"MR", "A", GROUP_MAIN_ROTOR}, 
+	{"MR", "IB", GROUP_MAIN_ROTOR},
+
+	{"TR", "WL", GROUP_POSITION}, {"TR", "FS", GROUP_POSITION}, {"TR", "R", GROUP_TAIL_ROTOR}, 
+	{"TR", "TWST", GROUP_TAIL_ROTOR}, {"TR", "RPM", GROUP_TAIL_ROTOR}, {"TR", "CD0", GROUP_TAIL_ROTOR}, 
+	{"TR", "B", GROUP_TAIL_ROTOR}, {"TR", "C", GROUP_TAIL_ROTOR}, {"TR", "A", GROUP_TAIL_ROTOR},
+
+	{"FUS", "WL", GROUP_POSITION}, {"FUS", "FS", GROUP_POSITION}, {"FUS", "COR", GROUP_AERO}, 
+	{"FUS", "XUU", GROUP_AERO}, {"FUS", "YVV", GROUP_AERO}, {"FUS", "ZWW", GROUP_AERO},
+
+	{"HT", "WL", GROUP_POSITION}, {"HT", "FS", GROUP_POSITION}, {"HT", "ZMAX", GROUP_AERO}, 
+	{"HT", "ZUU", GROUP_AERO}, {"HT", "ZUW", GROUP_AERO},
+
+	{"VT", "WL", GROUP_POSITION}, {"VT", "FS", GROUP_POSITION}, {"VT", "YMAX", GROUP_AERO}, 
+	{"VT", "YUU", GROUP_AERO}, {"VT", "YUV", GROUP_AERO},
+
+	{"WN", "WL", GROUP_POSITION}, {"WN", "FS", GROUP_POSITION}, {"WN", "ZMAX", GROUP_AERO}, 
+	{"WN", "ZUU", GROUP_AERO}, {"WN", "ZUW", GROUP_AERO},
+
+	{"LG", "WL", GROUP_POSITION}, {"LG", "FS", GROUP_POSITION}, {"LG", "B", GROUP_POSITION}, 
+	{"LG", "C", GROUP_LANDING_GEAR}, {"LG", "K", GROUP_LANDING_GEAR}, {"LG", "MU", GROUP_LANDING_GEAR},
+
+	{"FLG", "WL", GROUP_POSITION}, {"FLG", "FS", GROUP_POSITION}, {"FLG", "C", GROUP_LANDING_GEAR}, 
+	{"FLG", "K", GROUP_LANDING_GEAR}, {"FLG", "MU", GROUP_LANDING_GEAR},
+};
+
+const LookUpTable<2>& HelicopterParams::getTurbulenceExceedenceProbability()
+{
+	// Rows are turbulence levels and columns are altitudes [ft].
+	static const LookUpTable<2> table(
+		{ std::vector<float>{ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f },
+		  std::vector<float>{ 500.0f, 1750.0f, 3750.0f, 7500.0f, 15000.0f, 25000.0f, 35000.0f, 45000.0f, 55000.0f, 65000.0f, 75000.0f, 80000.0f } },
+		{ 3.2f, 2.2f, 1.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+		  4.2f, 3.6f, 3.3f, 1.6f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+		  6.6f, 6.9f, 7.4f, 6.7f, 4.6f, 2.7f, 0.4f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+		  8.6f, 9.6f, 10.6f, 10.1f, 8.0f, 6.6f, 5.0f, 4.2f, 2.7f, 0.0f, 0.0f, 0.0f,
+		  11.8f, 13.0f, 16.0f, 15.1f, 11.6f, 9.7f, 8.1f, 8.2f, 7.9f, 4.9f, 3.2f, 2.1f,
+		  15.6f, 17.6f, 23.0f, 23.6f, 22.1f, 20.0f, 16.0f, 15.1f, 12.1f, 7.9f, 6.2f, 5.1f,
+		  18.7f, 21.5f, 28.4f, 30.2f, 30.7f, 31.0f, 25.2f, 23.1f, 17.5f, 10.7f, 8.4f, 7.2f });
+	return table;
+}
+
+std::shared_ptr<const HelicopterParams> HelicopterParams::load(const std::string& sYamlPath)
+{
+	// Cache stores weak pointers, so parameters are released with their last instance.
+	static std::mutex mtxCache;
+	static std::unordered_map<std::string, std::weak_ptr<const HelicopterParams>> mapCache;
+	std::lock_guard<std::mutex> lock(mtxCache);
+
+	std::shared_ptr<const HelicopterParams> spParams = mapCache[sYamlPath].lock();
+	if (spParams) return spParams;
+
+	YAML::Node data = YAML::LoadFile(sYamlPath);
+	checkYamlFile(data, const_cast<char*>(sYamlPath.c_str()));
+
+	std::shared_ptr<HelicopterParams> spNewParams = std::make_shared<HelicopterParams>();
+	spNewParams->sYamlPath = sYamlPath;
+	spNewParams->setNodes(data);
+
+	// Compile input parameters and calculate derived ones
+	spNewParams->compile();
+	spNewParams->calculate();
+	spNewParams->syncNodes();
+
+	mapCache[sYamlPath] = spNewParams;
+	return spNewParams;
+}
+
+std::shared_ptr<HelicopterParams> HelicopterParams::clone() const
+{
+	// Cloning yaml nodes is expensive, so the clone shares them until it writes
+	// into them in `syncNodes`.
+	std::shared_ptr<HelicopterParams> spClone = std::make_shared<HelicopterParams>(*this);
+	spClone->bSharedNodes = true;
+	return spClone;
+}
+
+void HelicopterParams::ownNodes()
+{
+	// Yaml nodes are references, so they are cloned to be independent.
+	if (!bSharedNodes) return;
+	setNodes(YAML::Clone(DATA));
+	bSharedNodes = false;
+}
+
+void HelicopterParams::setNodes(const YAML::Node& data)
+{
+	// Nodes are rebound by `reset`. Assignment would change the content of the
+	// node which is referenced by the other copies.
+	DATA.reset(data);
+	HELI.reset(DATA["HELI"]);
+	ENV.reset(DATA["ENV"]);
+	TRIM.reset(HELI["TRIM"]); 
+	MR.reset(HELI["MR"]);
+	TR.reset(HELI["TR"]);
+	FUS.reset(HELI["FUS"]);
+	HT.reset(HELI["HT"]);
+	VT.reset(HELI["VT"]);
+	WN.reset(HELI["WN"]);
+	LG.reset(HELI["LG"]);
+	FLG.reset(HELI["FLG"]);
+}
+
+void HelicopterParams::setHeightMapMatrixFromHeightMapImage(Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& mTarget, unsigned short* shImagePtr, int& iH, int& iW)
+{
+	for (int y = 0; y < iH; y++)
+	{
+		for (int x = 0; x < iW; x++)
+		{
+			mTarget(y, x) = static_cast<float>(shImagePtr[y * iW + x] / (float)USHRT_MAX);
+		}
+	}
+}
+
+void HelicopterParams::setNormalMapMatrixFromNormalMapImage(std::vector<std::vector<Eigen::Vector<float, 3>>>& mTarget, unsigned char* cImagePtr, int& iH, int& iW, int& iC)
+{
+	/* NOTE : Importing point of the normal map image is the direction axis in normal map image.
+	*		It should be same direction with our NED frame axis. This can be explain in this way,
+	*		In `stb` library image read start from upper left (w.r.t screen) to bottom right as 
+	*		row by row like other image libraries. Image's x axis increase with width of image (to right)
+	*       and image's y axis increase with height of image (to bottom). Our NED frame uses the same
+	*		direction. RGB values of normal map should have R as X and G as Y axis of NED frame. Z axis
+	*		will be negative of NED frame. In NED frame, Z axis is positive towards to downward. On
+	*		the other hand in normal vector, Z axis is positive towards to upward. So, G of image
+	*		represents -Z axis of NED frame. Therefore, if RGB values of normal map is not match 
+    *		with NED frame, normal values can be wrong and calculations will broken. 
+	*/
+	// Make sure that mTarget is already empty.
+	mTarget.clear();
+	Eigen::Vector<float, 3> temp;
+	std::vector<Eigen::Vector<float, 3>> row;
+	for (int y = 0; y < iH; y++)
+	{
+		row.clear();
+		for (int x = 0; x < iW; x++)
+		{
+			unsigned char* pixelOffset = cImagePtr + (y * iW + x) * iC;
+			temp(0) = (static_cast<float>(pixelOffset[0]) - 127.5f) / 127.5f;
+			temp(1) = (static_cast<float>(pixelOffset[1]) - 127.5f) / 127.5f;
+			temp(2) = (static_cast<float>(pixelOffset[2]) - 127.5f) / 127.5f;
+			temp.normalize();
+			row.push_back(temp);
+		}
+		mTarget.push_back(row);
+	}
+}
+
+void HelicopterParams::loadTerrain()
+{
+	std::string sHeightMapPath = std::getenv("DYNAG_RESOURCE_DIR") + ENV["HMAP_PATH"].as<std::string>();
+	std::string sNormalMapPath = std::getenv("DYNAG_RESOURCE_DIR") + ENV["NMAP_PATH"].as<std::string>();
+	float fHeightScale = MAX_GR_ALT - MIN_GR_ALT;
+
+	// Terrain is reloaded only if its yaml values are changed. Otherwise, it is shared.
+	if (spTerrain && spTerrain->sHeightMapPath == sHeightMapPath && 
+		spTerrain->sNormalMapPath == sNormalMapPath && spTerrain->fHeightScale == fHeightScale)
+		return;
+
+	std::shared_ptr<TerrainMap> spNewTerrain = std::make_shared<TerrainMap>();
+	spNewTerrain->sHeightMapPath = sHeightMapPath;
+	spNewTerrain->sNormalMapPath = sNormalMapPath;
+	spNewTerrain->fHeightScale = fHeightScale;
+
+	int iWidthHeightMap, iHeightHeightMap, iNrComponentsHeightMap;
+	unsigned short* shHeightMapPtr = stbi_load_16(sHeightMapPath.c_str(), &iWidthHeightMap, &iHeightHeightMap, &iNrComponentsHeightMap, 0);
+	spNewTerrain->mHeightMap.resize(iHeightHeightMap, iWidthHeightMap);
+	setHeightMapMatrixFromHeightMapImage(spNewTerrain->mHeightMap, shHeightMapPtr, iHeightHeightMap, iWidthHeightMap);
+	spNewTerrain->mHeightMap = spNewTerrain->mHeightMap.array() * fHeightScale;
+	stbi_image_free(shHeightMapPtr);
+
+	int iWidthNormalMap, iHeightNormalMap, iNrComponentsNormalMap;
+	unsigned char* cNormalMapPtr = stbi_load(sNormalMapPath.c_str(), &iWidthNormalMap, &iHeightNormalMap, &iNrComponentsNormalMap, 3);
+	setNormalMapMatrixFromNormalMapImage(spNewTerrain->mNormalMap, cNormalMapPtr, iHeightNormalMap, iWidthNormalMap, iNrComponentsNormalMap);
+	stbi_image_free(cNormalMapPtr);
+
+	spTerrain = spNewTerrain;
+}
+
+void HelicopterParams::loadTurbulenceField()
+{
+	// Turbulence field is optional, so missing yaml values have defaults.
+	if (!ENV["TURB_FIELD"] || ENV["TURB_FIELD"].as<float>() != 1.0f)
+	{
+		spTurbulenceField.reset();
+		fTurbulenceFieldRandomness = 0.0f;
+		return;
+	}
+
+	int iSize = ENV["TURB_FIELD_SIZE"] ? (int)ENV["TURB_FIELD_SIZE"].as<float>() : 64;
+	float fSpacing = ENV["TURB_FIELD_SPACING"] ? ENV["TURB_FIELD_SPACING"].as<float>() : 50.0f;
+	float fLength = ENV["TURB_FIELD_LENGTH"] ? ENV["TURB_FIELD_LENGTH"].as<float>() : 500.0f;
+	unsigned int iSeed = ENV["TURB_FIELD_SEED"] ? (unsigned int)ENV["TURB_FIELD_SEED"].as<float>() : 1u;
+	std::string sCacheDirectory = ENV["TURB_FIELD_CACHE"] ? ENV["TURB_FIELD_CACHE"].as<std::string>() : "";
+	fTurbulenceFieldRandomness = ENV["TURB_FIELD_RND"] ? ENV["TURB_FIELD_RND"].as<float>() : 1.0f;
+
+	spTurbulenceField = TurbulenceField::load(iSize, fSpacing, fLength, iSeed, sCacheDirectory);
+}
+
+const HelicopterParamInfo& HelicopterParams::getParameterInfo(int iId)
+{
+	return PARAM_INFOS[iId];
+}
+
+int HelicopterParams::findParameter(const std::string& sNodeName, const std::string& sVariableName)
+{
+	// Map is filled once and only read after that, so it is safe for concurrent calls.
+	static const std::unordered_map<std::string, int> mapIds = []() {
+		std::unordered_map<std::string, int> mapIds;
+		for (int i = 0; i < PARAM_COUNT; i++)
+			mapIds.insert(std::make_pair(std::string(PARAM_INFOS[i].cNode) + "/" + PARAM_INFOS[i].cVariable, i));
+		return mapIds;
+	}();
+
+	std::unordered_map<std::string, int>::const_iterator ind = mapIds.find(sNodeName + "/" + sVariableName);
+	return ind == mapIds.end() ? -1 : ind->second;
+}
+
+YAML::Node& HelicopterParams::getNode(const std::string& sNodeName)
+{
+	if (sNodeName == "TRIM") return TRIM;
+	if (sNodeName == "ENV") return ENV;
+	if (sNodeName == "MR") return MR;
+	if (sNodeName == "TR") return TR;
+	if (sNodeName == "FUS") return FUS;
+	if (sNodeName == "HT") return HT;
+	if (sNodeName == "VT") return VT;
+	if (sNodeName == "WN") return WN;
+	if (sNodeName == "LG") return LG;
+	if (sNodeName == "FLG") return FLG;
+	return HELI;
+}
+
+void HelicopterParams::compile()
+{
+	for (int i = 0; i < PARAM_COUNT; i++)
+		fValues[i] = getNode(PARAM_INFOS[i].cNode)[PARAM_INFOS[i].cVariable].as<float>();
+}
+
+unsigned int HelicopterParams::setParameter(int iId, float fValue)
+{
+	// Yaml nodes are synced lazily, so setting parameter does not touch them.
+	fValues[iId] = fValue;
+	bNodesDirty = true;
+	return PARAM_INFOS[iId].iGroups;
+}
+
+void HelicopterParams::syncNodes()
+{
+	ownNodes();
+	for (int i = 0; i < PARAM_COUNT; i++)
+		getNode(PARAM_INFOS[i].cNode)[PARAM_INFOS[i].cVariable] = fValues[i];
+
+	// Derived parameters
+	MR["MR_H"] = MR_H;
+	MR["MR_D"] = MR_D;
+	FUS["FUS_H"] = FUS_H;
+	FUS["FUS_D"] = FUS_D;
+	WN["WN_H"] = WN_H;
+	WN["WN_D"] = WN_D;
+	HT["MR_H"] = HT_H;
+	HT["MR_D"] = HT_D;
+	VT["MR_H"] = VT_H;
+	VT["MR_D"] = VT_D;
+	TR["MR_H"] = TR_H;
+	TR["MR_D"] = TR_D;
+	LG["LG_H"] = LG_H;
+	LG["LG_D"] = LG_D;
+	FLG["LG_H"] = FLG_H;
+	FLG["LG_D"] = FLG_D;
+	HELI["M"] = M;
+	MR["MR_OMEGA"] = MR_OMEGA;
+	MR["MR_V_TIP"] = MR_V_TIP;
+	MR["MR_FR"] = MR_FR;
+	MR["MR_SOL"] = MR_SOL;
+	MR["MR_A_SIGMA"] = MR_A_SIGMA;
+	MR["MR_GAM_OM16_DRO"] = MR_GAM_OM16_DRO;
+	MR["MR_DL_DB1"] = MR_DL_DB1;
+	MR["MR_DL_DA1_DRO"] = MR_DL_DA1_DRO;
+	MR["MR_COEF_TH"] = MR_COEF_TH;
+	TR["TR_OMEGA"] = TR_OMEGA;
+	TR["TR_V_TIP"] = TR_V_TIP;
+	TR["TR_FR"] = TR_FR;
+	TR["TR_SOL"] = TR_SOL;
+	TR["TR_COEF_TH"] = TR_COEF_TH;
+
+	bNodesDirty = false;
+}
+
+void HelicopterParams::calculate(unsigned int iGroups)
+{	
+	const float* V = fValues;
+
+	// Trim related
+	if (iGroups & GROUP_TRIM)
+	{
+		YAW = V[PARAM_TRIM_YAW];
+		YAW_RATE = V[PARAM_TRIM_YAW_RATE]; 
+		N_VEL = V[PARAM_TRIM_N_VEL];   
+		E_VEL = V[PARAM_TRIM_E_VEL];   
+		D_VEL = V[PARAM_TRIM_D_VEL];   
+		N_POS = V[PARAM_TRIM_N_POS];   
+		E_POS = V[PARAM_TRIM_E_POS];   
+		GR_ALT = V[PARAM_TRIM_GR_ALT];
+		PSI_MR = V[PARAM_TRIM_PSI_MR];
+		PSI_TR = V[PARAM_TRIM_PSI_TR];
+	}
+
+	// Height map preparation
+	if (iGroups & GROUP_TERRAIN)
+	{
+		NS_MAX = V[PARAM_ENV_NS_MAX];
+		EW_MAX = V[PARAM_ENV_EW_MAX];
+		MAX_GR_ALT = V[PARAM_ENV_MAX_GR_ALT];
+		MIN_GR_ALT = V[PARAM_ENV_MIN_GR_ALT];
+	
+		loadTerrain();
+		fXPerPixel = NS_MAX / spTerrain->mHeightMap.rows();
+		fYPerPixel = EW_MAX / spTerrain->mHeightMap.cols();
+	}
+	
+	//// Set Constant from yaml file.
+	// Gravity and Air Properties
+	if (iGroups & GROUP_AIR)
+	{
+		GRAV = V[PARAM_ENV_GRAV];
+		T0 = V[PARAM_ENV_T0];
+		LAPSE = V[PARAM_ENV_LAPSE];
+		RO_SEA = V[PARAM_ENV_RO_SEA];
+		R = V[PARAM_ENV_R];
+
+		// Same expression as `HelicopterDynamics::calculateAirProperties` at breakpoints.
+		int iCount = (int)((AIR_TABLE_MAX_ALT - AIR_TABLE_MIN_ALT) / AIR_TABLE_STEP) + 1;
+		std::vector<float> vAltitudes(iCount), vDensities(iCount);
+		for (int i = 0; i < iCount; i++)
+		{
+			vAltitudes[i] = AIR_TABLE_MIN_ALT + i * AIR_TABLE_STEP;
+			float fTemperature = T0 - LAPSE * vAltitudes[i];
+			vDensities[i] = RO_SEA * powf(fTemperature / T0, ((GRAV / (LAPSE * R)) - 1.0f));
+		}
+		ltAirDensity = LookUpTable<1>({ vAltitudes }, vDensities);
+	}
+
+	// Input params;
+	if (iGroups & GROUP_INPUT)
+	{
+		COL_OS = V[PARAM_HELI_COL_OS];
+		COL_H = V[PARAM_HELI_COL_H];
+		COL_L = V[PARAM_HELI_COL_L];
+		COL_COF = V[PARAM_HELI_COL_COF];
+		LON_H = V[PARAM_HELI_LAT_H];
+		LON_L = V[PARAM_HELI_LAT_L];
+		LON_COF = V[PARAM_HELI_LAT_COF];
+		LAT_H = V[PARAM_HELI_LON_H];
+		LAT_L = V[PARAM_HELI_LON_L];
+		LAT_COF = V[PARAM_HELI_LON_COF];
+		PED_OS = V[PARAM_HELI_PED_OS];
+		PED_H = V[PARAM_HELI_PED_H];
+		PED_L = V[PARAM_HELI_PED_L];
+		PED_COF = V[PARAM_HELI_PED_COF];
+	}
+
+	// Component positions w.r.t CG Locations
+	// 1/12 for converting inch to feet.
+	if (iGroups & GROUP_POSITION)
+	{
+		WL_CG = V[PARAM_HELI_WL_CG];
+		FS_CG = V[PARAM_HELI_FS_CG];
+		MR_H = (V[PARAM_MR_WL] - WL_CG) / 12.0f;
+		MR_D = (V[PARAM_MR_FS] - FS_CG) / 12.0f;
+		FUS_H = (V[PARAM_FUS_WL] - WL_CG) / 12.0f;
+		FUS_D = (V[PARAM_FUS_FS] - FS_CG) / 12.0f;
+		WN_H = (V[PARAM_WN_WL] - WL_CG) / 12.0f;
+		WN_D = (V[PARAM_WN_FS] - FS_CG) / 12.0f;
+		HT_H = (V[PARAM_HT_WL] - WL_CG) / 12.0f;
+		HT_D = (V[PARAM_HT_FS] - FS_CG) / 12.0f;
+		VT_H = (V[PARAM_VT_WL] - WL_CG) / 12.0f;
+		VT_D = (V[PARAM_VT_FS] - FS_CG) / 12.0f;
+		TR_H = (V[PARAM_TR_WL] - WL_CG) / 12.0f;
+		TR_D = (V[PARAM_TR_FS] - FS_CG) / 12.0f;
+		LG_B = V[PARAM_LG_B] / 12.0f;
+		LG_H = (V[PARAM_LG_WL] - WL_CG) / 12.0f;
+		LG_D = (V[PARAM_LG_FS] - FS_CG) / 12.0f;
+		FLG_H = (V[PARAM_FLG_WL] - WL_CG) / 12.0f;
+		FLG_D = (V[PARAM_FLG_FS] - FS_CG) / 12.0f;	
+
+		vRightLandingGearBodyPosition[0] = -LG_D;
+		vRightLandingGearBodyPosition[1] = 0.5f * LG_B;
+		vRightLandingGearBodyPosition[2] = -LG_H;
+		vLeftLandingGearBodyPosition[0] = -LG_D;
+		vLeftLandingGearBodyPosition[1] = -0.5f * LG_B;
+		vLeftLandingGearBodyPosition[2] = -LG_H;
+		vFrontLandingGearBodyPosition[0] = -FLG_D;
+		vFrontLandingGearBodyPosition[1] = 0.0f;
+		vFrontLandingGearBodyPosition[2] = -FLG_H;
+	}
+
+	// Vehicle General
+	if (iGroups & GROUP_MASS)
+	{
+		WT = V[PARAM_HELI_WT];
+		// Weight Vector
+		vWeight[0] = 0.0f; 	
+		vWeight[1] = 0.0f;
+		vWeight[2] = WT;
+		M = WT / V[PARAM_ENV_GRAV]; // [slug] 
+		VTRANS = V[PARAM_HELI_VTRANS];
+		HP_LOSS = V[PARAM_HELI_HP_LOSS];
+	}
+
+	// Inertia Matrix and its reverse
+	if (iGroups & GROUP_INERTIA)
+	{
+		I = Eigen::Matrix3f::Zero();
+		I(0, 0) =  V[PARAM_HELI_IX];
+		I(0, 2) = -V[PARAM_HELI_IXZ];
+		I(1, 1) =  V[PARAM_HELI_IY];
+		I(2, 0) = -V[PARAM_HELI_IXZ];
+		I(2, 2) =  V[PARAM_HELI_IZ];
+		IINV = I.inverse();
+	}
+
+	// Main Rotor
+	if (iGroups & GROUP_MAIN_ROTOR)
+	{
+		MR_R = V[PARAM_MR_R];
+		MR_K1 = V[PARAM_MR_K1];
+		MR_TWST = V[PARAM_MR_TWST];
+		MR_E = V[PARAM_MR_E];
+		MR_IS = V[PARAM_MR_IS];
+		MR_OMEGA = V[PARAM_MR_RPM] * 2.0f * PI / 60.0f; // MR REV SPEED
+		MR_V_TIP = MR_R * MR_OMEGA; // [ft/s] MR TIP SPEED
+		MR_FR = V[PARAM_MR_CD0] * MR_R * V[PARAM_MR_B] * V[PARAM_MR_C]; // MR EFFICIENT FRONTAL AREA 
+		MR_SOL = V[PARAM_MR_B] * V[PARAM_MR_C] / (MR_R * PI); // MR SOLIDITY (SIGMA)
+		MR_A_SIGMA = V[PARAM_MR_A] * MR_SOL; // PRODUCTION OF LIFT-CURVE-SLOP WITH SOLIDITY
+		// ONE SIXTEENTH THE PRODUCT (LOCK# & ROTOR ANG. RATE) DIVIDED BY AIR DENSITY 
+		MR_GAM_OM16_DRO = V[PARAM_MR_A] * V[PARAM_MR_C] * powf(MR_R, 4.0f) / V[PARAM_MR_IB];
+		MR_GAM_OM16_DRO *= MR_OMEGA / 16.0f * (1.0f + 8.0f / 3.0f * MR_E / MR_R);
+		// PRIMARY (DIRECT) FLAPPING STIFFNESS [rad/sec^2]
+		MR_DL_DB1 = V[PARAM_MR_B] / 2.0f * (1.5f * V[PARAM_MR_IB] * MR_E / MR_R * powf(MR_OMEGA, 2.0f));
+		// CORSS (OFF-AXIS) FLAPPING STIFFNESS [rad/sec^2] DIVIDED BY AIR DENSITY
+		MR_DL_DA1_DRO = 0.5f * V[PARAM_MR_A] * V[PARAM_MR_B] * V[PARAM_MR_C] * MR_R * powf(MR_V_TIP, 2.0f) * MR_E / 6.0f;
+		MR_COEF_TH = 0.25f * MR_V_TIP * MR_R * V[PARAM_MR_A] * V[PARAM_MR_B] * V[PARAM_MR_C]; // THRUST COEFFICIENT
+	}
+
+	// Tail Rotor
+	if (iGroups & GROUP_TAIL_ROTOR)
+	{
+		TR_R = V[PARAM_TR_R];
+		TR_TWST = V[PARAM_TR_TWST];
+		TR_OMEGA = V[PARAM_TR_RPM] * 2.0f * PI / 60.0f; // TR REV SPEED
+		TR_V_TIP = TR_R * TR_OMEGA; // [ft/s] TR TIP SPEED
+		TR_FR = V[PARAM_TR_CD0] * TR_R * V[PARAM_TR_B] * V[PARAM_TR_C]; // TR EFFICIENT FRONTAL AREA 
+		TR_SOL = V[PARAM_TR_B] * V[PARAM_TR_C] / (TR_R * PI); // TR SOLIDITY (SIGMA)
+		TR_COEF_TH = 0.25f * TR_V_TIP * TR_R * V[PARAM_TR_A] * V[PARAM_TR_B] * V[PARAM_TR_C]; // THRUST COEFFICIENT
+	}
+
+	// Fuselage, Horizontal Tail, Vertical Tail and Wing
+	if (iGroups & GROUP_AERO)
+	{
+		FUS_COR = V[PARAM_FUS_COR];
+		FUS_XUU = V[PARAM_FUS_XUU];
+		FUS_YVV = V[PARAM_FUS_YVV];
+		FUS_ZWW = V[PARAM_FUS_ZWW];
+
+		HT_ZMAX = V[PARAM_HT_ZMAX];
+		HT_ZUU = V[PARAM_HT_ZUU];
+		HT_ZUW = V[PARAM_HT_ZUW];
+
+		VT_YMAX = V[PARAM_VT_YMAX];
+		VT_YUU = V[PARAM_VT_YUU];
+		VT_YUV = V[PARAM_VT_YUV];
+
+		WN_ZMAX = V[PARAM_WN_ZMAX];
+		WN_ZUU = V[PARAM_WN_ZUU];
+		WN_ZUW = V[PARAM_WN_ZUW];
+	}
+
+	// Landing Gear
+	if (iGroups & GROUP_LANDING_GEAR)
+	{
+		LG_C = V[PARAM_LG_C];
+		LG_K = V[PARAM_LG_K];
+		LG_MU = V[PARAM_LG_MU]; 
+		FLG_C = V[PARAM_FLG_C];
+		FLG_K = V[PARAM_FLG_K];	
+		FLG_MU = V[PARAM_FLG_MU]; 
+	}
+
+	// Wind
+	if (iGroups & GROUP_WIND)
+	{
+		fTurbulenceLevel = V[PARAM_ENV_TURB_LVL];
+		fWindDirection = V[PARAM_ENV_WIND_DIR] * D2R;
+		fWindSpeed = V[PARAM_ENV_WIND_SPD];
+		fWindRandomness = V[PARAM_ENV_WIND_DIR_RND];
+		fWindSpeed20feet = fTurbulenceLevel / 7.0f * 88.61f; // mean wind speed at 20ft in[ft / s]
+
+		loadTurbulenceField();
+	}
+}
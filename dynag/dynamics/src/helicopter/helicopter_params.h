@@ -0,0 +1,257 @@
+/*
+* DynaG Dynamics C++ / Helicopter Parameters
+*
+* Helicopter Parameters is a struct for storing parsed and derived parameters
+* of helicopter dynamics. It is immutable after it is calculated, so it is shared
+* between the instances which are created from the same yaml file. Instances
+* copy it only when one of its parameters is changed (copy-on-write).
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Compiled parameter values with dependency groups. // @MGokcayK
+* Update : 19/10/2026 - Sharing one turbulence lookup table between all parameters. // @MGokcayK
+* Update : 19/10/2026 - Optional shared frozen turbulence field. // @MGokcayK
+* Update : 19/10/2026 - Air density table for fast math kernels. // @MGokcayK
+*/
+
+#pragma once
+
+#include "../lookup.h"
+#include "../turbulence.h"
+#include "../utils.h"
+#include <stb/stb_image.h>
+#include <memory>
+#include <mutex>
+
+// Terrain maps which are loaded from images. It is immutable after loading, so
+// it is shared between the instances of helicopter dynamics.
+struct TerrainMap
+{
+	std::string sHeightMapPath, sNormalMapPath;
+	float fHeightScale;
+	Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> mHeightMap;
+	std::vector<std::vector<Eigen::Vector<float, 3>>> mNormalMap;
+};
+
+// Identifiers of compiled input parameters. They are the float values of yaml file
+// which are parsed once and can be changed without parsing yaml nodes again.
+enum HelicopterParamId
+{
+	// TRIM
+	PARAM_TRIM_YAW, PARAM_TRIM_YAW_RATE, PARAM_TRIM_N_VEL, PARAM_TRIM_E_VEL, PARAM_TRIM_D_VEL,
+	PARAM_TRIM_N_POS, PARAM_TRIM_E_POS, PARAM_TRIM_GR_ALT, PARAM_TRIM_PSI_MR, PARAM_TRIM_PSI_TR,
+	// ENV
+	PARAM_ENV_NS_MAX, PARAM_ENV_EW_MAX, PARAM_ENV_MAX_GR_ALT, PARAM_ENV_MIN_GR_ALT,
+	PARAM_ENV_GRAV, PARAM_ENV_T0, PARAM_ENV_LAPSE, PARAM_ENV_RO_SEA, PARAM_ENV_R,
+	PARAM_ENV_TURB_LVL, PARAM_ENV_WIND_DIR, PARAM_ENV_WIND_SPD, PARAM_ENV_WIND_DIR_RND,
+	// HELI
+	PARAM_HELI_COL_OS, PARAM_HELI_COL_H, PARAM_HELI_COL_L, PARAM_HELI_COL_COF,
+	PARAM_HELI_LON_H, PARAM_HELI_LON_L, PARAM_HELI_LON_COF,
+	PARAM_HELI_LAT_H, PARAM_HELI_LAT_L, PARAM_HELI_LAT_COF,
+	PARAM_HELI_PED_OS, PARAM_HELI_PED_H, PARAM_HELI_PED_L, PARAM_HELI_PED_COF,
+	PARAM_HELI_WL_CG, PARAM_HELI_FS_CG, PARAM_HELI_WT, PARAM_HELI_VTRANS, PARAM_HELI_HP_LOSS,
+	PARAM_HELI_IX, PARAM_HELI_IY, PARAM_HELI_IZ, PARAM_HELI_IXZ,
+	// MR
+	PARAM_MR_WL, PARAM_MR_FS, PARAM_MR_R, PARAM_MR_K1, PARAM_MR_TWST, PARAM_MR_E, PARAM_MR_IS,
+	PARAM_MR_RPM, PARAM_MR_CD0, PARAM_MR_B, PARAM_MR_C, PARAM_MR_A, PARAM_MR_IB,
+	// TR
+	PARAM_TR_WL, PARAM_TR_FS, PARAM_TR_R, PARAM_TR_TWST, PARAM_TR_RPM, PARAM_TR_CD0, 
+	PARAM_TR_B, PARAM_TR_C, PARAM_TR_A,
+	// FUS
+	PARAM_FUS_WL, PARAM_FUS_FS, PARAM_FUS_COR, PARAM_FUS_XUU, PARAM_FUS_YVV, PARAM_FUS_ZWW,
+	// HT
+	PARAM_HT_WL, PARAM_HT_FS, PARAM_HT_ZMAX, PARAM_HT_ZUU, PARAM_HT_ZUW,
+	// VT
+	PARAM_VT_WL, PARAM_VT_FS, PARAM_VT_YMAX, PARAM_VT_YUU, PARAM_VT_YUV,
+	// WN
+	PARAM_WN_WL, PARAM_WN_FS, PARAM_WN_ZMAX, PARAM_WN_ZUU, PARAM_WN_ZUW,
+	// LG
+	PARAM_LG_WL, PARAM_LG_FS, PARAM_LG_B, PARAM_LG_C, PARAM_LG_K, PARAM_LG_MU,
+	// FLG
+	PARAM_FLG_WL, PARAM_FLG_FS, PARAM_FLG_C, PARAM_FLG_K, PARAM_FLG_MU,
+
+	PARAM_COUNT
+};
+
+// Groups of derived parameters. Each input parameter marks the groups which depend on
+// it, so only these groups are calculated again after changing it.
+enum HelicopterParamGroup : unsigned int
+{
+	GROUP_TRIM			= 1u << 0,
+	GROUP_TERRAIN		= 1u << 1,
+	GROUP_AIR			= 1u << 2,
+	GROUP_INPUT			= 1u << 3,
+	GROUP_POSITION		= 1u << 4,
+	GROUP_MASS			= 1u << 5,
+	GROUP_INERTIA		= 1u << 6,
+	GROUP_MAIN_ROTOR	= 1u << 7,
+	GROUP_TAIL_ROTOR	= 1u << 8,
+	GROUP_AERO			= 1u << 9,
+	GROUP_LANDING_GEAR	= 1u << 10,
+	GROUP_WIND			= 1u << 11,
+	GROUP_ALL			= 0xFFFFFFFFu
+};
+
+// Yaml location and dependent groups of a compiled parameter.
+struct HelicopterParamInfo
+{
+	const char* cNode;
+	const char* cVariable;
+	unsigned int iGroups;
+};
+
+struct HelicopterParams
+{
+	// Path of yaml file which parameters are loaded from.
+	std::string sYamlPath;
+
+	// Yaml Nodes
+	YAML::Node DATA, HELI, ENV, TRIM, MR, TR, FUS, HT, VT, WN, LG, FLG;
+
+	// Compiled input parameters w.r.t `HelicopterParamId`.
+	float fValues[PARAM_COUNT];
+
+	// True if compiled or derived parameters are changed after syncing yaml nodes.
+	bool bNodesDirty = false;
+
+	// True if yaml nodes are shared with the parameters which this one is cloned from.
+	bool bSharedNodes = false;
+
+	// Trim variables
+	float YAW, YAW_RATE, N_VEL, E_VEL, D_VEL, N_POS, E_POS, GR_ALT, PSI_MR, PSI_TR;
+
+	// Component positions
+	float MR_H, MR_D, FUS_H, FUS_D, WN_H, WN_D, HT_H, HT_D, VT_H, VT_D, TR_H, TR_D;
+	float MR_R, MR_K1, TR_R, MR_TWST, TR_TWST;
+	float WL_CG, FS_CG;
+
+	// Vehicle
+	float M, WT; // mass
+	float VTRANS; // vertical transform
+	float HP_LOSS;
+	Eigen::Vector<float, 3> vWeight;
+
+	// Gravity Constant
+	float GRAV;
+
+	// Main Rotor params
+	float MR_OMEGA, MR_V_TIP, MR_FR, MR_SOL, MR_A_SIGMA;
+	float MR_GAM_OM16_DRO, MR_DL_DB1, MR_DL_DA1_DRO, MR_COEF_TH;
+	float MR_E, MR_IS;
+
+	// Tail Rotor params
+	float TR_OMEGA, TR_V_TIP, TR_FR, TR_SOL, TR_COEF_TH;
+
+	// Fuselage params
+	float FUS_COR, FUS_XUU, FUS_YVV, FUS_ZWW;
+
+	// Horizontal Tail params
+	float HT_ZMAX, HT_ZUU, HT_ZUW;
+
+	// Vertical Tail params
+	float VT_YMAX, VT_YUU, VT_YUV;
+
+	// Wing params
+	float WN_ZMAX, WN_ZUU, WN_ZUW;
+
+	// Landing Gear params
+	float LG_H, LG_D;
+	float LG_C, LG_K;
+	float LG_B;
+	float LG_MU;
+	Eigen::Vector<float, 3> vLeftLandingGearBodyPosition, vRightLandingGearBodyPosition;
+
+	// Front Landing Gear params
+	float FLG_H, FLG_D;
+	float FLG_C, FLG_K;
+	float FLG_MU;
+	Eigen::Vector<float, 3> vFrontLandingGearBodyPosition;
+
+	// Input params
+	float COL_OS, COL_H, COL_L, COL_COF;
+	float LON_H, LON_L, LON_COF;
+	float LAT_H, LAT_L, LAT_COF;
+	float PED_OS, PED_H, PED_L, PED_COF;
+
+	// Inertia and Its Reverse;
+	Eigen::Matrix<float, 3, 3, Eigen::RowMajor> I, IINV;
+
+	// Air properties
+	float T0, LAPSE, RO_SEA, R;
+
+	// Air density table w.r.t altitude [ft]. It is used by fast math kernels instead of
+	// `powf` in its altitude range.
+	static constexpr float AIR_TABLE_MIN_ALT = -1000.0f, AIR_TABLE_MAX_ALT = 40000.0f, AIR_TABLE_STEP = 50.0f;
+	LookUpTable<1> ltAirDensity;
+
+	// Terrain map props
+	float NS_MAX, EW_MAX;
+	float MAX_GR_ALT, MIN_GR_ALT;
+	float fXPerPixel, fYPerPixel; // terrain x & y size per pixel
+	std::shared_ptr<const TerrainMap> spTerrain;
+
+	// Wind params
+	float fTurbulenceLevel, fWindDirection, fWindSpeed, fWindRandomness, fWindSpeed20feet;
+
+	// Turbulence Exceedence Probability Lookup Table w.r.t turbulence level and altitude. 
+	// It does not depend on yaml file, so one table is shared by all parameters.
+	static const LookUpTable<2>& getTurbulenceExceedenceProbability();
+
+	// Frozen turbulence field which is sampled by position instead of running Dryden filters.
+	// It is null unless `TURB_FIELD` of yaml file is 1. If `fTurbulenceFieldRandomness` is 1,
+	// each reset moves the instance to a random place of the field.
+	std::shared_ptr<const TurbulenceField> spTurbulenceField;
+	float fTurbulenceFieldRandomness = 0.0f;
+
+	// Loading parameters of yaml file. Parameters are cached w.r.t path of the file,
+	// so the file is parsed once while an instance which uses it is alive.
+	static std::shared_ptr<const HelicopterParams> load(const std::string& sYamlPath);
+
+	// Copy of parameters which is used before changing parameters of an instance 
+	// without affecting the other instances. Yaml nodes are cloned on first write.
+	std::shared_ptr<HelicopterParams> clone() const;
+
+	// Cloning yaml nodes if they are shared.
+	void ownNodes();
+
+	// Setting yaml nodes from root node of yaml file.
+	void setNodes(const YAML::Node& data);
+
+	// Compiling input parameters from yaml nodes into `fValues`.
+	void compile();
+
+	// Calculating derived parameters of `iGroups` from compiled input parameters.
+	void calculate(unsigned int iGroups = GROUP_ALL);
+
+	// Setting compiled input parameter. It returns the groups which should be calculated
+	// again. Yaml nodes are not changed until `syncNodes` is called.
+	unsigned int setParameter(int iId, float fValue);
+
+	// Writing compiled and derived parameters into own yaml nodes.
+	void syncNodes();
+
+	// Getting yaml location and groups of compiled parameter.
+	static const HelicopterParamInfo& getParameterInfo(int iId);
+
+	// Finding compiled parameter w.r.t node name and variable name. It returns -1 if
+	// the variable is not compiled.
+	static int findParameter(const std::string& sNodeName, const std::string& sVariableName);
+
+private:
+	// Getting yaml node w.r.t its name.
+	YAML::Node& getNode(const std::string& sNodeName);
+
+	// Loading terrain maps if they are not loaded or their yaml values are changed.
+	void loadTerrain();
+
+	// Loading turbulence field w.r.t optional yaml values. Field is shared if they are not changed.
+	void loadTurbulenceField();
+
+	// Set HeightMap Matrix from Height Map Image.
+	static void setHeightMapMatrixFromHeightMapImage(Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& mTarget, unsigned short* shImagePtr, int& iH, int& iW);
+
+	// Set NormalMap Matrix from Normal Map Image.
+	static void setNormalMapMatrixFromNormalMapImage(std::vector<std::vector<Eigen::Vector<float, 3>>>& mTarget, unsigned char* cImagePtr, int& iH, int& iW, int& iC);
+};
@@ -0,0 +1,76 @@
+#include "helicopter_pool.h"
+
+HelicopterPool::~HelicopterPool()
+{
+	clear();
+}
+
+HelicopterPool& HelicopterPool::instance()
+{
+	static HelicopterPool pool;
+	return pool;
+}
+
+HelicopterDynamics* HelicopterPool::acquire(const std::string& sYamlPath, float* fDtPtr)
+{
+	HelicopterDynamics* HD = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(mtxPool);
+		std::vector<HelicopterDynamics*>& vFree = mapFree[sYamlPath];
+		if (!vFree.empty())
+		{
+			HD = vFree.back();
+			vFree.pop_back();
+		}
+	}
+
+	// Parameters are taken from cache, so changed parameters of recycled instance
+	// are dropped and yaml file is not parsed again.
+	if (HD) HD->reinitialize(HelicopterParams::load(sYamlPath), fDtPtr);
+	else HD = new HelicopterDynamics(HelicopterParams::load(sYamlPath), fDtPtr);
+	return HD;
+}
+
+void HelicopterPool::release(HelicopterDynamics* HD)
+{
+	if (!HD) return;
+	{
+		std::lock_guard<std::mutex> lock(mtxPool);
+		std::vector<HelicopterDynamics*>& vFree = mapFree[HD->getParams()->sYamlPath];
+		if ((int)vFree.size() < iCapacity)
+		{
+			vFree.push_back(HD);
+			return;
+		}
+	}
+	delete HD;
+}
+
+void HelicopterPool::setCapacity(int iCapacity)
+{
+	std::vector<HelicopterDynamics*> vExtra;
+	{
+		std::lock_guard<std::mutex> lock(mtxPool);
+		this->iCapacity = std::max(iCapacity, 0);
+		for (auto& it : mapFree)
+		{
+			while ((int)it.second.size() > this->iCapacity)
+			{
+				vExtra.push_back(it.second.back());
+				it.second.pop_back();
+			}
+		}
+	}
+	for (HelicopterDynamics* HD : vExtra) delete HD;
+}
+
+void HelicopterPool::clear()
+{
+	std::unordered_map<std::string, std::vector<HelicopterDynamics*>> mapRemoved;
+	{
+		std::lock_guard<std::mutex> lock(mtxPool);
+		mapRemoved.swap(mapFree);
+	}
+	for (auto& it : mapRemoved)
+		for (HelicopterDynamics* HD : it.second) delete HD;
+}
@@ -0,0 +1,55 @@
+/*
+* DynaG Dynamics C++ / Helicopter Pool
+*
+* Helicopter Pool keeps released helicopter dynamics instances and recycles them
+* for the next instance of the same yaml file. Recycled instances are re-initialized
+* in place, so creating an environment in a long-lived worker does not allocate and
+* the number of alive instances stays bounded by the capacity of the pool.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+*/
+
+#pragma once
+
+#include "helicopter_dynamics.h"
+#include <algorithm>
+
+class HelicopterPool
+{
+private:
+	std::mutex mtxPool;
+
+	// Released instances w.r.t path of their yaml file.
+	std::unordered_map<std::string, std::vector<HelicopterDynamics*>> mapFree;
+
+	// Maximum number of released instances which are kept for each yaml file.
+	int iCapacity = 64;
+
+	HelicopterPool() {};
+
+public:
+	HelicopterPool(const HelicopterPool&) = delete;
+	void operator=(const HelicopterPool&) = delete;
+
+	// Deleting kept instances.
+	~HelicopterPool();
+
+	// Getting pool of the process.
+	static HelicopterPool& instance();
+
+	// Getting an instance of yaml file. Released instance is re-initialized if it
+	// exists, otherwise new instance is created.
+	HelicopterDynamics* acquire(const std::string& sYamlPath, float* fDtPtr);
+
+	// Releasing instance into pool. It is deleted if pool is full.
+	void release(HelicopterDynamics* HD);
+
+	// Setting maximum number of kept instances for each yaml file. Extra instances are deleted.
+	void setCapacity(int iCapacity);
+
+	// Deleting all kept instances.
+	void clear();
+};
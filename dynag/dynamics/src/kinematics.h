@@ -8,44 +8,164 @@
 * C.Date : 17/09/2021
 * Update : 17/09/2021 - Create & Implementation // @MGokcayK
 * Update : 23/11/2020 - Adding Quaternion Implementations // @MGokcayK
+* Update : 19/10/2026 - Inline thread-safe kernels without global scratch & batched variants // @MGokcayK
+* Update : 19/10/2026 - Fast math variants of hot kernels // @MGokcayK
+* Update : 19/10/2026 - Templating kernels on scalar type // @MGokcayK
 */
 
 /*
 * DIFFERENCE BETWEEN DIRECTION COSINE MATRIX (DCM) & ROTATION MATRIX (ROTMAT)
-* 
-* Rotmat rotates the point in fixed frame. On the other hand, DCM rotates the 
+*
+* Rotmat rotates the point in fixed frame. On the other hand, DCM rotates the
 * frame. This make the difference between them. As a mathematical expression,
 * DCM is a conjugate of Rotmat.
 */
 
+/*
+* THREAD SAFETY
+*
+* All functions only use their arguments and local variables. They do not
+* allocate and they do not touch any shared state, so they can be called
+* concurrently for different instances.
+*/
+
 #pragma once
 
 #include <Eigen/Eigen/Geometry>
 #include <Eigen/Eigen/Dense>
 #include <iostream>
 #include "utils.h"
+#include "fastmath.h"
 
 // Calculate DCM from Euler angles.
-void euler2DCM(Eigen::Matrix<float, 3, 3, Eigen::RowMajor>& mTarget, const Eigen::Vector3f& vEulerAngles);
+template<typename T>
+inline void euler2DCM(Eigen::Matrix<T, 3, 3, Eigen::RowMajor>& mTarget, const Eigen::Vector<T, 3>& vEulerAngles) noexcept
+{
+    const T sphi = std::sin(vEulerAngles[0]), cphi = std::cos(vEulerAngles[0]);
+    const T sthe = std::sin(vEulerAngles[1]), cthe = std::cos(vEulerAngles[1]);
+    const T spsi = std::sin(vEulerAngles[2]), cpsi = std::cos(vEulerAngles[2]);
+
+    // Expanded form of Rot(phi) * Rot(theta) * Rot(psi).
+    mTarget(0, 0) =  cthe * cpsi;
+    mTarget(0, 1) =  cthe * spsi;
+    mTarget(0, 2) = -sthe;
+    mTarget(1, 0) =  sphi * sthe * cpsi - cphi * spsi;
+    mTarget(1, 1) =  sphi * sthe * spsi + cphi * cpsi;
+    mTarget(1, 2) =  sphi * cthe;
+    mTarget(2, 0) =  cphi * sthe * cpsi + sphi * spsi;
+    mTarget(2, 1) =  cphi * sthe * spsi - sphi * cpsi;
+    mTarget(2, 2) =  cphi * cthe;
+}
 
 // Calculate Euler angles from DCM.
-void DCM2Euler(Eigen::Vector3f& vEulerAngles, const Eigen::Matrix<float, 3, 3, Eigen::RowMajor>& DCM);
+template<typename T>
+inline void DCM2Euler(Eigen::Vector<T, 3>& vEulerAngles, const Eigen::Matrix<T, 3, 3, Eigen::RowMajor>& DCM) noexcept
+{
+    vEulerAngles(2) = std::atan2(DCM(0, 1), DCM(0, 0));
+    vEulerAngles(1) = std::asin(-DCM(0, 2));
+    vEulerAngles(0) = std::atan2(DCM(1, 2), DCM(2, 2));
+}
+
+// Calculate Euler angle derivatives. `FAST_MATH` selects polynomial approximations.
+template<bool FAST_MATH = false, typename T>
+inline void pqr2EulerDot(Eigen::Matrix<T, 3, 3, Eigen::RowMajor>& mTarget, const Eigen::Vector<T, 3>& vEulerAngles) noexcept
+{
+    T sphi, cphi, sthe, cthe;
+    MathKernels<FAST_MATH>::sincos(vEulerAngles[0], sphi, cphi);
+    MathKernels<FAST_MATH>::sincos(vEulerAngles[1], sthe, cthe);
+    const T icthe = 1.0f / (cthe + 1e-7f);
+
+    mTarget(0, 0) = 1.0f;
+    mTarget(0, 1) = sphi * sthe * icthe;
+    mTarget(0, 2) = cphi * sthe * icthe;
+
+    mTarget(1, 0) = 0.0f;
+    mTarget(1, 1) =  cphi;
+    mTarget(1, 2) = -sphi;
 
-// Calculate Euler angle derivatives.
-void pqr2EulerDot(Eigen::Matrix<float, 3, 3, Eigen::RowMajor>& mTarget, const Eigen::Vector3f& vEulerAngles);
+    mTarget(2, 0) = 0.0f;
+    mTarget(2, 1) = sphi * icthe;
+    mTarget(2, 2) = cphi * icthe;
+}
 
 // Convert Euler angles to Quaternion.
-void euler2Quaternion(Eigen::Vector<float, 4>& vQuat, const Eigen::Vector3f& vEulerAngles);
+template<typename T>
+inline void euler2Quaternion(Eigen::Vector<T, 4>& vQuat, const Eigen::Vector<T, 3>& vEulerAngles) noexcept
+{
+    const Eigen::Quaternion<T> qQ = Eigen::AngleAxis<T>(vEulerAngles[2], Eigen::Vector<T, 3>::UnitZ())
+                                  * Eigen::AngleAxis<T>(vEulerAngles[1], Eigen::Vector<T, 3>::UnitY())
+                                  * Eigen::AngleAxis<T>(vEulerAngles[0], Eigen::Vector<T, 3>::UnitX());
+    vQuat = qQ.coeffs();
+}
 
 // Calculate quaternion derivatives w.r.t pqr.
-void pqr2QuaternionDot(Eigen::Vector<float, 4>& vQuatDot, const Eigen::Vector<float, 4>& vQuat, const Eigen::Vector3f& vPQR);
+template<typename T>
+inline void pqr2QuaternionDot(Eigen::Vector<T, 4>& vQuatDot, const Eigen::Vector<T, 4>& vQuat, const Eigen::Vector<T, 3>& vPQR) noexcept
+{
+    // 0.5 * q * (p, q, r, 0) where quaternions are stored as (x, y, z, w).
+    const T x = vQuat(0), y = vQuat(1), z = vQuat(2), w = vQuat(3);
+    vQuatDot(0) = 0.5f * ( w * vPQR(0) - z * vPQR(1) + y * vPQR(2));
+    vQuatDot(1) = 0.5f * ( z * vPQR(0) + w * vPQR(1) - x * vPQR(2));
+    vQuatDot(2) = 0.5f * (-y * vPQR(0) + x * vPQR(1) + w * vPQR(2));
+    vQuatDot(3) = 0.5f * (-x * vPQR(0) - y * vPQR(1) - z * vPQR(2));
+}
 
 // Calculate DCM from Quaternions
-void quaternion2DCM(Eigen::Matrix<float, 3, 3, Eigen::RowMajor>& mTarget, const Eigen::Vector<float, 4>& vQuat);
+template<typename T>
+inline void quaternion2DCM(Eigen::Matrix<T, 3, 3, Eigen::RowMajor>& mTarget, const Eigen::Vector<T, 4>& vQuat) noexcept
+{
+    const Eigen::Vector<T, 4> q = vQuat.normalized();
+    const T x = q(0), y = q(1), z = q(2), w = q(3);
+
+    mTarget(0, 0) = w * w + x * x - y * y - z * z;
+    mTarget(0, 1) = 2.0f * (x * y + w * z);
+    mTarget(0, 2) = 2.0f * (x * z - w * y);
+
+    mTarget(1, 0) = 2.0f * (x * y - w * z);
+    mTarget(1, 1) = w * w - x * x + y * y - z * z;
+    mTarget(1, 2) = 2.0f * (y * z + w * x);
+
+    mTarget(2, 0) = 2.0f * (x * z + w * y);
+    mTarget(2, 1) = 2.0f * (y * z - w * x);
+    mTarget(2, 2) = w * w - x * x - y * y + z * z;
+}
 
 // Calculate Euler angles from quaternion.
-void quaternion2Euler(Eigen::Vector3f& vEulerAngles, const Eigen::Vector<float, 4>& vQuat);
+template<typename T>
+inline void quaternion2Euler(Eigen::Vector<T, 3>& vEulerAngles, const Eigen::Vector<T, 4>& vQuat) noexcept
+{
+    Eigen::Matrix<T, 3, 3, Eigen::RowMajor> DCM;
+    quaternion2DCM(DCM, vQuat);
+    DCM2Euler(vEulerAngles, DCM);
+}
+
+// Calculate Euler angles from unit quaternion. `FAST_MATH` selects polynomial approximations.
+template<bool FAST_MATH = false, typename T>
+inline void unitQuaternion2Euler(Eigen::Vector<T, 3>& vEulerAngles, const Eigen::Vector<T, 4>& vQuat) noexcept
+{
+    const Eigen::Vector<T, 4> q = vQuat.normalized();
+    const T x = q(0), y = q(1), z = q(2), w = q(3);
+    const T sqx = x * x;
+    const T sqy = y * y;
+    const T sqz = z * z;
+    const T sqw = w * w;
+
+    vEulerAngles(0) = MathKernels<FAST_MATH>::atan2(2.0f * (y * z + w * x), sqw + sqz - sqx - sqy);
+    vEulerAngles(1) = -MathKernels<FAST_MATH>::asin(2.0f * (x * z - w * y));
+    vEulerAngles(2) = MathKernels<FAST_MATH>::atan2(2.0f * (x * y + w * z), sqw + sqx - sqy - sqz);
+}
+
+/*
+* BATCHED VARIANTS
+*
+* Batched variants work on N instances which are stored as structure of arrays.
+* Component `c` of instance `k` is stored at `c * iCount + k`. Quaternions have
+* 4 components as (x, y, z, w), Euler angles have 3 components as (phi, theta,
+* psi) and DCMs have 9 components in row-major order.
+*/
 
-// Calculate Euler angles from unit quaternion.
-void unitQuaternion2Euler(Eigen::Vector3f& vEulerAngles, const Eigen::Vector<float, 4>& vQuat);
+// Calculate DCMs from N quaternions.
+void quaternion2DCM(float* mTarget, const float* vQuat, int iCount) noexcept;
 
+// Calculate Euler angles from N unit quaternions. Fast math variant is vectorized by the compiler.
+void unitQuaternion2Euler(float* vEulerAngles, const float* vQuat, int iCount, bool bFastMath = false) noexcept;
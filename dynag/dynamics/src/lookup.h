@@ -1,44 +1,207 @@
 /*
 * DynaG Dynamics C++ / Lookup
 *
-* Lookup class for implementing a lookup table for 1D or 2D tables.
-* 
+* Lookup class for implementing a lookup table for N-D tables.
+*
 * It is based on https://jsbsim-team.github.io/jsbsim/FGTable_8cpp_source.html.
 *
 * Author : @MGokcayK
 *
 * C.Date : 21/09/2021
 * Update : 21/09/2021 - Class Initialization & Implementation // @MGokcayK
+* Update : 19/10/2026 - Immutable N-D table with caller-owned hints, uniform grid path and batched queries. // @MGokcayK
+*/
+
+/*
+* THREAD SAFETY
+*
+* Table is immutable after it is constructed. Search hints are owned by the caller,
+* so one table can be shared and queried concurrently by all instances. Result of
+* a query does not depend on the hint, the hint only shortens the search.
 */
 
 #pragma once
 
-#include <Eigen/Eigen/Dense>
-#include <iostream>
+#include "utils.h"
+#include <array>
+#include <algorithm>
 
+template<int N>
 class LookUpTable
 {
-	// Table dims and params
-	int nRows, nCols, rowCounter, colCounter, lastRowIndex, lastColIndex;
+public:
+	// Search hint of queries which is owned by the caller. It stores the last upper
+	// breakpoint index of each dimension.
+	struct Hint
+	{
+		int iIndex[N];
+		Hint() { for (int d = 0; d < N; d++) iIndex[d] = 1; }
+	};
 
-	// Table data
-	Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> data;
+	// Empty table.
+	LookUpTable() {}
 
-public:
+	// Construct table from breakpoints of each dimension and values. Breakpoints should be
+	// strictly increasing and have at least two elements. Values are in row-major order,
+	// so the last dimension changes fastest.
+	LookUpTable(const std::array<std::vector<float>, N>& vBreakpoints, const std::vector<float>& vValues)
+		: vBreakpoints(vBreakpoints), vValues(vValues)
+	{
+		try
+		{
+			int iSize = 1;
+			for (int d = N - 1; d >= 0; d--)
+			{
+				const std::vector<float>& vBp = vBreakpoints[d];
+				if (vBp.size() < 2)
+					gThrow("Lookup Error : Dimension " + std::to_string(d) + " of table should have at least two breakpoints!");
+
+				bool bUniform = true;
+				float fStep = (vBp.back() - vBp.front()) / (vBp.size() - 1);
+				for (size_t i = 1; i < vBp.size(); i++)
+				{
+					if (!(vBp[i] > vBp[i - 1]))
+						gThrow("Lookup Error : Breakpoints of dimension " + std::to_string(d) + " are not strictly increasing!");
+					if (std::fabs((vBp[i] - vBp[i - 1]) - fStep) > 1e-6f * std::fabs(fStep)) bUniform = false;
+				}
+
+				iStrides[d] = iSize;
+				iSize *= (int)vBp.size();
+				bUniformGrid[d] = bUniform;
+				fInverseStep[d] = 1.0f / fStep;
+			}
+
+			if (iSize != (int)vValues.size())
+				gThrow("Lookup Error : Table has " + std::to_string(vValues.size()) + " values, but its breakpoints need " + std::to_string(iSize) + "!");
+		}
+		catch (std::exception& e) {
+			std::cerr << e.what() << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+	}
+
+	// Getting value w.r.t keys of each dimension. Search starts from `hint` and `hint` is
+	// updated for the next query. Keys out of table are clamped, table does not extrapolate.
+	float get(const std::array<float, N>& fKeys, Hint& hint) const
+	{
+		float fFactors[N];
+		for (int d = 0; d < N; d++)
+		{
+			hint.iIndex[d] = findInterval(d, fKeys[d], hint.iIndex[d]);
+			fFactors[d] = getFactor(d, fKeys[d], hint.iIndex[d]);
+		}
+		return interpolate(hint.iIndex, fFactors);
+	}
 
-	// Construct table w.r.t row and column number.
-	LookUpTable(const int& Rows = 1, const int& Cols = 1);
+	// Getting value w.r.t keys of each dimension without hint.
+	float get(const std::array<float, N>& fKeys) const
+	{
+		Hint hint;
+		for (int d = 0; d < N; d++) hint.iIndex[d] = searchInterval(d, fKeys[d]);
+		return get(fKeys, hint);
+	}
 
-	// Shift operator to table which add the values into the table.
-	LookUpTable& operator<<(const float& n);
+	// Getting values of `iCount` queries. Keys are stored as structure of arrays, so key of
+	// dimension `d` of query `k` is `fKeys[d * iCount + k]`. Queries share one hint, so
+	// sorted or slowly changing keys are found in a few steps.
+	void get(const float* fKeys, float* fValues, int iCount) const
+	{
+		Hint hint;
+		std::array<float, N> fQuery;
+		for (int k = 0; k < iCount; k++)
+		{
+			for (int d = 0; d < N; d++) fQuery[d] = fKeys[d * iCount + k];
+			fValues[k] = get(fQuery, hint);
+		}
+	}
 
-	// Getting element w.r.t key in 1D table.
-	float get_value_1D(const float& key);
+	// Getting number of breakpoints of dimension.
+	int getSize(int iDim) const { return (int)vBreakpoints[iDim].size(); }
+
+	// Getting breakpoints of dimension.
+	const std::vector<float>& getBreakpoints(int iDim) const { return vBreakpoints[iDim]; }
 
-	// Getting element w.r.t row and column key in 2D table.
-	float get_value_2D(const float& rowKey, const float& colKey);
-	
 	// Print the table.
-	void print_table();
+	void print_table() const
+	{
+		std::cout << N << "D table with sizes";
+		for (int d = 0; d < N; d++) std::cout << " " << vBreakpoints[d].size();
+		std::cout << " : " << std::endl;
+		for (size_t i = 0; i < vValues.size(); i++)
+			std::cout << vValues[i] << (((i + 1) % vBreakpoints[N - 1].size() == 0) ? "\n" : " ");
+	}
+
+private:
+	// Table data
+	std::array<std::vector<float>, N> vBreakpoints;
+	std::vector<float> vValues;
+
+	// Table dims and params
+	std::array<int, N> iStrides = {};
+	std::array<bool, N> bUniformGrid = {};
+	std::array<float, N> fInverseStep = {};
+
+	// Finding upper breakpoint index of interval which contains the key by walking from
+	// the hint. Uniform grids start from the computed index, so they are found in O(1).
+	// Result is the first breakpoint which is not less than the key, in [1, size - 1].
+	int findInterval(int iDim, float fKey, int iHint) const
+	{
+		const std::vector<float>& vBp = vBreakpoints[iDim];
+		const int iLast = (int)vBp.size() - 1;
+
+		int u = iHint;
+		if (bUniformGrid[iDim])
+		{
+			// Truncation is enough for the start, walk below fixes the rounding.
+			float fPosition = (fKey - vBp[0]) * fInverseStep[iDim];
+			if (fPosition >= 0.0f && fPosition < (float)iLast) u = (int)fPosition + 1;
+		}
+		if (u < 1 || u > iLast) u = 1;
+
+		while (u > 1 && vBp[u - 1] >= fKey) u--;
+		while (u < iLast && vBp[u] < fKey) u++;
+		return u;
+	}
+
+	// Finding upper breakpoint index of interval with binary search.
+	int searchInterval(int iDim, float fKey) const
+	{
+		const std::vector<float>& vBp = vBreakpoints[iDim];
+		int u = (int)(std::lower_bound(vBp.begin(), vBp.end(), fKey) - vBp.begin());
+		return std::min(std::max(u, 1), (int)vBp.size() - 1);
+	}
+
+	// Getting interpolation factor of key in interval. It is clamped into [0, 1].
+	float getFactor(int iDim, float fKey, int u) const
+	{
+		const std::vector<float>& vBp = vBreakpoints[iDim];
+		float fFactor = (fKey - vBp[u - 1]) / (vBp[u] - vBp[u - 1]);
+		if (fFactor > 1.0f) fFactor = 1.0f;
+		else if (fFactor < 0.0f) fFactor = 0.0f;
+		return fFactor;
+	}
+
+	// Interpolating corners of cell. Dimensions are interpolated in order, first one first.
+	float interpolate(const int* iUpper, const float* fFactors) const
+	{
+		int iBase = 0;
+		for (int d = 0; d < N; d++) iBase += (iUpper[d] - 1) * iStrides[d];
+		const float* fCell = vValues.data() + iBase;
+
+		float fCorners[1 << N];
+		for (int c = 0; c < (1 << N); c++)
+		{
+			int iOffset = 0;
+			for (int d = 0; d < N; d++) iOffset += ((c >> d) & 1) * iStrides[d];
+			fCorners[c] = fCell[iOffset];
+		}
 
-};
\ No newline at end of file
+		for (int d = 0; d < N; d++)
+		{
+			const int iHalf = 1 << (N - d - 1);
+			for (int c = 0; c < iHalf; c++)
+				fCorners[c] = fFactors[d] * (fCorners[2 * c + 1] - fCorners[2 * c]) + fCorners[2 * c];
+		}
+		return fCorners[0];
+	}
+};
@@ -0,0 +1,118 @@
+/*
+* DynaG Dynamics C++ / Profiler
+*
+* Per-instance profiling counters of dynamic systems. Sections of a step are timed
+* with timestamp counter and accumulated into the instance which is stepped, so
+* there is no lock or shared state. Timers are compiled only if `DYNAG_PROFILE`
+* is defined as non-zero, otherwise the macros are empty and cost nothing.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Adding fast states section of multi-rate integration. // @MGokcayK
+*/
+
+#pragma once
+
+#ifndef DYNAG_PROFILE
+	#define DYNAG_PROFILE 0
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <x86intrin.h>
+#else
+	#include <chrono>
+#endif
+
+// Profiled sections of a step. Sections are inclusive, e.g. `SECTION_TERRAIN` is
+// also counted in `SECTION_LANDING_GEAR` for landing gear contact points.
+enum DynamicsSection
+{
+	SECTION_STEP = 0,		// Whole step
+	SECTION_GLUE,			// VectorSpace get/set of states, state dots, actions and observations
+	SECTION_RK4,			// RK4 stage and final combinations
+	SECTION_KINEMATICS,		// DCM, quaternion and euler angle calculations
+	SECTION_TURBULENCE,		// Wind and turbulence
+	SECTION_TERRAIN,		// Ground height and normal lookups
+	SECTION_MAIN_ROTOR,
+	SECTION_TAIL_ROTOR,
+	SECTION_FUSELAGE,
+	SECTION_HORIZONTAL_TAIL,
+	SECTION_VERTICAL_TAIL,
+	SECTION_WING,
+	SECTION_LANDING_GEAR,
+	SECTION_FAST_STATES,	// Sub-steps of fast states in multi-rate integration
+	SECTION_COUNT
+};
+
+// Reading timestamp counter. It falls back to steady clock in nanoseconds when
+// there is no timestamp counter.
+inline unsigned long long readTimestampCounter()
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#elif defined(__aarch64__)
+	unsigned long long iTicks;
+	asm volatile("mrs %0, cntvct_el0" : "=r"(iTicks));
+	return iTicks;
+#else
+	return (unsigned long long)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+// Accumulated ticks and calls of each section.
+struct DynamicsProfile
+{
+	unsigned long long iTicks[SECTION_COUNT] = { 0 };
+	unsigned long long iCalls[SECTION_COUNT] = { 0 };
+
+	// Adding measured ticks into section.
+	void add(int iSection, unsigned long long iElapsed)
+	{
+		iTicks[iSection] += iElapsed;
+		iCalls[iSection] += 1;
+	}
+
+	// Clearing all counters.
+	void reset()
+	{
+		for (int i = 0; i < SECTION_COUNT; i++) iTicks[i] = iCalls[i] = 0;
+	}
+
+	// Getting name of section.
+	static const char* getSectionName(int iSection)
+	{
+		static const char* cNames[SECTION_COUNT] = {
+			"step", "glue", "rk4", "kinematics", "turbulence", "terrain", "main_rotor", "tail_rotor",
+			"fuselage", "horizontal_tail", "vertical_tail", "wing", "landing_gear", "fast_states" };
+		return cNames[iSection];
+	}
+};
+
+// Timer which adds its lifetime into section of profile.
+struct ScopedProfileTimer
+{
+	DynamicsProfile& profile;
+	int iSection;
+	unsigned long long iStart;
+
+	ScopedProfileTimer(DynamicsProfile& profile, int iSection) : profile(profile), iSection(iSection), iStart(readTimestampCounter()) {}
+	~ScopedProfileTimer() { profile.add(iSection, readTimestampCounter() - iStart); }
+};
+
+// Profiling macros. `DYNAG_PROFILE_SCOPE` times the rest of the scope, `DYNAG_PROFILE_BEGIN`
+// and `DYNAG_PROFILE_END` time the statements between them.
+#if DYNAG_PROFILE
+	#define DYNAG_PROFILE_SCOPE(profile, section) ScopedProfileTimer profileTimer_##section(profile, section)
+	#define DYNAG_PROFILE_BEGIN(name) const unsigned long long name = readTimestampCounter()
+	#define DYNAG_PROFILE_END(profile, section, name) (profile).add(section, readTimestampCounter() - (name))
+#else
+	#define DYNAG_PROFILE_SCOPE(profile, section)
+	#define DYNAG_PROFILE_BEGIN(name)
+	#define DYNAG_PROFILE_END(profile, section, name)
+#endif
@@ -0,0 +1,137 @@
+#include "reset_pool.h"
+
+ResetPool::ResetPool(DynamicSystem* DS, const std::vector<RandomParameter>& vParameters, int iCapacity, int iWorkers, unsigned int iSeed)
+	: vParameters(vParameters), iCapacity(std::max(iCapacity, 1)), mGenerator(iSeed)
+{
+	try
+	{
+		for (const RandomParameter& parameter : vParameters)
+		{
+			if (parameter.iDistribution != DISTRIBUTION_UNIFORM && parameter.iDistribution != DISTRIBUTION_NORMAL)
+				gThrow("Reset Pool Error : Distribution `" + std::to_string(parameter.iDistribution) + "` is not defined!");
+			if (parameter.iDistribution == DISTRIBUTION_UNIFORM && !(parameter.fB >= parameter.fA))
+				gThrow("Reset Pool Error : Upper bound of uniform parameter `" + std::to_string(parameter.iId) + "` should not be less than its lower bound!");
+			if (parameter.iDistribution == DISTRIBUTION_NORMAL && !(parameter.fB > 0.0f))
+				gThrow("Reset Pool Error : Standard deviation of normal parameter `" + std::to_string(parameter.iId) + "` should be positive!");
+		}
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	for (const RandomParameter& parameter : vParameters) vIds.push_back(parameter.iId);
+
+	// Clones are created in this thread, since cloning syncs parameters of `DS`.
+	for (int i = 0; i < iWorkers; i++) vWorkerSystems.push_back(DS->clone());
+	for (DynamicSystem* worker : vWorkerSystems) vWorkers.emplace_back(&ResetPool::work, this, worker);
+}
+
+ResetPool::~ResetPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mtxPool);
+		bStop = true;
+	}
+	cvSpace.notify_all();
+	for (std::thread& worker : vWorkers) worker.join();
+	for (DynamicSystem* DS : vWorkerSystems) delete DS;
+}
+
+void ResetPool::reset(DynamicSystem* DS)
+{
+	Entry entry;
+	std::vector<float> vValues;
+	unsigned int iSeed = 0;
+	bool bFound = false;
+	{
+		std::lock_guard<std::mutex> lock(mtxPool);
+		if (!dqReady.empty())
+		{
+			entry = std::move(dqReady.front());
+			dqReady.pop_front();
+			bFound = true;
+		}
+		else
+		{
+			iMisses++;
+			sample(vValues, iSeed);
+		}
+	}
+
+	if (!bFound)
+	{
+		resetWithSample(DS, vValues, iSeed);
+		return;
+	}
+	cvSpace.notify_one();
+	if (!vIds.empty()) DS->setParameters(vIds.data(), entry.vValues.data(), (int)vIds.size());
+	DS->loadState(entry.vState.data());
+}
+
+int ResetPool::getSize()
+{
+	std::lock_guard<std::mutex> lock(mtxPool);
+	return (int)dqReady.size();
+}
+
+int ResetPool::getMisses()
+{
+	std::lock_guard<std::mutex> lock(mtxPool);
+	return iMisses;
+}
+
+void ResetPool::sample(std::vector<float>& vValues, unsigned int& iSeed)
+{
+	vValues.resize(vParameters.size());
+	for (size_t i = 0; i < vParameters.size(); i++)
+	{
+		const RandomParameter& parameter = vParameters[i];
+		float fValue;
+		if (parameter.iDistribution == DISTRIBUTION_NORMAL)
+			fValue = std::normal_distribution<float>(parameter.fA, parameter.fB)(mGenerator);
+		else
+			fValue = std::uniform_real_distribution<float>(parameter.fA, parameter.fB)(mGenerator);
+		vValues[i] = std::min(std::max(fValue, parameter.fMin), parameter.fMax);
+	}
+	// Each state has its own seed, so turbulence of pooled states is not correlated.
+	iSeed = mGenerator();
+}
+
+void ResetPool::resetWithSample(DynamicSystem* DS, const std::vector<float>& vValues, unsigned int iSeed)
+{
+	if (!vIds.empty()) DS->setParameters(vIds.data(), vValues.data(), (int)vIds.size());
+	DS->setSeed(iSeed);
+	DS->reset();
+}
+
+void ResetPool::work(DynamicSystem* DS)
+{
+	std::vector<float> vValues;
+	unsigned int iSeed = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mtxPool);
+			cvSpace.wait(lock, [this] { return bStop || (int)dqReady.size() + iPending < iCapacity; });
+			if (bStop) return;
+			sample(vValues, iSeed);
+			iPending++;
+		}
+
+		resetWithSample(DS, vValues, iSeed);
+
+		// Diverged states are dropped, so pooled states can always be flown.
+		Entry entry;
+		if (DS->iStatus == STATUS_OK)
+		{
+			entry.vValues = vValues;
+			entry.vState.resize((size_t)DS->getStateSize());
+			DS->saveState(entry.vState.data());
+		}
+
+		std::lock_guard<std::mutex> lock(mtxPool);
+		iPending--;
+		if (!entry.vState.empty()) dqReady.push_back(std::move(entry));
+	}
+}
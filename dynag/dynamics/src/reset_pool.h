@@ -0,0 +1,96 @@
+/*
+* DynaG Dynamics C++ / Reset Pool
+*
+* Reset Pool keeps pre-trimmed initial states of a dynamic system configuration which
+* are prepared by background workers. Each worker owns a clone of the configuration.
+* It samples randomized parameters, resets (trims) the clone and pushes the sampled
+* values with state snapshot of the clone into a bounded queue. Resetting an instance
+* from the pool sets the sampled parameters and loads the snapshot, so it does not trim.
+* If the queue is empty, the instance is reset in the calling thread as a miss.
+*
+* Pooled states can be loaded into the configuration and its clones, i.e. instances of
+* the same yaml file with the same observation mask and history length.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+*/
+
+#pragma once
+
+#include "dynamics.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+
+class ResetPool
+{
+public:
+	enum Distribution
+	{
+		DISTRIBUTION_UNIFORM = 0,	// Uniform in [fA, fB).
+		DISTRIBUTION_NORMAL = 1,	// Normal with mean `fA` and standard deviation `fB`.
+	};
+
+	// Randomized compiled parameter. Samples are clipped into [fMin, fMax].
+	struct RandomParameter
+	{
+		int iId;
+		int iDistribution;
+		float fA, fB, fMin, fMax;
+	};
+
+	// Creating pool of configuration of `DS` and starting `iWorkers` workers which keep
+	// `iCapacity` states ready. Configuration is cloned, so `DS` can be used after it.
+	ResetPool(DynamicSystem* DS, const std::vector<RandomParameter>& vParameters, int iCapacity, int iWorkers, unsigned int iSeed);
+
+	// Stopping workers. Worker which is trimming stops after its trim.
+	~ResetPool();
+
+	ResetPool(const ResetPool&) = delete;
+	void operator=(const ResetPool&) = delete;
+
+	// Resetting `DS` with a pooled state. It is reset in calling thread if pool is empty.
+	void reset(DynamicSystem* DS);
+
+	// Getting number of ready states.
+	int getSize();
+
+	// Getting number of resets which did not find a ready state.
+	int getMisses();
+
+private:
+	// Pooled state with its sampled parameter values.
+	struct Entry
+	{
+		std::vector<float> vValues;
+		std::vector<char> vState;
+	};
+
+	std::vector<RandomParameter> vParameters;
+	std::vector<int> vIds;
+	int iCapacity;
+
+	std::mutex mtxPool;
+	std::condition_variable cvSpace;
+	std::deque<Entry> dqReady;
+	std::mt19937 mGenerator; // generator of parameters and seeds of states
+	int iPending = 0; // states which are being prepared by workers
+	int iMisses = 0;
+	bool bStop = false;
+
+	std::vector<DynamicSystem*> vWorkerSystems;
+	std::vector<std::thread> vWorkers;
+
+	// Sampling parameter values and seed of a state. Pool should be locked.
+	void sample(std::vector<float>& vValues, unsigned int& iSeed);
+
+	// Resetting `DS` with sampled parameters and seed. It trims in calling thread.
+	void resetWithSample(DynamicSystem* DS, const std::vector<float>& vValues, unsigned int iSeed);
+
+	// Loop of a worker which fills the pool until it is stopped.
+	void work(DynamicSystem* DS);
+};
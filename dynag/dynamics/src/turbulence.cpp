@@ -0,0 +1,255 @@
+#include "turbulence.h"
+#include <complex>
+#include <fstream>
+#include <mutex>
+#include <random>
+
+// Integral of `u^n * exp(-y * u)` for `u` in [0, 1]. Series is used for small `y`
+// where closed form loses precision.
+static double expMoment(int n, double y)
+{
+	if (y < 0.1)
+	{
+		double dSum = 0.0, dTerm = 1.0;
+		for (int k = 0; k < 10; k++)
+		{
+			dSum += dTerm / (n + k + 1);
+			dTerm *= -y / (k + 1);
+		}
+		return dSum;
+	}
+
+	const double e = std::exp(-y);
+	if (n == 0) return -std::expm1(-y) / y;
+	if (n == 1) return (1.0 - e * (1.0 + y)) / (y * y);
+	return (2.0 - e * (2.0 + 2.0 * y + y * y)) / (y * y * y);
+}
+
+void DrydenFilter::update(float fNewTimeConstant, float fNewDt)
+{
+	if (fNewDt == fDt && std::fabs(fNewTimeConstant - fTimeConstant) <= TIME_CONSTANT_TOLERANCE * fTimeConstant) return;
+	if (!(fNewTimeConstant > 0.0f)) return;
+
+	fTimeConstant = fNewTimeConstant;
+	fDt = fNewDt;
+
+	// Variances are calculated for unit sigma. Stationary variance of the first state is
+	// 1 / pi for first order filter and 1 / (4 pi) for second order filter.
+	if (iOrder == 1)
+	{
+		const double x = (double)fDt / fTimeConstant;
+		fTransition[0][0] = (float)std::exp(-x);
+		fNoise[0][0] = (float)std::sqrt(-std::expm1(-2.0 * x) / PI);
+	}
+	else
+	{
+		// Double pole at `-a` where `a = 1 / (2 t)`, and `x = a dt`.
+		const double x = 0.5 * fDt / fTimeConstant;
+		const double e = std::exp(-x);
+		fTransition[0][0] = (float)(e * (1.0 + x));
+		fTransition[0][1] = (float)(e * x);
+		fTransition[1][0] = (float)(-e * x);
+		fTransition[1][1] = (float)(e * (1.0 - x));
+
+		const double g0 = expMoment(0, 2.0 * x), g1 = expMoment(1, 2.0 * x), g2 = expMoment(2, 2.0 * x);
+		const double q00 = x * x * x * g2 / PI;
+		const double q10 = (x * x * g1 - x * x * x * g2) / PI;
+		const double q11 = (x * g0 - 2.0 * x * x * g1 + x * x * x * g2) / PI;
+
+		// Cholesky decomposition of noise covariance.
+		const double l00 = std::sqrt(q00);
+		const double l10 = (l00 > 0.0) ? q10 / l00 : 0.0;
+		fNoise[0][0] = (float)l00;
+		fNoise[1][0] = (float)l10;
+		fNoise[1][1] = (float)std::sqrt(std::fmax(q11 - l10 * l10, 0.0));
+	}
+}
+
+// In-place radix-2 FFT of `n` complex values which are `iStride` apart.
+static void fft(std::complex<double>* cValues, int n, int iStride, bool bInverse, std::vector<std::complex<double>>& vLine)
+{
+	vLine.resize(n);
+	for (int i = 0; i < n; i++) vLine[i] = cValues[(size_t)i * iStride];
+
+	// Bit reversal permutation
+	for (int i = 1, j = 0; i < n; i++)
+	{
+		int iBit = n >> 1;
+		for (; j & iBit; iBit >>= 1) j ^= iBit;
+		j ^= iBit;
+		if (i < j) std::swap(vLine[i], vLine[j]);
+	}
+
+	for (int iLength = 2; iLength <= n; iLength <<= 1)
+	{
+		const double dAngle = (bInverse ? 2.0 : -2.0) * PI / iLength;
+		const std::complex<double> cRoot(std::cos(dAngle), std::sin(dAngle));
+		for (int i = 0; i < n; i += iLength)
+		{
+			std::complex<double> cTwiddle(1.0, 0.0);
+			for (int j = 0; j < iLength / 2; j++)
+			{
+				std::complex<double> u = vLine[i + j], v = vLine[i + j + iLength / 2] * cTwiddle;
+				vLine[i + j] = u + v;
+				vLine[i + j + iLength / 2] = u - v;
+				cTwiddle *= cRoot;
+			}
+		}
+	}
+
+	for (int i = 0; i < n; i++) cValues[(size_t)i * iStride] = vLine[i];
+}
+
+std::shared_ptr<const TurbulenceField> TurbulenceField::load(int iSize, float fSpacing, float fLength, unsigned int iSeed, const std::string& sCacheDirectory)
+{
+	try
+	{
+		if (iSize < 2 || iSize > 512 || (iSize & (iSize - 1)) != 0)
+			gThrow("Turbulence Error : Size of turbulence field should be power of two in [2, 512], but it is " + std::to_string(iSize) + "!");
+		if (!(fSpacing > 0.0f) || !(fLength > 0.0f))
+			gThrow("Turbulence Error : Spacing and scale length of turbulence field should be positive!");
+	}
+	catch (std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	std::string sName = "turbulence_field_" + std::to_string(iSize) + "_" + std::to_string(fSpacing) + "_" + 
+		std::to_string(fLength) + "_" + std::to_string(iSeed);
+
+	// Cache stores weak pointers, so field is released with its last instance.
+	static std::mutex mtxCache;
+	static std::unordered_map<std::string, std::weak_ptr<const TurbulenceField>> mapCache;
+	std::lock_guard<std::mutex> lock(mtxCache);
+
+	std::shared_ptr<const TurbulenceField> spField = mapCache[sName].lock();
+	if (spField) return spField;
+
+	std::shared_ptr<TurbulenceField> spNewField = std::make_shared<TurbulenceField>();
+	spNewField->iSize = iSize;
+	spNewField->fSpacing = fSpacing;
+	spNewField->fLength = fLength;
+	spNewField->iSeed = iSeed;
+	spNewField->fInverseSpacing = 1.0f / fSpacing;
+
+	std::string sPath = sCacheDirectory.empty() ? "" : sCacheDirectory + "/" + sName + ".dgcache";
+	if (sPath.empty() || !spNewField->read(sPath))
+	{
+		spNewField->synthesize();
+		if (!sPath.empty()) spNewField->write(sPath);
+	}
+
+	mapCache[sName] = spNewField;
+	return spNewField;
+}
+
+void TurbulenceField::synthesize()
+{
+	const int n = iSize;
+	const size_t iCount = (size_t)n * n * n;
+	std::vector<std::complex<double>> vSpectrum[3];
+	for (std::vector<std::complex<double>>& v : vSpectrum) v.assign(iCount, 0.0);
+
+	// Coefficients are complex normal vectors which are projected to be divergence free
+	// and scaled with `sqrt(E(k) / (4 pi k^2))`. Energy spectrum of von Karman model is
+	// `E(k) ~ (a k)^4 / (1 + (a k)^2)^(17/6)` where `a = 1.339 L`. Constant factors are
+	// dropped, since components are normalized after transform.
+	std::mt19937 mGenerator(iSeed);
+	std::normal_distribution<double> ndCoefficient(0.0, 1.0);
+	const double dWaveStep = 2.0 * PI / (n * (double)fSpacing);
+	const double a2 = std::pow(1.339 * fLength, 2.0);
+	for (int i = 0; i < n; i++)
+		for (int j = 0; j < n; j++)
+			for (int k = 0; k < n; k++)
+			{
+				const double kx = dWaveStep * (i <= n / 2 ? i : i - n);
+				const double ky = dWaveStep * (j <= n / 2 ? j : j - n);
+				const double kz = dWaveStep * (k <= n / 2 ? k : k - n);
+				const double k2 = kx * kx + ky * ky + kz * kz;
+
+				std::complex<double> cXi[3];
+				for (std::complex<double>& c : cXi) c = std::complex<double>(ndCoefficient(mGenerator), ndCoefficient(mGenerator));
+				if (k2 == 0.0) continue;
+
+				const double dEnergy = std::pow(a2 * k2, 2.0) / std::pow(1.0 + a2 * k2, 17.0 / 6.0);
+				const double dAmplitude = std::sqrt(dEnergy / (4.0 * PI * k2));
+				const std::complex<double> cProjection = (kx * cXi[0] + ky * cXi[1] + kz * cXi[2]) / k2;
+				const size_t p = ((size_t)i * n + j) * n + k;
+				vSpectrum[0][p] = dAmplitude * (cXi[0] - kx * cProjection);
+				vSpectrum[1][p] = dAmplitude * (cXi[1] - ky * cProjection);
+				vSpectrum[2][p] = dAmplitude * (cXi[2] - kz * cProjection);
+			}
+
+	// Inverse transform along each axis. Real part of the complex field is a real field
+	// with the same spectrum.
+	std::vector<std::complex<double>> vLine;
+	for (std::vector<std::complex<double>>& v : vSpectrum)
+	{
+		for (int i = 0; i < n; i++)
+			for (int j = 0; j < n; j++)
+				fft(v.data() + ((size_t)i * n + j) * n, n, 1, true, vLine);
+		for (int i = 0; i < n; i++)
+			for (int k = 0; k < n; k++)
+				fft(v.data() + (size_t)i * n * n + k, n, n, true, vLine);
+		for (int j = 0; j < n; j++)
+			for (int k = 0; k < n; k++)
+				fft(v.data() + (size_t)j * n + k, n, n * n, true, vLine);
+	}
+
+	vValues.resize(3 * iCount);
+	for (int c = 0; c < 3; c++)
+	{
+		double dMean = 0.0, dSquare = 0.0;
+		for (size_t p = 0; p < iCount; p++)
+		{
+			const double dValue = vSpectrum[c][p].real();
+			dMean += dValue;
+			dSquare += dValue * dValue;
+		}
+		dMean /= iCount;
+		const double dSigma = std::sqrt(std::fmax(dSquare / iCount - dMean * dMean, 0.0));
+		const double dScale = (dSigma > 0.0) ? 1.0 / dSigma : 0.0;
+		for (size_t p = 0; p < iCount; p++)
+			vValues[3 * p + c] = (float)((vSpectrum[c][p].real() - dMean) * dScale);
+	}
+}
+
+// Header of cache file of turbulence field.
+struct TurbulenceFieldHeader
+{
+	char cMagic[4];
+	int iVersion, iSize;
+	float fSpacing, fLength;
+	unsigned int iSeed;
+};
+
+bool TurbulenceField::read(const std::string& sPath)
+{
+	std::ifstream file(sPath, std::ios::binary);
+	if (!file) return false;
+
+	TurbulenceFieldHeader header;
+	file.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!file || std::string(header.cMagic, 4) != "DGTF" || header.iVersion != 1 || header.iSize != iSize ||
+		header.fSpacing != fSpacing || header.fLength != fLength || header.iSeed != iSeed)
+		return false;
+
+	vValues.resize(3 * (size_t)iSize * iSize * iSize);
+	file.read(reinterpret_cast<char*>(vValues.data()), vValues.size() * sizeof(float));
+	if (!file)
+	{
+		vValues.clear();
+		return false;
+	}
+	return true;
+}
+
+void TurbulenceField::write(const std::string& sPath) const
+{
+	// Failing to write cache is not fatal, field is synthesized again next time.
+	std::ofstream file(sPath, std::ios::binary);
+	TurbulenceFieldHeader header = { { 'D', 'G', 'T', 'F' }, 1, iSize, fSpacing, fLength, iSeed };
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(vValues.data()), vValues.size() * sizeof(float));
+	if (!file) std::cerr << "Turbulence Warning : Turbulence field cannot be cached into `" << sPath << "`!" << std::endl;
+}
@@ -0,0 +1,132 @@
+/*
+* DynaG Dynamics C++ / Turbulence
+*
+* Dryden shaping filters of turbulence. Filters are advanced once per step with the
+* exact discrete-time transition of their continuous models. Driving white noise is
+* integrated over the step exactly too, so statistics of the filters do not depend
+* on step size.
+*
+* Turbulence field is a frozen, spatially periodic velocity field which is synthesized
+* once from von Karman spectrum with FFT. It is immutable and shared by instances, so
+* instances only sample it at their positions.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Adding shared frozen turbulence field sampled by position. // @MGokcayK
+* Update : 19/10/2026 - Advancing filter states of any scalar type. // @MGokcayK
+*/
+
+#pragma once
+
+#include "utils.h"
+#include <memory>
+
+// Dryden shaping filter w.r.t time constant `t` which is scale length over airspeed.
+// First order filter is `sigma * sqrt(2 / pi * t) / (1 + t s)` and second order filter
+// is `sigma * sqrt(2 / pi * t) / (1 + 2 t s)^2`. Second state of second order filter is
+// its derivative scaled with `2 t`, so all states are velocities and in same range.
+struct DrydenFilter
+{
+	// Relative change of time constant which transition is calculated again.
+	static constexpr float TIME_CONSTANT_TOLERANCE = 1e-3f;
+
+	int iOrder = 1;
+
+	// Time constant and step size which transition is calculated for. Negative time
+	// constant means that transition is not calculated yet.
+	float fTimeConstant = -1.0f, fDt = 0.0f;
+
+	// Transition matrix and lower triangular noise matrix for unit sigma.
+	float fTransition[2][2] = { { 0.0f } }, fNoise[2][2] = { { 0.0f } };
+
+	DrydenFilter(int iOrder = 1) : iOrder(iOrder) {}
+
+	// Calculating transition if time constant is changed more than tolerance or step size is changed.
+	void update(float fNewTimeConstant, float fNewDt);
+
+	// Forgetting calculated transition.
+	void invalidate() { fTimeConstant = -1.0f; }
+
+	// Advancing states of filter one step with standard normal samples. `iOrder` states
+	// and samples are used.
+	template<typename T>
+	void advance(T* fStates, float fSigma, const float* fSamples) const
+	{
+		if (iOrder == 1)
+		{
+			fStates[0] = fTransition[0][0] * fStates[0] + fSigma * fNoise[0][0] * fSamples[0];
+		}
+		else
+		{
+			const T x0 = fStates[0], x1 = fStates[1];
+			fStates[0] = fTransition[0][0] * x0 + fTransition[0][1] * x1 + fSigma * (fNoise[0][0] * fSamples[0]);
+			fStates[1] = fTransition[1][0] * x0 + fTransition[1][1] * x1 + fSigma * (fNoise[1][0] * fSamples[0] + fNoise[1][1] * fSamples[1]);
+		}
+	}
+};
+
+// Frozen turbulence field on periodic `iSize`^3 grid with `fSpacing` [ft] spacing. It is
+// synthesized from isotropic von Karman spectrum with `fLength` [ft] scale length, and
+// its components are normalized to unit sigma. Grid stores u, v and w of each point
+// together, so a sample reads 8 neighbouring points.
+class TurbulenceField
+{
+public:
+	int iSize = 0;
+	float fSpacing = 0.0f, fLength = 0.0f;
+	unsigned int iSeed = 0;
+
+	// Loading field. Fields are cached w.r.t their parameters while an instance uses them.
+	// If `sCacheDirectory` is not empty, field is read from or written into a cache file
+	// in it, so it is synthesized once for all runs.
+	static std::shared_ptr<const TurbulenceField> load(int iSize, float fSpacing, float fLength, unsigned int iSeed, const std::string& sCacheDirectory = "");
+
+	// Getting span of field in each axis [ft]. Field repeats itself after it.
+	float getSpan() const { return iSize * fSpacing; }
+
+	// Sampling unit sigma velocity at position [ft] with trilinear interpolation.
+	void sample(const float* fPosition, float* fVelocity) const
+	{
+		int iIndex[3][2];
+		float fFactor[3];
+		for (int d = 0; d < 3; d++)
+		{
+			// Diverged position is sampled at origin, so it does not read out of the grid.
+			float fGrid = fPosition[d] * fInverseSpacing;
+			if (!(std::fabs(fGrid) < 1e30f)) fGrid = 0.0f;
+			float fFloor = std::floor(fGrid);
+			fFactor[d] = fGrid - fFloor;
+			int i = (int)(fFloor - std::floor(fFloor / iSize) * iSize);
+			if (i >= iSize || i < 0) i = 0;
+			iIndex[d][0] = i;
+			iIndex[d][1] = (i + 1 == iSize) ? 0 : i + 1;
+		}
+
+		float fCorners[4][3];
+		for (int c = 0; c < 4; c++)
+		{
+			const float* f0 = vValues.data() + 3 * ((iIndex[0][c & 1] * iSize + iIndex[1][c >> 1]) * iSize + iIndex[2][0]);
+			const float* f1 = vValues.data() + 3 * ((iIndex[0][c & 1] * iSize + iIndex[1][c >> 1]) * iSize + iIndex[2][1]);
+			for (int k = 0; k < 3; k++) fCorners[c][k] = f0[k] + fFactor[2] * (f1[k] - f0[k]);
+		}
+		for (int k = 0; k < 3; k++)
+		{
+			float fLow = fCorners[0][k] + fFactor[0] * (fCorners[1][k] - fCorners[0][k]);
+			float fHigh = fCorners[2][k] + fFactor[0] * (fCorners[3][k] - fCorners[2][k]);
+			fVelocity[k] = fLow + fFactor[1] * (fHigh - fLow);
+		}
+	}
+
+private:
+	float fInverseSpacing = 0.0f;
+	std::vector<float> vValues;
+
+	// Synthesizing field from random spectral coefficients.
+	void synthesize();
+
+	// Reading and writing cache file. Reading fails if file does not match the parameters.
+	bool read(const std::string& sPath);
+	void write(const std::string& sPath) const;
+};
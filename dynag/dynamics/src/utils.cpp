@@ -1,8 +1,5 @@
 #include "utils.h"
 
-bool TRIMMING = false;
-bool READY = false;
-
 yamlChecker::yamlChecker()
 {
 	setRequiredYamlNodes();
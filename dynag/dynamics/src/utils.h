@@ -9,6 +9,9 @@
 * Update : 15/09/2021 - Initialization & Adding `extractSubVectorByIndexes` method. // @MGokcayK
 * Update : 17/09/2021 - Adding `pi_bound` method. // @MGokcayK
 * Update : 29/11/2021 - Adding yamlCheckter structure. // @MGokcayK
+* Update : 19/10/2026 - Templating `mod2PI` and `pi_bound` on scalar type. // @MGokcayK
+* Update : 19/10/2026 - Moving trimming flag into instances and making ready flag atomic. // @MGokcayK
+* Update : 19/10/2026 - Removing global ready flag in favor of status of instances. // @MGokcayK
 */
 
 #pragma once
@@ -27,9 +30,6 @@
 #include "yaml-cpp/yaml.h"
 #include "error_handler.h"
 
-extern bool TRIMMING;
-extern bool READY;
-
 constexpr float PI = 3.141592653589793f; // pi
 constexpr float TWOPI = 6.283185307179586f; // 2 * pi
 constexpr float FTS2KNOT = 0.5924838f; // ft / s to knots conversion;
@@ -76,16 +76,17 @@ T extractSubVectorByIndexes(const T& full, const T2& ind)
 // Module of 2pi operator. This implementation is different than
 // `fmodf` method. Therefore, it should be reimplemented.
 struct mod2PI {
-    float operator()(float v) const { return v - floor(v / TWOPI) * TWOPI; }
+    template<typename T>
+    T operator()(T v) const { return v - floor(v / TWOPI) * TWOPI; }
 };
 
 // Bounding Eigen objects w.r.t pi.
 template<typename T>
 void pi_bound(Eigen::MatrixBase<T>& x)
 {
-    x = (x.array() + PI);
+    x = (x.array() + typename T::Scalar(PI));
     x = x.unaryExpr(mod2PI());
-    x = x.array() - PI;
+    x = x.array() - typename T::Scalar(PI);
 }
 
 // Checking wheter derived Eigen object is nan.
@@ -1,6 +1,7 @@
 #include "vectorspace.h"
 
-std::unordered_map<std::string, numberedInfos>::const_iterator VectorSpace::findIndex(const std::string& sVectorName)
+template<typename T>
+std::unordered_map<std::string, numberedInfos>::const_iterator VectorSpaceT<T>::findIndex(const std::string& sVectorName)
 {
 	std::unordered_map<std::string, numberedInfos>::const_iterator ind = mapInfo.find(sVectorName);
 	if (ind == mapInfo.end())
@@ -13,7 +14,8 @@ std::unordered_map<std::string, numberedInfos>::const_iterator VectorSpace::find
 	}
 }
 
-void VectorSpace::checkOperation(const VectorSpace& vsOther, const std::string& operatorName)
+template<typename T>
+void VectorSpaceT<T>::checkOperation(const VectorSpaceT& vsOther, const std::string& operatorName)
 {
 	if (vValues.size() != vsOther.vValues.size())
 	{
@@ -21,12 +23,14 @@ void VectorSpace::checkOperation(const VectorSpace& vsOther, const std::string&
 	}
 }
 
-VectorSpace::VectorSpace(const std::string& sName)
+template<typename T>
+VectorSpaceT<T>::VectorSpaceT(const std::string& sName)
 {
 	this->sName = sName;
 }
 
-void VectorSpace::init(const VectorSpace& vsOther)
+template<typename T>
+void VectorSpaceT<T>::init(const VectorSpaceT& vsOther)
 {
 	mapInfo = vsOther.mapInfo;
 	vValues = vsOther.vValues;
@@ -34,7 +38,8 @@ void VectorSpace::init(const VectorSpace& vsOther)
 	vNormalizer = vsOther.vNormalizer;
 }
 
-void VectorSpace::reset()
+template<typename T>
+void VectorSpaceT<T>::reset()
 {
 	mapInfo = {};
 	vValues = {};
@@ -42,25 +47,27 @@ void VectorSpace::reset()
 	vNormalizer = {};
 }
 
-void VectorSpace::registerVector(const std::string& sVectorName, const Eigen::VectorXf& vValue, const float& fNormalizer)
+template<typename T>
+void VectorSpaceT<T>::registerVector(const std::string& sVectorName, const VectorX& vValue, const T& fNormalizer)
 {
 	numberedInfos temp;
 	temp.index = vValues.size();
 	temp.size = vValue.size();
 	mapInfo.insert(std::make_pair(sVectorName, temp));
-	Eigen::VectorXf vec_joined(vValues.size() + vValue.size());
-	Eigen::VectorXf vecNorm_joined(vNormalizedValues.size() + vValue.size());
-	Eigen::VectorXf vecNormalizer_joined(vNormalizer.size() + vValue.size());
+	VectorX vec_joined(vValues.size() + vValue.size());
+	VectorX vecNorm_joined(vNormalizedValues.size() + vValue.size());
+	VectorX vecNormalizer_joined(vNormalizer.size() + vValue.size());
 	vec_joined << vValues, vValue;
 	vValues = vec_joined;
 	vDefault = vValues;
 	vecNorm_joined << vNormalizedValues, vValue.array() / (fNormalizer + EPS);
 	vNormalizedValues = vecNorm_joined;
-	vecNormalizer_joined << vNormalizer, Eigen::VectorXf::Constant(vValue.size(), fNormalizer);
+	vecNormalizer_joined << vNormalizer, VectorX::Constant(vValue.size(), fNormalizer);
 	vNormalizer = vecNormalizer_joined;
 }
 
-void VectorSpace::set(const std::string& sVectorName, const Eigen::VectorXf& vValue)
+template<typename T>
+void VectorSpaceT<T>::set(const std::string& sVectorName, const VectorX& vValue)
 {
 	try
 	{
@@ -69,11 +76,6 @@ void VectorSpace::set(const std::string& sVectorName, const Eigen::VectorXf& vVa
 		{
 			vValues.segment(ind->second.index, ind->second.size) = vValue;
 			vNormalizedValues.segment(ind->second.index, ind->second.size) = vValue.array() / (vNormalizer.segment(ind->second.index, ind->second.size).array() + EPS);
-			if (TRIMMING == false && sName == "State")
-			{
-				bool d = isDiverged();
-				if (d == true) READY = false;
-			}
 		}
 		else if (ind != mapInfo.end())
 		{			
@@ -86,7 +88,8 @@ void VectorSpace::set(const std::string& sVectorName, const Eigen::VectorXf& vVa
 	}
 }
 
-bool VectorSpace::isDiverged()
+template<typename T>
+bool VectorSpaceT<T>::isDiverged()
 {
 	if ((vNormalizedValues.array().abs() > NORM_LIMIT).any())
 	{
@@ -98,13 +101,26 @@ bool VectorSpace::isDiverged()
 	}
 }
 
-void VectorSpace::toDefault()
+template<typename T>
+std::string VectorSpaceT<T>::getVectorName(int iIndex)
+{
+	for (auto it = mapInfo.begin(); it != mapInfo.end(); ++it)
+	{
+		if (iIndex >= it->second.index && iIndex < it->second.index + it->second.size)
+			return it->first + "[" + std::to_string(iIndex - it->second.index) + "]";
+	}
+	return "unknown";
+}
+
+template<typename T>
+void VectorSpaceT<T>::toDefault()
 {
 	vValues = vDefault;
 	vNormalizedValues = vValues.array() / (vNormalizer.array() + EPS);
 }
 
-void VectorSpace::setValues(float* vValue)
+template<typename T>
+void VectorSpaceT<T>::setValues(T* vValue)
 {
 	for (int i = 0; i < vValues.size(); i++)
 	{
@@ -113,7 +129,8 @@ void VectorSpace::setValues(float* vValue)
 	}
 }
 
-Eigen::VectorXf VectorSpace::get(const std::string& sVectorName)
+template<typename T>
+typename VectorSpaceT<T>::VectorX VectorSpaceT<T>::get(const std::string& sVectorName)
 {
 	try
 	{
@@ -126,7 +143,8 @@ Eigen::VectorXf VectorSpace::get(const std::string& sVectorName)
 	}
 }
 
-void VectorSpace::get(float& fTarget, const std::string& sVectorName, const int& iIndex)
+template<typename T>
+void VectorSpaceT<T>::get(T& fTarget, const std::string& sVectorName, const int& iIndex)
 {
 	try
 	{
@@ -139,7 +157,8 @@ void VectorSpace::get(float& fTarget, const std::string& sVectorName, const int&
 	}
 }
 
-Eigen::VectorXf VectorSpace::operator[](const std::string& sVectorName)
+template<typename T>
+typename VectorSpaceT<T>::VectorX VectorSpaceT<T>::operator[](const std::string& sVectorName)
 {
 	try
 	{
@@ -152,7 +171,8 @@ Eigen::VectorXf VectorSpace::operator[](const std::string& sVectorName)
 	}
 }
 
-Eigen::VectorXf VectorSpace::getNormalized(const std::string& sVectorName)
+template<typename T>
+typename VectorSpaceT<T>::VectorX VectorSpaceT<T>::getNormalized(const std::string& sVectorName)
 {
 	try
 	{
@@ -165,7 +185,8 @@ Eigen::VectorXf VectorSpace::getNormalized(const std::string& sVectorName)
 	}
 }
 
-void VectorSpace::getNormalized(float& fTarget, const std::string& sVectorName, const int& iIndex)
+template<typename T>
+void VectorSpaceT<T>::getNormalized(T& fTarget, const std::string& sVectorName, const int& iIndex)
 {
 	try
 	{
@@ -178,7 +199,8 @@ void VectorSpace::getNormalized(float& fTarget, const std::string& sVectorName,
 	}
 }
 
-float* VectorSpace::getPointerAndSetSize(const std::string& sVectorName, int* iSizePtr)
+template<typename T>
+T* VectorSpaceT<T>::getPointerAndSetSize(const std::string& sVectorName, int* iSizePtr)
 {
 	try
 	{
@@ -192,7 +214,8 @@ float* VectorSpace::getPointerAndSetSize(const std::string& sVectorName, int* iS
 	}
 }
 
-float* VectorSpace::getNormalizedPointerAndSetSize(const std::string& sVectorName, int* iSizePtr)
+template<typename T>
+T* VectorSpaceT<T>::getNormalizedPointerAndSetSize(const std::string& sVectorName, int* iSizePtr)
 {
 	try
 	{
@@ -206,62 +229,72 @@ float* VectorSpace::getNormalizedPointerAndSetSize(const std::string& sVectorNam
 	}
 }
 
-const float& VectorSpace::getValue(int iIndex)
+template<typename T>
+const T& VectorSpaceT<T>::getValue(int iIndex)
 {
 	return vValues(iIndex);
 }
 
-Eigen::VectorXf VectorSpace::getValue(int iIndex, int iSize)
+template<typename T>
+typename VectorSpaceT<T>::VectorX VectorSpaceT<T>::getValue(int iIndex, int iSize)
 {
 	return vValues(Eigen::seqN(iIndex, iSize));
 }
 
-void VectorSpace::setValue(int iIndex, float fNewValue)
+template<typename T>
+void VectorSpaceT<T>::setValue(int iIndex, T fNewValue)
 {
 	vValues(iIndex) = fNewValue;
 	vNormalizedValues(iIndex) = fNewValue / (vNormalizer(iIndex) + EPS);
 }
 
-void VectorSpace::setValue(int iIndex, Eigen::VectorXf vNewValue)
+template<typename T>
+void VectorSpaceT<T>::setValue(int iIndex, VectorX vNewValue)
 {
 	vValues.segment(iIndex, vNewValue.size()) = vNewValue;
 	vNormalizedValues.segment(iIndex, vNewValue.size()) = vNewValue.array() / (vNormalizer(Eigen::seqN(iIndex, vNewValue.size())).array() + EPS);
 }
 
-const float& VectorSpace::getNormalizedValue(int iIndex)
+template<typename T>
+const T& VectorSpaceT<T>::getNormalizedValue(int iIndex)
 {
 	return vNormalizedValues(iIndex);
 }
 
-Eigen::VectorXf VectorSpace::getNormalizedValue(int iIndex, int iSize)
+template<typename T>
+typename VectorSpaceT<T>::VectorX VectorSpaceT<T>::getNormalizedValue(int iIndex, int iSize)
 {
 	return vNormalizedValues(Eigen::seqN(iIndex, iSize));
 }
 
-void VectorSpace::setNormalizedValue(int iIndex, float fNewValue)
+template<typename T>
+void VectorSpaceT<T>::setNormalizedValue(int iIndex, T fNewValue)
 {
 	vNormalizedValues(iIndex) = fNewValue;
 	vValues(iIndex) = fNewValue * vNormalizer(iIndex);
 }
 
-void VectorSpace::setNormalizedValue(int iIndex, Eigen::VectorXf vNewValue)
+template<typename T>
+void VectorSpaceT<T>::setNormalizedValue(int iIndex, VectorX vNewValue)
 {
 	vNormalizedValues.segment(iIndex, vNewValue.size()) = vNewValue;
 	vValues.segment(iIndex, vNewValue.size()) = vNewValue * vNormalizer(iIndex);
 }
 
-void VectorSpace::setAllValuesToZero()
+template<typename T>
+void VectorSpaceT<T>::setAllValuesToZero()
 {
 	vValues.setConstant(0.0f);
 	vNormalizedValues = vValues.array() / (vNormalizer.array() + EPS);
 }
 
-VectorSpace VectorSpace::operator+(const VectorSpace& vsOther)
+template<typename T>
+VectorSpaceT<T> VectorSpaceT<T>::operator+(const VectorSpaceT& vsOther)
 {
 	try
 	{
 		checkOperation(vsOther, "summation");
-		VectorSpace out;
+		VectorSpaceT out;
 		out.vValues = vValues + vsOther.vValues;
 		out.vNormalizedValues = out.vValues.array() / (vNormalizer.array() + EPS);
 		out.mapInfo = mapInfo;
@@ -273,21 +306,23 @@ VectorSpace VectorSpace::operator+(const VectorSpace& vsOther)
 	}
 }
 
-VectorSpace VectorSpace::operator+(const float& fOther)
+template<typename T>
+VectorSpaceT<T> VectorSpaceT<T>::operator+(const T& fOther)
 {
-	VectorSpace out;
+	VectorSpaceT out;
 	out.vValues = vValues.array() + fOther;
 	out.vNormalizedValues = out.vValues.array() / (vNormalizer.array() + EPS);
 	out.mapInfo = mapInfo;
 	return out;
 }
 
-VectorSpace VectorSpace::operator-(const VectorSpace& vsOther)
+template<typename T>
+VectorSpaceT<T> VectorSpaceT<T>::operator-(const VectorSpaceT& vsOther)
 {
 	try
 	{
 		checkOperation(vsOther, "subtraction");
-		VectorSpace out;
+		VectorSpaceT out;
 		out.vValues = vValues - vsOther.vValues;
 		out.vNormalizedValues = out.vValues.array() / (vNormalizer.array() + EPS);
 		out.mapInfo = mapInfo;
@@ -299,21 +334,23 @@ VectorSpace VectorSpace::operator-(const VectorSpace& vsOther)
 	}
 }
 
-VectorSpace VectorSpace::operator-(const float& fOther)
+template<typename T>
+VectorSpaceT<T> VectorSpaceT<T>::operator-(const T& fOther)
 {
-	VectorSpace out;
+	VectorSpaceT out;
 	out.vValues = vValues.array() - fOther;
 	out.vNormalizedValues = out.vValues.array() / (vNormalizer.array() + EPS);
 	out.mapInfo = mapInfo;
 	return out;
 }
 
-VectorSpace VectorSpace::operator*(const VectorSpace& vsOther)
+template<typename T>
+VectorSpaceT<T> VectorSpaceT<T>::operator*(const VectorSpaceT& vsOther)
 {
 	try
 	{
 		checkOperation(vsOther, "multiplication");
-		VectorSpace out;
+		VectorSpaceT out;
 		out.vValues = vValues * vsOther.vValues;
 		out.vNormalizedValues = out.vValues.array() / (vNormalizer.array() + EPS);
 		out.mapInfo = mapInfo;
@@ -325,21 +362,23 @@ VectorSpace VectorSpace::operator*(const VectorSpace& vsOther)
 	}
 }
 
-VectorSpace VectorSpace::operator*(const float& fOther)
+template<typename T>
+VectorSpaceT<T> VectorSpaceT<T>::operator*(const T& fOther)
 {
-	VectorSpace out;
+	VectorSpaceT out;
 	out.vValues = vValues.array() * fOther;
 	out.vNormalizedValues = out.vValues.array() / (vNormalizer.array() + EPS);
 	out.mapInfo = mapInfo;
 	return out;
 }
 
-VectorSpace VectorSpace::operator/(const VectorSpace& vsOther)
+template<typename T>
+VectorSpaceT<T> VectorSpaceT<T>::operator/(const VectorSpaceT& vsOther)
 {
 	try
 	{
 		checkOperation(vsOther, "division");
-		VectorSpace out;
+		VectorSpaceT out;
 		out.vValues = vValues.array() / (vsOther.vValues.array() + EPS);
 		out.vNormalizedValues = out.vValues.array() / (vNormalizer.array() + EPS);
 		out.mapInfo = mapInfo;
@@ -351,21 +390,23 @@ VectorSpace VectorSpace::operator/(const VectorSpace& vsOther)
 	}
 }
 
-VectorSpace VectorSpace::operator/(const float& fOther)
+template<typename T>
+VectorSpaceT<T> VectorSpaceT<T>::operator/(const T& fOther)
 {
-	VectorSpace out;
+	VectorSpaceT out;
 	out.vValues = vValues.array() / (fOther + EPS);
 	out.vNormalizedValues = out.vValues.array() / (vNormalizer.array() + EPS);
 	out.mapInfo = mapInfo;
 	return out;
 }
 
-void VectorSpace::operator=(const VectorSpace& vsOther)
+template<typename T>
+void VectorSpaceT<T>::operator=(const VectorSpaceT& vsOther)
 {
 	try
 	{
 		checkOperation(vsOther, "assigning");
-		VectorSpace out;
+		VectorSpaceT out;
 		vValues = vsOther.vValues.array();
 		vNormalizedValues = vValues.array() / (vNormalizer.array() + EPS);
 		mapInfo = vsOther.mapInfo;
@@ -375,3 +416,6 @@ void VectorSpace::operator=(const VectorSpace& vsOther)
 		std::exit(EXIT_FAILURE);
 	}
 }
+
+template struct VectorSpaceT<float>;
+template struct VectorSpaceT<double>;
@@ -14,6 +14,9 @@
 * Update : 18/12/2021 - Modify the struct and add name variable for log. // @MGokcayK
 * Update : 19/12/2021 - Adding registerVector vector istead of registering in set method and `reset` method.// @MGokcayK
 * Update : 29/12/2021 - Adding getter and setter for `vValues` and `vNormalizedValues`. // @MGokcayK
+* Update : 19/10/2026 - Removing divergence check from `set` and adding `getVectorName`. // @MGokcayK
+* Update : 19/10/2026 - Templating on scalar type with float and double instantiations. // @MGokcayK
+* Update : 19/10/2026 - Adding `setSegment` for setting vectors without name lookup. // @MGokcayK
 */
 
 #pragma once
@@ -27,105 +30,117 @@ struct numberedInfos
 };
 
 // Struct a general VectorSpace which used for storing vectors and updates in numerical methods.
-struct VectorSpace
+template<typename T>
+struct VectorSpaceT
 {
 private:
 	// Finding index of vector whether if it is exist or not. If not, throw error.
 	std::unordered_map<std::string, numberedInfos>::const_iterator findIndex(const std::string& sVectorName);
 	
 	// Check mathematical operation of VectorSpace is proper or not. If not, throw error.
-	void checkOperation(const VectorSpace& vsOther, const std::string& operatorName);
+	void checkOperation(const VectorSpaceT& vsOther, const std::string& operatorName);
 
 public:
+	using VectorX = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
 	// Default Constructor.
-	VectorSpace() {};
+	VectorSpaceT() {};
 
 	// Named Constructor which can set the name of VectorSpace during Construction.
-	VectorSpace(const std::string& sName);
+	VectorSpaceT(const std::string& sName);
 
 	// Basic storage knowlagde of vector w.r.t its name, start index and size.
 	std::unordered_map<std::string, numberedInfos> mapInfo = {};
 	// Basic storage of vector values.
-	Eigen::VectorXf vDefault;
-	Eigen::VectorXf vValues;
-	Eigen::VectorXf vNormalizedValues;
-	Eigen::VectorXf vNormalizer;
-	Eigen::VectorXf vTemp;
+	VectorX vDefault;
+	VectorX vValues;
+	VectorX vNormalizedValues;
+	VectorX vNormalizer;
+	VectorX vTemp;
 
 	std::string sName = "vectorspace";
 
 	// Copying the VectorSpace into another VectorSpace without any checking.
-	void init(const VectorSpace& vsOther);
+	void init(const VectorSpaceT& vsOther);
 
 	// Reset VectorSpace. 
 	void reset();
 
 	// Registering vector into VectorSpace w.r.t name.
-	void registerVector(const std::string& sVectorName, const Eigen::VectorXf& vValue, const float& fNormalizer = 1.0f);
+	void registerVector(const std::string& sVectorName, const VectorX& vValue, const T& fNormalizer = 1.0f);
 
 	// Setting vector into VectorSpace w.r.t name. If vector is exist, set new value.
-	void set(const std::string& sVectorName, const Eigen::VectorXf& vValue);
+	void set(const std::string& sVectorName, const VectorX& vValue);
 
 	// Setting values of vector space by pointer of new value vector.
-	void setValues(float* vValue);
+	void setValues(T* vValue);
 
 	// Get vector from VectorSpace w.r.t name.
-	Eigen::VectorXf get(const std::string& sVectorName);
+	VectorX get(const std::string& sVectorName);
 
 	// Get vector value from VectorSpace w.r.t its name and index. It set the target value to only one 
 	// value. 
-	void get(float& fTarget, const std::string& sVectorName, const int& iIndex);
+	void get(T& fTarget, const std::string& sVectorName, const int& iIndex);
 
 	// Get vector from VectorSpace to destination Eigen based object w.r.t its name.
-	template<typename T>
-	void get(Eigen::MatrixBase<T>& mDestination, const std::string& sVectorName)
+	template<typename Derived>
+	void get(Eigen::MatrixBase<Derived>& mDestination, const std::string& sVectorName)
 	{
 		std::unordered_map<std::string, numberedInfos>::const_iterator ind = mapInfo.find(sVectorName);
 		if (ind == mapInfo.end()) std::cout << "vector `" << sVectorName << "` not found in " << sName << "!" << std::endl;
-		mDestination = Eigen::Map<Eigen::VectorXf> (vValues.data() + ind->second.index, ind->second.size);
+		mDestination = Eigen::Map<VectorX> (vValues.data() + ind->second.index, ind->second.size);
 	}
 
 	// Get vector from [] operator w.r.t its name.
-	Eigen::VectorXf operator[](const std::string& sVectorName);
+	VectorX operator[](const std::string& sVectorName);
 
 	// Get normalized vector from VectorSpace w.r.t name.
-	Eigen::VectorXf getNormalized(const std::string& sVectorName);
+	VectorX getNormalized(const std::string& sVectorName);
 
 	// Get normalized vector value from VectorSpace w.r.t its name and index. It set the target value to only one 
 	// value. 
-	void getNormalized(float& fTarget, const std::string& sVectorName, const int& iIndex);
+	void getNormalized(T& fTarget, const std::string& sVectorName, const int& iIndex);
 
 	// Get pointer and size of vector from VectorSpace. It is written for Python side.
 	// It return the pointer of vector.
-	float* getPointerAndSetSize(const std::string& sVectorName, int* iSizePtr);
+	T* getPointerAndSetSize(const std::string& sVectorName, int* iSizePtr);
 
 	// Get pointer and size of normalized vector from VectorSpace. It is written for Python side.
 	// It return the pointer of vector.
-	float* getNormalizedPointerAndSetSize(const std::string& sVectorName, int* iSizePtr);
+	T* getNormalizedPointerAndSetSize(const std::string& sVectorName, int* iSizePtr);
 
 	// Get value of Vectorspace at `iIndex`.
-	const float& getValue(int iIndex);
+	const T& getValue(int iIndex);
 
 	// Get vector of Vectorspace form `iIndex` with size `iSize`.
-	Eigen::VectorXf getValue(int iIndex, int iSize);
+	VectorX getValue(int iIndex, int iSize);
 
 	// Set value of Vectorspace at `iIndex`.
-	void setValue(int iIndex, float fNewValue);
+	void setValue(int iIndex, T fNewValue);
 
 	// Set vector of Vectorspace form `iIndex` with size `iSize`.
-	void setValue(int iIndex, Eigen::VectorXf vNewValue);
+	void setValue(int iIndex, VectorX vNewValue);
 
 	// Get normalized value of Vectorspace at `iIndex`.
-	const float& getNormalizedValue(int iIndex);
+	const T& getNormalizedValue(int iIndex);
 
 	// Get normalized vector of Vectorspace form `iIndex` with size `iSize`.
-	Eigen::VectorXf getNormalizedValue(int iIndex, int iSize);
+	VectorX getNormalizedValue(int iIndex, int iSize);
 
 	// Set normalized value of Vectorspace at `iIndex`.
-	void setNormalizedValue(int iIndex, float fNewValue);
+	void setNormalizedValue(int iIndex, T fNewValue);
 
 	// Set normalized vector of Vectorspace form `iIndex` with size `iSize`.
-	void setNormalizedValue(int iIndex, Eigen::VectorXf vNewValue);
+	void setNormalizedValue(int iIndex, VectorX vNewValue);
+
+	// Set vector of Vectorspace from `iIndex` without name lookup and temporary vector. It is
+	// used in hot paths with indices which are found once.
+	template<typename Derived>
+	void setSegment(Eigen::Index iIndex, const Eigen::MatrixBase<Derived>& vNewValue)
+	{
+		vValues.segment(iIndex, vNewValue.size()) = vNewValue;
+		vNormalizedValues.segment(iIndex, vNewValue.size()) = vNewValue.array() / (vNormalizer.segment(iIndex, vNewValue.size()).array() + EPS);
+	}
 
 	// Set all values to zero
 	void setAllValuesToZero();
@@ -133,35 +148,41 @@ public:
 	// Divergence flag.
 	bool isDiverged();
 
+	// Get name of vector and its element index which stores the value at `iIndex`.
+	std::string getVectorName(int iIndex);
+
 	// Set all values and normalized values to default state which equals to registered values.
 	void toDefault();
 
 	// Addition operator of two VectorSpace. It checks wheter two VectorSpace has same size or not.
-	VectorSpace operator+(const VectorSpace& vsOther);
+	VectorSpaceT operator+(const VectorSpaceT& vsOther);
 
 	// Addition operator of VectorSpace and float. It adds the float to all elements in VectorSpace.
-	VectorSpace operator+(const float& fOther);
+	VectorSpaceT operator+(const T& fOther);
 
 	// Subtraction operator of two VectorSpace. It checks wheter two VectorSpace has same size or not.
-	VectorSpace operator-(const VectorSpace& vsOther);
+	VectorSpaceT operator-(const VectorSpaceT& vsOther);
 
 	// Subtraction operator of VectorSpace and float. It subtract the float to all elements in VectorSpace.
-	VectorSpace operator-(const float& fOther);
+	VectorSpaceT operator-(const T& fOther);
 	
 	// Multiplication operator of two VectorSpace. It checks wheter two VectorSpace has same size or not.
 	// It multiply same indexes into each other.
-	VectorSpace operator*(const VectorSpace& vsOther);
+	VectorSpaceT operator*(const VectorSpaceT& vsOther);
 
 	// Multiplication operator of VectorSpace and float. It multiply the float to all elements in VectorSpace.
-	VectorSpace operator*(const float& fOther);
+	VectorSpaceT operator*(const T& fOther);
 
 	// Division operator of two VectorSpace. It checks wheter two VectorSpace has same size or not.
 	// It divide same indexes into each other.
-	VectorSpace operator/(const VectorSpace& vsOther);
+	VectorSpaceT operator/(const VectorSpaceT& vsOther);
 
 	// Division operator of VectorSpace and float. It divide the float to all elements in VectorSpace.
-	VectorSpace operator/(const float& fOther);
+	VectorSpaceT operator/(const T& fOther);
 
 	// Assign operator of two VectorSpace. It checks wheter two VectorSpace has same size or not.
-	void operator=(const VectorSpace& vsOther);
-};
\ No newline at end of file
+	void operator=(const VectorSpaceT& vsOther);
+};
+
+// VectorSpace of single precision which is used by the library and API.
+using VectorSpace = VectorSpaceT<float>;
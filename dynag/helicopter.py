@@ -49,7 +49,9 @@ class HelicopterGym(gym.Env, EzPickle):
         EzPickle.__init__(self)
         
         self.DT = dt
-        self.helicopter = Helicopter(heli_name, self.DT)
+        # Dynamics is taken from pool, so envs which are created and closed in a
+        # long-lived worker recycle their instances.
+        self.helicopter = Helicopter(heli_name, self.DT, pooled=True)
         self.observation_space = spaces.Box(-np.inf, np.inf, shape=(self.helicopter.getNumberOfDynamicsObservation,), dtype=np.float32)
         self.action_space = spaces.Box(-1, +1, (4,), dtype=np.float32)
         self.successed_time = 0 # time counter for successing task through time.
@@ -58,9 +60,11 @@ class HelicopterGym(gym.Env, EzPickle):
         self.renderer = Renderer(w=1024, h=768, title='DynaG')
         self.renderer.setFPS(FPS)
         self.helicopter.createRendererObject(self.renderer)        
-        self.terrain = self.renderer.createModel('/resources/models/terrain/terrain.obj',
-                                                 '/resources/shaders/terrain_vertex.vs',
-                                                 '/resources/shaders/terrain_frag.fs')
+        # Terrain is created from the same height map as dynamics' ground.
+        self.terrain = self.renderer.createTerrain(self.helicopter.getValueFromYamlFile("ENV", "NS_MAX") * FT2MTR,
+                                                   self.helicopter.getValueFromYamlFile("ENV", "EW_MAX") * FT2MTR,
+                                                   (self.helicopter.getValueFromYamlFile("ENV", "MAX_GR_ALT") - 
+                                                    self.helicopter.getValueFromYamlFile("ENV", "MIN_GR_ALT")) * FT2MTR)
         
         self.renderer.addPermanentObject2Window(self.terrain)        
         self.sky = self.renderer.createModel('/resources/models/sky/sky.obj')
@@ -146,6 +150,7 @@ class HelicopterGym(gym.Env, EzPickle):
     def close(self):
         self.renderer.close()
         self.renderer.terminate()
+        self.helicopter.close()
     
     def exit(self):
         sys.exit()
@@ -38,9 +38,8 @@ def randomStartPoint(env, start_point=(0.0, 0.0, 0.0), deviation = 200, alt_low
     env.n_pos = xy[0]
     env.e_pos = xy[1]
 
-    env.helicopter.setTrimValueInYamlFile("GR_ALT", gr_alt)
-    env.helicopter.setTrimValueInYamlFile("N_POS", xy[0])
-    env.helicopter.setTrimValueInYamlFile("E_POS", xy[1])
+    ids = [env.helicopter.getParameterId("TRIM", name) for name in ("GR_ALT", "N_POS", "E_POS")]
+    env.helicopter.setParameters(ids, [gr_alt, xy[0], xy[1]])
 
 
 def randomTargetPoint(env):
@@ -82,9 +81,8 @@ def randomWeightAndCG(env):
     env.weight = 3500 + np.random.rand() * 1901
     env.fs_cg = 128.7 + np.random.rand() * 8
     env.wl_cg = 34.5 + np.random.rand() * 8
-    env.helicopter.setValueInYamlFile("HELI", "WT", env.weight)
-    env.helicopter.setValueInYamlFile("HELI", "FS_CG", env.fs_cg )
-    env.helicopter.setValueInYamlFile("HELI", "WL_CG", env.wl_cg )
+    ids = [env.helicopter.getParameterId("HELI", name) for name in ("WT", "FS_CG", "WL_CG")]
+    env.helicopter.setParameters(ids, [env.weight, env.fs_cg, env.wl_cg])
 
 
 
@@ -8,6 +8,11 @@
 # C.Date : 04/05/2021
 # Update : 04/05/2021 - Initialization & Implementation // @MGokcayK
 # Update : 05/01/2022 - Adding new guiText methods // @MGokcayK
+# Update : 19/10/2026 - Adding model cache options // @MGokcayK
+# Update : 19/10/2026 - Adding chunked LOD terrain // @MGokcayK
+# Update : 19/10/2026 - Adding culling methods // @MGokcayK
+# Update : 19/10/2026 - Adding render stats methods // @MGokcayK
+# Update : 19/10/2026 - Adding addModelRotationPivot method // @MGokcayK
 #
 # Last update information of API can find from `src/ren_api.h`
 
@@ -87,6 +92,19 @@ def terminate():
     """
     lib.terminateWindow()
 
+###################################################################################
+lib.setModelCache.argtypes = [ctypes.c_bool, ctypes.c_bool]
+lib.setModelCache.restype = ctypes.c_void_p
+
+def setModelCache(enable, compress_textures):
+    """
+        Set binary model cache options. Cache is written next to model as 
+        `<model>.dgcache` at first load and memory mapped at later loads.
+        >>> enable            : Enable/disable model cache.
+        >>> compress_textures : Compress cached textures to BCn (S3TC) if it is supported.
+    """
+    lib.setModelCache(enable, compress_textures)
+
 ###################################################################################
 lib.createModel.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p]
 lib.createModel.restype = ctypes.c_void_p
@@ -102,6 +120,33 @@ def createModel(object_path, vertex_shader_path, fragment_shader_path):
                             ctypes.c_char_p(_to_encode(vertex_shader_path)),
                             ctypes.c_char_p(_to_encode(fragment_shader_path)))
 
+###################################################################################
+lib.createTerrain.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p,
+                              ctypes.c_float, ctypes.c_float, ctypes.c_float,
+                              ctypes.c_char_p, ctypes.c_char_p]
+lib.createTerrain.restype = ctypes.c_void_p
+
+def createTerrain(height_map_path, normal_map_path, texture_path, 
+                  north_span, east_span, max_height,
+                  vertex_shader_path, fragment_shader_path):
+    """
+        Create chunked LOD terrain from the same height and normal maps as dynamics.
+        >>> height_map_path      : Path of 16-bit height map.
+        >>> normal_map_path      : Path of normal map.
+        >>> texture_path         : Path of diffuse texture of terrain.
+        >>> north_span           : Span of terrain in north-south axis.
+        >>> east_span            : Span of terrain in east-west axis.
+        >>> max_height           : Height of the white pixel of height map.
+        >>> vertex_shader_path   : Path of vertex shader of terrain. 
+        >>> fragment_shader_path : Path of fragment shader of terrain.
+    """
+    return lib.createTerrain(ctypes.c_char_p(_to_encode(height_map_path)),
+                            ctypes.c_char_p(_to_encode(normal_map_path)),
+                            ctypes.c_char_p(_to_encode(texture_path)),
+                            ctypes.c_float(north_span), ctypes.c_float(east_span), ctypes.c_float(max_height),
+                            ctypes.c_char_p(_to_encode(vertex_shader_path)),
+                            ctypes.c_char_p(_to_encode(fragment_shader_path)))
+
 ###################################################################################
 lib.addPermanent2Window.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
 lib.addPermanent2Window.restypes = ctypes.c_void_p
@@ -171,6 +216,76 @@ def scaleModel(model, x, y, z):
     """
     lib.scaleModel(model, x, y, z)
 
+###################################################################################
+lib.setModelDrawDistance.argtypes = [ctypes.c_void_p, ctypes.c_float]
+lib.setModelDrawDistance.restype = ctypes.c_void_p
+
+def setModelDrawDistance(model, distance):
+    """
+        Set maximum draw distance of the model. Zero means no limit.
+        >>> model    : Address of model.
+        >>> distance : Maximum distance from camera to draw the model.
+    """
+    lib.setModelDrawDistance(model, distance)
+
+###################################################################################
+lib.addModelRotationPivot.argtypes = [ctypes.c_void_p, ctypes.c_float, ctypes.c_float, ctypes.c_float]
+lib.addModelRotationPivot.restype = ctypes.c_void_p
+
+def addModelRotationPivot(model, x, y, z):
+    """
+        Add pivot which vertex shader of the model rotates parts about. Model bounds
+        enclose every rotation about it and meshes are not culled one by one.
+        >>> model : Address of model.
+        >>> x     : X coordinate of pivot in model space of object file.
+        >>> y     : Y coordinate of pivot in model space of object file.
+        >>> z     : Z coordinate of pivot in model space of object file.
+    """
+    lib.addModelRotationPivot(model, x, y, z)
+
+###################################################################################
+lib.getDrawCounts.argtypes = [ctypes.c_void_p, np.ctypeslib.ndpointer(dtype=np.int32, flags='C_CONTIGUOUS')]
+lib.getDrawCounts.restype = ctypes.c_void_p
+
+def getDrawCounts(window):
+    """
+        Get number of drawn and culled parts (meshes or terrain chunks) at the 
+        last render as [drawn, culled].
+        >>> window : Address of window.
+    """
+    counts = np.zeros(2, dtype=np.int32)
+    lib.getDrawCounts(window, counts)
+    return counts
+
+###################################################################################
+RENDER_STATS = ["cpu_draw", "cpu_gui", "cpu_swap", "gpu_draw", "gpu_gui", 
+                "sleep", "frame", "drawn", "culled"]
+
+lib.getRenderStats.argtypes = [ctypes.c_void_p, np.ctypeslib.ndpointer(dtype=np.float32, flags='C_CONTIGUOUS')]
+lib.getRenderStats.restype = ctypes.c_void_p
+
+def getRenderStats(window):
+    """
+        Get smoothed render stats of the window. Times are in milliseconds and 
+        order of stats is same as `RENDER_STATS`.
+        >>> window : Address of window.
+    """
+    stats = np.zeros(len(RENDER_STATS), dtype=np.float32)
+    lib.getRenderStats(window, stats)
+    return stats
+
+###################################################################################
+lib.showRenderStats.argtypes = [ctypes.c_void_p, ctypes.c_bool]
+lib.showRenderStats.restype = ctypes.c_void_p
+
+def showRenderStats(window, show):
+    """
+        Show/hide render stats panel of the window.
+        >>> window : Address of window.
+        >>> show   : Whether panel is shown or not.
+    """
+    lib.showRenderStats(window, show)
+
 ###################################################################################
 lib.getFps.argtypes = [ctypes.c_void_p]
 lib.getFps.restype = ctypes.c_float
@@ -49,6 +49,13 @@ class Renderer(object):
         """
         renderAPI.terminate()
 
+    def setModelCache(self, enable = True, compress_textures = False):
+        """
+            Set binary model cache options which are used by models created afterwards.
+            Cache removes model parsing and texture decoding from startup after the first load.
+        """
+        renderAPI.setModelCache(enable, compress_textures)
+
     def createModel(self, rel_path = None, 
                 vertex_shader_path = "/resources/shaders/vertex_base.vs", 
                 fragment_shader_path = "/resources/shaders/frag_base.fs", 
@@ -69,6 +76,25 @@ class Renderer(object):
                                     vertex_shader_path,
                                     fragment_shader_path)
 
+    def createTerrain(self, north_span, east_span, max_height,
+                height_map_path = "/resources/models/terrain/terrain_hmap.png",
+                normal_map_path = "/resources/models/terrain/terrain_normal.png",
+                texture_path = "/resources/models/terrain/terrain_texture.png",
+                vertex_shader_path = "/resources/shaders/terrain_chunk_vertex.vs", 
+                fragment_shader_path = "/resources/shaders/terrain_frag.fs"):
+        """
+            Create chunked LOD terrain from height and normal maps which are used by
+            dynamics, so that the rendered ground matches the ground of dynamics.
+            Spans and max height should be in meters. Paths are relative paths.
+        """
+        base = os.path.dirname(os.path.realpath(__file__))
+        return renderAPI.createTerrain(base + height_map_path, 
+                                    base + normal_map_path,
+                                    base + texture_path,
+                                    north_span, east_span, max_height,
+                                    base + vertex_shader_path,
+                                    base + fragment_shader_path)
+
     def addPermanentObject2Window(self, model):
         """
             Add model to `Renderer's` window as permanent drawable objects.
@@ -116,6 +142,40 @@ class Renderer(object):
         # Z-axis is Y-axis is altered. 
         renderAPI.scaleModel(model, x, -z, y)
 
+    def setModelDrawDistance(self, model, distance):
+        """
+            Set maximum draw distance of model. Model is culled if it is farther 
+            than the distance. Zero means no limit.
+        """
+        renderAPI.setModelDrawDistance(model, distance)
+
+    def addModelRotationPivot(self, model, x, y, z):
+        """
+            Add pivot which vertex shader of model rotates parts about (e.g. rotor 
+            hubs). Pivot is in model space of object file, so axes are not altered.
+        """
+        renderAPI.addModelRotationPivot(model, x, y, z)
+
+    def getDrawCounts(self):
+        """
+            Get number of drawn and culled parts (meshes or terrain chunks) of 
+            `Renderer's` window at the last render as [drawn, culled].
+        """
+        return renderAPI.getDrawCounts(self.window)
+
+    def getRenderStats(self):
+        """
+            Get smoothed render stats of `Renderer's` window as dictionary. 
+            Times are in milliseconds.
+        """
+        return dict(zip(renderAPI.RENDER_STATS, renderAPI.getRenderStats(self.window)))
+
+    def showRenderStats(self, show = True):
+        """
+            Show/hide render stats panel of `Renderer's` window.
+        """
+        renderAPI.showRenderStats(self.window, show)
+
     def getFPS(self):
         """
             Get FPS of `Renderer's` window.
@@ -0,0 +1,52 @@
+#version 330 core
+layout (location = 0) in vec3 aPos; // grid x, grid y and skirt flag
+
+
+out vec2 TexCoords;
+out vec3 Normal;
+out vec3 FragPos;
+out vec3 ocamPos;
+out float d;
+
+uniform mat4 model;
+
+layout (std140) uniform UBObjects
+{
+    mat4 projection_view;
+    vec3 camPos;
+};
+
+uniform mat4 inversedTransposedModel;
+
+uniform sampler2D height_map;
+uniform sampler2D normal_map;
+
+// Terrain parameters. Columns of maps are along north (x) and rows of maps 
+// are along east (z) as in dynamics.
+uniform vec2 pixelSize;
+uniform vec2 mapCenter;
+uniform float heightScale;
+
+// Chunk parameters in pixels.
+uniform vec2 chunkOrigin;
+uniform float chunkStep;
+uniform float skirtDepth;
+
+void main()
+{
+    ivec2 size = textureSize(height_map, 0);
+    ivec2 pixel = clamp(ivec2(chunkOrigin + aPos.xy * chunkStep), ivec2(0), size - 1);
+
+    // Height and normal of the pixel are the same as dynamics uses.
+    float height = texelFetch(height_map, pixel, 0).r * heightScale - aPos.z * skirtDepth;
+    vec3 normal = texelFetch(normal_map, pixel, 0).rgb * 2.0f - 1.0f; // north, east, up
+    vec3 pos = vec3((pixel.x - mapCenter.x) * pixelSize.x, height, (pixel.y - mapCenter.y) * pixelSize.y);
+
+    TexCoords = (vec2(pixel) + 0.5f) / vec2(size);
+    Normal = mat3(inversedTransposedModel) * vec3(normal.x, normal.z, normal.y);
+
+    FragPos = vec3(model * vec4(pos, 1.0f));
+    ocamPos = camPos;
+    d = distance(FragPos, camPos);
+	gl_Position = projection_view * vec4(FragPos, 1.0f);
+}
@@ -0,0 +1,110 @@
+/*
+* DynaG Renderer C++ / Frustum
+*
+* View frustum of the camera for culling the drawables which are out of view.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Box transformation and distance helpers // @MGokcayK
+*/
+
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+#include <cfloat>
+
+// Frustum planes which are extracted from projection-view matrix (Gribb & Hartmann).
+// Plane normals point inside of the frustum.
+struct Frustum
+{
+    // Left, right, bottom, top, near and far planes as (normal, distance).
+    glm::vec4 vPlanes[6];
+
+    Frustum()
+    {
+        // Frustum which contains everything.
+        for (int i = 0; i < 6; i++) vPlanes[i] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    explicit Frustum(const glm::mat4& mProjectionView)
+    {
+        // glm matrices are column-major, so rows are collected explicitly.
+        glm::vec4 row[4];
+        for (int i = 0; i < 4; i++)
+            row[i] = glm::vec4(mProjectionView[0][i], mProjectionView[1][i], mProjectionView[2][i], mProjectionView[3][i]);
+
+        vPlanes[0] = row[3] + row[0];
+        vPlanes[1] = row[3] - row[0];
+        vPlanes[2] = row[3] + row[1];
+        vPlanes[3] = row[3] - row[1];
+        vPlanes[4] = row[3] + row[2];
+        vPlanes[5] = row[3] - row[2];
+
+        for (int i = 0; i < 6; i++)
+            vPlanes[i] /= glm::length(glm::vec3(vPlanes[i]));
+    }
+
+    // Check whether axis aligned box intersects with frustum or not.
+    bool isBoxVisible(const glm::vec3& vMin, const glm::vec3& vMax) const
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            // Corner of the box which is the farthest along the plane normal.
+            glm::vec3 p(vPlanes[i].x > 0.0f ? vMax.x : vMin.x,
+                        vPlanes[i].y > 0.0f ? vMax.y : vMin.y,
+                        vPlanes[i].z > 0.0f ? vMax.z : vMin.z);
+            if (glm::dot(glm::vec3(vPlanes[i]), p) + vPlanes[i].w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    // Check whether sphere intersects with frustum or not.
+    bool isSphereVisible(const glm::vec3& vCenter, float fRadius) const
+    {
+        for (int i = 0; i < 6; i++)
+        {
+            if (glm::dot(glm::vec3(vPlanes[i]), vCenter) + vPlanes[i].w < -fRadius)
+                return false;
+        }
+        return true;
+    }
+};
+
+// Axis aligned box which contains the box transformed by the matrix.
+inline void transformBox(const glm::mat4& mTransform, const glm::vec3& vMin, const glm::vec3& vMax,
+                         glm::vec3& vOutMin, glm::vec3& vOutMax)
+{
+    vOutMin = glm::vec3(FLT_MAX);
+    vOutMax = glm::vec3(-FLT_MAX);
+    for (int k = 0; k < 8; k++)
+    {
+        glm::vec3 vCorner((k & 1) ? vMax.x : vMin.x,
+                          (k & 2) ? vMax.y : vMin.y,
+                          (k & 4) ? vMax.z : vMin.z);
+        vCorner = glm::vec3(mTransform * glm::vec4(vCorner, 1.0f));
+        vOutMin = glm::min(vOutMin, vCorner);
+        vOutMax = glm::max(vOutMax, vCorner);
+    }
+}
+
+// Transform bounding sphere by the matrix. Radius is scaled with the largest axis scale.
+inline void transformSphere(const glm::mat4& mTransform, const glm::vec3& vCenter, float fRadius,
+                            glm::vec3& vOutCenter, float& fOutRadius)
+{
+    vOutCenter = glm::vec3(mTransform * glm::vec4(vCenter, 1.0f));
+    float fScale = glm::max(glm::length(glm::vec3(mTransform[0])), 
+                            glm::max(glm::length(glm::vec3(mTransform[1])), glm::length(glm::vec3(mTransform[2]))));
+    fOutRadius = fRadius * fScale;
+}
+
+// Distance from the point to the axis aligned box. It is zero if the point is in the box.
+inline float distanceToBox(const glm::vec3& vPoint, const glm::vec3& vMin, const glm::vec3& vMax)
+{
+    return glm::length(glm::max(glm::max(vMin - vPoint, vPoint - vMax), glm::vec3(0.0f)));
+}
+
+#endif
@@ -117,6 +117,9 @@ Window::Window(const unsigned int SCR_WIDTH,
     glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::vec4), sizeof(glm::vec4), glm::value_ptr(density_grad));
     
     glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Create timer queries of render profiler.
+    rpProfiler.init();
 }
 
 
@@ -134,6 +137,7 @@ void Window::render()
         // Camera/view transformation.
         glm::mat4 view = cmCamera->getViewMatrix();
         mProjectionView = projection * view;
+        frFrustum = Frustum(mProjectionView);
 
         // Set project_view as Uniform Buffer Objects 
         glBindBuffer(GL_UNIFORM_BUFFER, iUbo);
@@ -146,17 +150,25 @@ void Window::render()
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
         // Draw objects.
+        rpProfiler.beginPhase(PHASE_DRAW);
         this->draw();     
+        rpProfiler.endPhase(PHASE_DRAW);
+        rpProfiler.setStat(STAT_DRAWN, (float)iDrawnCount);
+        rpProfiler.setStat(STAT_CULLED, (float)iCulledCount);
 
         // Render gui.
+        rpProfiler.beginPhase(PHASE_GUI);
         this->renderGUI();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        rpProfiler.endPhase(PHASE_GUI);
         
         // Swap buffer to render the context
+        rpProfiler.beginPhase(PHASE_SWAP);
         glfwSwapBuffers(wWindow);
 
         // Poll OpenGL events.
         glfwPollEvents();        
+        rpProfiler.endPhase(PHASE_SWAP);
 
         // If OpenGL FPS is higher than dynamics' FPS (which calculated in Python side)
         // wait some times to sync them.
@@ -168,14 +180,19 @@ void Window::render()
         auto diff =  (secDt - durDeltaTime);
 
         // If there is difference, wait that much time.
+        auto tpSleepStart = std::chrono::steady_clock::now();
         if (diff.count() > 0)
         {
             this->preciseSleep(diff.count()/1e9);
         } 
+        std::chrono::duration<float, std::milli> durSleep = std::chrono::steady_clock::now() - tpSleepStart;
+        rpProfiler.setStat(STAT_SLEEP, durSleep.count());
 
         // Calculate FPS from last rendered frame.
         auto dt1 =  std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tpLastFrame);
         fFPS = 1.0f / (dt1.count() / 1e9f);
+        rpProfiler.setStat(STAT_FRAME, dt1.count() / 1e6f);
+        rpProfiler.endFrame();
 
         // Set current time as last frame time.
         tpLastFrame = std::chrono::steady_clock::now();
@@ -246,6 +263,24 @@ void Window::renderGUI()
         ImGui::End();
     }
 
+    // Render profiler panel at top-right corner.
+    if (bShowRenderStats)
+    {
+        const float* stats = rpProfiler.fStats;
+        ImGui::SetNextWindowPos(ImVec2(fScrWidth - 250.0f, 30.0f));
+        ImGui::SetNextWindowSize(ImVec2(220.0f, 0.0f));
+        ImGui::Begin("Render Stats");
+        ImGui::Text("            CPU [ms]  GPU [ms]");
+        ImGui::Text("DRAW      : %7.3f   %7.3f", stats[STAT_CPU_DRAW], stats[STAT_GPU_DRAW]);
+        ImGui::Text("GUI       : %7.3f   %7.3f", stats[STAT_CPU_GUI], stats[STAT_GPU_GUI]);
+        ImGui::Text("SWAP      : %7.3f", stats[STAT_CPU_SWAP]);
+        ImGui::Text("SLEEP     : %7.3f", stats[STAT_SLEEP]);
+        ImGui::Text("FRAME     : %7.3f", stats[STAT_FRAME]);
+        ImGui::Text("DRAWN     : %5.0f", stats[STAT_DRAWN]);
+        ImGui::Text("CULLED    : %5.0f", stats[STAT_CULLED]);
+        ImGui::End();
+    }
+
     // Render the gui.
     ImGui::Render();
 }
@@ -325,14 +360,21 @@ void Window::addInstantaneousDrawables(Model* drawable)
 
 void Window::draw()
 {
+	iDrawnCount = 0;
+	iCulledCount = 0;
+
 	for (int i = 0; i < vPermanentDrawables.size(); i++)
 	{
-		vPermanentDrawables[i]->draw();
+		vPermanentDrawables[i]->draw(frFrustum, cmCamera->vPosition);
+		iDrawnCount += vPermanentDrawables[i]->iDrawnCount;
+		iCulledCount += vPermanentDrawables[i]->iCulledCount;
 	}
 
 	for (int i = 0; i < vInstantaneousDrawables.size(); i++)
 	{
-		vInstantaneousDrawables[i]->draw();
+		vInstantaneousDrawables[i]->draw(frFrustum, cmCamera->vPosition);
+		iDrawnCount += vInstantaneousDrawables[i]->iDrawnCount;
+		iCulledCount += vInstantaneousDrawables[i]->iCulledCount;
 	}
 	vInstantaneousDrawables.clear();
 }
@@ -8,6 +8,9 @@
 *
 * C.Date : 04/05/2021
 * Update : 04/05/2021 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Passing camera frustum to drawables // @MGokcayK
+* Update : 19/10/2026 - Drawn and culled counts of drawables // @MGokcayK
+* Update : 19/10/2026 - Render profiler and its gui panel // @MGokcayK
 */
 
 #ifndef GWINDOW_H
@@ -15,6 +18,7 @@
 
 #include "camera.h"
 #include "model.h"
+#include "profiler.h"
 
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw.h"
@@ -86,6 +90,9 @@ private:
     // Projection view for vertex-shaders for each shader.
     glm::mat4 mProjectionView = glm::mat4(1.0f);
 
+    // Camera frustum of the current frame which is extracted from `mProjectionView`.
+    Frustum frFrustum;
+
 public:
     // Base window if GLFW.
     GLFWwindow* wWindow;
@@ -98,6 +105,14 @@ public:
     float fFPSLimit = 100.0; 
     std::chrono::nanoseconds secDt{static_cast<long int>( 1000000000.0f/fFPSLimit)};
 
+    // Number of drawn and culled parts (meshes or terrain chunks) of drawables at the last render.
+    int iDrawnCount = 0;
+    int iCulledCount = 0;
+
+    // Profiler of render phases and whether its gui panel is shown or not.
+    RenderProfiler rpProfiler;
+    bool bShowRenderStats = false;
+
     // Text vector pointer vector which stores different 
     // guiTextSection pointer.
     std::vector<guiTextSection*> vGuiTextSection;
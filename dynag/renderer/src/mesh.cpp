@@ -1,5 +1,7 @@
 #include "mesh.h"
 
+#include <cfloat>
+
 
 Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, std::vector<float> opacity)
 {
@@ -8,7 +10,15 @@ Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std:
     vTextures = textures;
     vOpacity = opacity;
 
-    setupMesh();
+    setupMesh(vVertices.data(), (unsigned int)vVertices.size(), vIndices.data(), (unsigned int)vIndices.size());
+}
+
+Mesh::Mesh(const Vertex* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount, std::vector<Texture> textures, std::vector<float> opacity)
+{
+    vTextures = textures;
+    vOpacity = opacity;
+
+    setupMesh(vertices, vertexCount, indices, indexCount);
 }
 
 
@@ -44,15 +54,28 @@ void Mesh::draw(Shader &shader)
     
     // Draw mesh
     glBindVertexArray(iVao);
-    glDrawElements(GL_TRIANGLES, (int)vIndices.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, (int)iIndexCount, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
 
     // Always good practice to set everything back to defaults once configured.
     glActiveTexture(GL_TEXTURE0);
 }
 
-void Mesh::setupMesh()
+void Mesh::setupMesh(const Vertex* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount)
 {
+    iIndexCount = indexCount;
+
+    // Bounding sphere of the mesh from its bounding box.
+    glm::vec3 vMin = glm::vec3(FLT_MAX);
+    glm::vec3 vMax = glm::vec3(-FLT_MAX);
+    for (unsigned int i = 0; i < vertexCount; i++)
+    {
+        vMin = glm::min(vMin, vertices[i].vPosition);
+        vMax = glm::max(vMax, vertices[i].vPosition);
+    }
+    vBoundsCenter = (vertexCount > 0) ? 0.5f * (vMin + vMax) : glm::vec3(0.0f);
+    fBoundsRadius = (vertexCount > 0) ? 0.5f * glm::length(vMax - vMin) : 0.0f;
+
     // Create buffers/arrays
     glGenVertexArrays(1, &iVao);
     glGenBuffers(1, &iVbo);
@@ -63,29 +86,23 @@ void Mesh::setupMesh()
 
     // Load data into vertex buffers
     glBindBuffer(GL_ARRAY_BUFFER, iVbo);
-    glBufferData(GL_ARRAY_BUFFER, vVertices.size() * sizeof(Vertex), &vVertices[0], GL_STATIC_DRAW);  
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), vertices, GL_STATIC_DRAW);  
 
     // Load data into element buffer object.
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iEbo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, vIndices.size() * sizeof(unsigned int), &vIndices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int), indices, GL_STATIC_DRAW);
 
     // Set the vertex attribute pointers.
     
     // vertex Positions
     glEnableVertexAttribArray(0);	
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-    // vertex normals
+    // vertex normals (packed, normalized to [-1, 1] while fetching)
     glEnableVertexAttribArray(1);	
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, vNormal));
+    glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, iNormal));
     // vertex texture coords
     glEnableVertexAttribArray(2);	
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, vTexCoords));
-    // vertex tangent
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, vTangent));
-    // vertex bitangent
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, vBitangent));
 
     glBindVertexArray(0);
 }
@@ -7,25 +7,27 @@
 *
 * C.Date : 04/05/2021
 * Update : 04/05/2021 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Compact vertex format with packed normals. // @MGokcayK
+* Update : 19/10/2026 - Creating mesh from raw (cached) vertex/index data. // @MGokcayK
+* Update : 19/10/2026 - Bounding sphere of mesh for culling. // @MGokcayK
 */
 
 #ifndef MESH_H
 #define MESH_H
 
 #include "shader.h"
+#include <glm/gtc/packing.hpp>
 
-// Vertex structure for store related parameters.
+// Vertex structure for store related parameters. Shaders do not use tangent 
+// and bitangent; therefore, they are not stored. Normal is packed into 
+// GL_INT_2_10_10_10_REV format which makes the vertex 24 bytes instead of 56 bytes.
 struct Vertex {
     // position
     glm::vec3 vPosition;
-    // normal
-    glm::vec3 vNormal;
+    // packed normal
+    glm::uint32 iNormal;
     // texCoords
     glm::vec2 vTexCoords;
-    // tangent
-    glm::vec3 vTangent;
-    // bitangent
-    glm::vec3 vBitangent;
 };
 
 // Texture store structure.
@@ -43,10 +45,18 @@ public:
     std::vector<Texture>      vTextures;
     std::vector<float>        vOpacity;
     unsigned int iVao;
+    unsigned int iIndexCount;
+    // Bounding sphere of vertices in model space which is centered at the center of 
+    // the bounding box. It does not include movement of vertices in vertex shaders.
+    glm::vec3 vBoundsCenter;
+    float fBoundsRadius;
     std::string sOpacityName = "opacity";
 
     // Constructor
     Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, std::vector<float> opacity);
+
+    // Constructor which uploads raw data directly without keeping a CPU copy of vertices and indices.
+    Mesh(const Vertex* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount, std::vector<Texture> textures, std::vector<float> opacity);
     
     // Render the mesh
     void draw(Shader &shader);
@@ -56,6 +66,6 @@ private:
     unsigned int iVbo, iEbo;
 
     // Initializes all the buffer objects/arrays
-    void setupMesh();
+    void setupMesh(const Vertex* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount);
 };
 #endif
\ No newline at end of file
@@ -8,10 +8,24 @@ Model::Model(std::string const &path,
 {
     // Load model from path
     loadModel(path);
+    calculateBounds();
 
     // Create shader from paths
     create_shader(vertex_shader_file_path, fragment_shader_file_path);
 
+    bindUniformBlocks();
+}
+
+Model::Model(std::string vertex_shader_file_path, std::string fragment_shader_file_path)
+{
+    // Create shader from paths
+    create_shader(vertex_shader_file_path, fragment_shader_file_path);
+
+    bindUniformBlocks();
+}
+
+void Model::bindUniformBlocks()
+{
     // Get unifrom Block Index from shader for UBObjects block
     unsigned int uniformBlockIndex = glGetUniformBlockIndex(shader->ID, "UBObjects");
     // Link shader's uniform block to uniform binding point
@@ -26,7 +40,6 @@ Model::Model(std::string const &path,
     unsigned int uniformFogBlockIndex = glGetUniformBlockIndex(shader->ID, "FogBlock");
     // Link shader's uniform block to uniform binding point
     glUniformBlockBinding(shader->ID, uniformFogBlockIndex, 2);
-
 }
 
 void Model::create_shader(std::string vertex_shader_file_path, std::string fragment_shader_file_path)
@@ -36,8 +49,20 @@ void Model::create_shader(std::string vertex_shader_file_path, std::string fragm
 }
 
 
-void Model::draw()
+void Model::draw(const Frustum& frustum, const glm::vec3& vCameraPosition)
 {      
+    iDrawnCount = 0;
+    iCulledCount = 0;
+
+    // Cull the whole model first.
+    if (!isSphereVisible(frustum, vCameraPosition, vBoundsCenter, fBoundsRadius))
+    {
+        iCulledCount = (int)vMeshes.size();
+        mModel = mBaseModel;
+        clearContainers();
+        return;
+    }
+
     // Use model's shader and set some uniforms.
     shader->use();
 
@@ -46,10 +71,16 @@ void Model::draw()
     shader->setMat4("model", mModel);
     shader->setMat4("inversedTransposedModel", glm::inverseTranspose(mModel));
 
-    // Draw meshs of the model.
+    // Draw visible meshs of the model.
     for (unsigned int i = 0; i < vMeshes.size(); i++)
     {
+        if (vMeshes.size() > 1 && vRotationPivots.empty() && !isSphereVisible(frustum, vCameraPosition, vMeshes[i].vBoundsCenter, vMeshes[i].fBoundsRadius))
+        {
+            iCulledCount++;
+            continue;
+        }
         vMeshes[i].draw(*shader);
+        iDrawnCount++;
     }
 
     mModel = mBaseModel;
@@ -58,6 +89,54 @@ void Model::draw()
     resetContainers();
 }
 
+bool Model::isSphereVisible(const Frustum& frustum, const glm::vec3& vCameraPosition, const glm::vec3& vCenter, float fRadius) const
+{
+    glm::vec3 vWorldCenter;
+    float fWorldRadius;
+    transformSphere(mModel, vCenter, fRadius, vWorldCenter, fWorldRadius);
+
+    if (fMaxDrawDistance > 0.0f && glm::distance(vCameraPosition, vWorldCenter) - fWorldRadius > fMaxDrawDistance)
+        return false;
+    return frustum.isSphereVisible(vWorldCenter, fWorldRadius);
+}
+
+void Model::calculateBounds()
+{
+    if (vMeshes.empty()) return;
+
+    // Spheres of meshes. A mesh which is rotated about a pivot stays in the sphere at 
+    // the pivot which reaches the farthest point of its own sphere.
+    std::vector<glm::vec4> vSpheres;
+    for (const Mesh& mesh : vMeshes)
+        vSpheres.push_back(glm::vec4(mesh.vBoundsCenter, mesh.fBoundsRadius));
+    for (const glm::vec3& vPivot : vRotationPivots)
+    {
+        float fRadius = 0.0f;
+        for (const Mesh& mesh : vMeshes)
+            fRadius = glm::max(fRadius, glm::distance(vPivot, mesh.vBoundsCenter) + mesh.fBoundsRadius);
+        vSpheres.push_back(glm::vec4(vPivot, fRadius));
+    }
+
+    // Sphere which encloses all spheres.
+    glm::vec3 vMin = glm::vec3(vSpheres[0]) - glm::vec3(vSpheres[0].w);
+    glm::vec3 vMax = glm::vec3(vSpheres[0]) + glm::vec3(vSpheres[0].w);
+    for (unsigned int i = 1; i < vSpheres.size(); i++)
+    {
+        vMin = glm::min(vMin, glm::vec3(vSpheres[i]) - glm::vec3(vSpheres[i].w));
+        vMax = glm::max(vMax, glm::vec3(vSpheres[i]) + glm::vec3(vSpheres[i].w));
+    }
+    vBoundsCenter = 0.5f * (vMin + vMax);
+    fBoundsRadius = 0.0f;
+    for (unsigned int i = 0; i < vSpheres.size(); i++)
+        fBoundsRadius = glm::max(fBoundsRadius, glm::distance(vBoundsCenter, glm::vec3(vSpheres[i])) + vSpheres[i].w);
+}
+
+void Model::addRotationPivot(glm::vec3 pivot)
+{
+    vRotationPivots.push_back(pivot);
+    calculateBounds();
+}
+
 void Model::translate(glm::vec3 translation)
 {
     mModel = glm::translate(mModel, translation);
@@ -76,9 +155,18 @@ void Model::scale(glm::vec3 scaling)
 
 void Model::loadModel(std::string const &path)
 {
+    // Retrieve the directory path of the filepath
+    sDirectory = path.substr(0, path.find_last_of('/'));
+
+    // Load model from its binary cache if it is valid.
+    uint64_t modelHash = 0;
+    bool useCache = isModelCacheEnabled() && hashModelFile(path, modelHash);
+    if (useCache && loadFromCache(path, modelHash))
+        return;
+
     // Read file via ASSIMP
     Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+    const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs);
     
     // Check for errors
     if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
@@ -87,11 +175,48 @@ void Model::loadModel(std::string const &path)
         return;
     }
 
-    // Retrieve the directory path of the filepath
-    sDirectory = path.substr(0, path.find_last_of('/'));
-
     // Process ASSIMP's root node recursively
     processNode(scene->mRootNode, scene);
+
+    // Create meshes from merged batches
+    processBatches(scene);
+
+    // Write binary cache for later loads.
+    if (useCache && bCacheable && !ModelCache::write(path, modelHash, vMeshes, vTexturesLoaded, vTextureImages))
+        std::cout << "WARNING::MODEL_CACHE:: Cache could not be written to " << ModelCache::cachePath(path) << std::endl;
+    vTextureImages.clear();
+}
+
+bool Model::loadFromCache(std::string const &path, uint64_t modelHash)
+{
+    ModelCache cache;
+    if (!cache.open(path, modelHash, sDirectory))
+        return false;
+
+    // Upload textures with their pre-decoded mip chains.
+    for (unsigned int i = 0; i < cache.vTextures.size(); i++)
+    {
+        Texture texture;
+        texture.iId = uploadTexture(cache.vTextures[i].image);
+        texture.sPath = cache.vTextures[i].sPath;
+        vTexturesLoaded.push_back(texture);
+    }
+
+    // Upload meshes directly from mapped cache.
+    for (unsigned int i = 0; i < cache.vMeshes.size(); i++)
+    {
+        const CachedMesh& cached = cache.vMeshes[i];
+        std::vector<Texture> textures;
+        for (unsigned int j = 0; j < cached.vTextures.size(); j++)
+        {
+            Texture texture = vTexturesLoaded[cached.vTextures[j].iTexture];
+            texture.sType = cached.vTextures[j].sType;
+            textures.push_back(texture);
+        }
+        vMeshes.push_back(Mesh(cached.pVertices, cached.iVertexCount, cached.pIndices, cached.iIndexCount, textures, cached.vOpacity));
+    }
+
+    return true;
 }
 
 void Model::processNode(aiNode *node, const aiScene *scene)
@@ -102,7 +227,7 @@ void Model::processNode(aiNode *node, const aiScene *scene)
         // The node object only contains indices to index the actual objects in the scene. 
         // the scene contains all the data, node is just to keep stuff organized (like relations between nodes).
         aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        vMeshes.push_back(processMesh(mesh, scene));
+        processMesh(mesh, scene);
     }
     
     // Process each of the children nodes.
@@ -113,79 +238,70 @@ void Model::processNode(aiNode *node, const aiScene *scene)
 
 }
 
-Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene)
+void Model::processMesh(aiMesh *mesh, const aiScene *scene)
+{
+    // Batch of the mesh's material. Indices of the mesh are shifted by the 
+    // number of vertices which are already in the batch.
+    MeshBatch& batch = mBatches[mesh->mMaterialIndex];
+    unsigned int iBaseVertex = (unsigned int)batch.vVertices.size();
+    batch.vVertices.reserve(batch.vVertices.size() + mesh->mNumVertices);
+    batch.vIndices.reserve(batch.vIndices.size() + 3 * mesh->mNumFaces);
+
+    // walk through each of the mesh's vertices
+    for(unsigned int i = 0; i < mesh->mNumVertices; i++)
     {
-        // Data to fill
-        std::vector<Vertex> vertices;
-        std::vector<unsigned int> indices;
-        std::vector<Texture> textures;
-        std::vector<float> opacity;
-
-        // walk through each of the mesh's vertices
-        for(unsigned int i = 0; i < mesh->mNumVertices; i++)
+        Vertex vertex;
+        
+        // Positions
+        vertex.vPosition = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+        
+        // Normals
+        glm::vec3 normal(0.0f, 0.0f, 0.0f);
+        if (mesh->HasNormals())
         {
-            Vertex vertex;
-            glm::vec3 vector; // Declaring a placeholder vector since assimp uses 
-            // its own vector class that doesn't directly convert to glm's vec3 
-            // class so we transfer the data to this placeholder glm::vec3 first.
-           
-            // Positions
-            vector.x = mesh->mVertices[i].x;
-            vector.y = mesh->mVertices[i].y;
-            vector.z = mesh->mVertices[i].z;
-            vertex.vPosition = vector;
-            
-            // Normals
-            if (mesh->HasNormals())
-            {
-                vector.x = mesh->mNormals[i].x;
-                vector.y = mesh->mNormals[i].y;
-                vector.z = mesh->mNormals[i].z;
-                vertex.vNormal = vector;
-            }
-            
-            // Texture coordinates
-            if(mesh->mTextureCoords[0])
-            {
-                glm::vec2 vec;
-                // A vertex can contain up to 8 different texture coordinates. 
-                // Thus make the assumption that it won't use models where a 
-                // vertex can have multiple texture coordinates, so always take 
-                // the first set (0).
-                vec.x = mesh->mTextureCoords[0][i].x; 
-                vec.y = mesh->mTextureCoords[0][i].y;
-                vertex.vTexCoords = vec;
-                
-                // Tangent
-                vector.x = mesh->mTangents[i].x;
-                vector.y = mesh->mTangents[i].y;
-                vector.z = mesh->mTangents[i].z;
-                vertex.vTangent = vector;
-                
-                // Bitangent
-                vector.x = mesh->mBitangents[i].x;
-                vector.y = mesh->mBitangents[i].y;
-                vector.z = mesh->mBitangents[i].z;
-                vertex.vBitangent = vector;
-            }
-            else
-                vertex.vTexCoords = glm::vec2(0.0f, 0.0f);
-
-            vertices.push_back(vertex);
+            normal.x = mesh->mNormals[i].x;
+            normal.y = mesh->mNormals[i].y;
+            normal.z = mesh->mNormals[i].z;
         }
-
-        // Retrieve each of the mesh's faces and the corresponding vertex indices.
-        for(unsigned int i = 0; i < mesh->mNumFaces; i++)
+        vertex.iNormal = glm::packSnorm3x10_1x2(glm::vec4(normal, 0.0f));
+        
+        // Texture coordinates
+        if(mesh->mTextureCoords[0])
         {
-            aiFace face = mesh->mFaces[i];
-            
-            // Retrieve all indices of the face and store them in the indices vector.
-            for(unsigned int j = 0; j < face.mNumIndices; j++)
-                indices.push_back(face.mIndices[j]);        
+            // A vertex can contain up to 8 different texture coordinates. 
+            // Thus make the assumption that it won't use models where a 
+            // vertex can have multiple texture coordinates, so always take 
+            // the first set (0).
+            vertex.vTexCoords = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
         }
+        else
+            vertex.vTexCoords = glm::vec2(0.0f, 0.0f);
+
+        batch.vVertices.push_back(vertex);
+    }
+
+    // Retrieve each of the mesh's faces and the corresponding vertex indices.
+    for(unsigned int i = 0; i < mesh->mNumFaces; i++)
+    {
+        aiFace face = mesh->mFaces[i];
+        
+        // Retrieve all indices of the face and store them in the indices vector.
+        for(unsigned int j = 0; j < face.mNumIndices; j++)
+            batch.vIndices.push_back(iBaseVertex + face.mIndices[j]);        
+    }
+}
+
+void Model::processBatches(const aiScene *scene)
+{
+    for (auto it = mBatches.begin(); it != mBatches.end(); ++it)
+    {
+        if (it->second.vIndices.empty()) continue;
+
+        std::vector<Texture> textures;
+        std::vector<float> opacity;
 
         // Process materials
-        aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];    
+        aiMaterial* material = scene->mMaterials[it->first];    
         
         // A convention for sampler names in the shaders. Each diffuse texture should be named
         // as 'texture_diffuseN' where N is a sequential number ranging from 1 to MAX_SAMPLER_NUMBER. 
@@ -211,14 +327,18 @@ Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene)
         textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
         
         // 5. Opacity
-        float opacity_val;
+        float opacity_val = 1.0f;
         material->Get(AI_MATKEY_OPACITY, opacity_val);
         opacity.push_back(opacity_val);
         
-        // Return a mesh object created from the extracted mesh data
-        return Mesh(vertices, indices, textures, opacity);
+        // Create a mesh object from the merged data of the material
+        vMeshes.push_back(Mesh(it->second.vVertices, it->second.vIndices, textures, opacity));
     }
 
+    // Batches are not needed anymore.
+    mBatches.clear();
+}
+
 
 std::vector<Texture> Model::loadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName)
 {
@@ -242,7 +362,22 @@ std::vector<Texture> Model::loadMaterialTextures(aiMaterial *mat, aiTextureType
         if(!skip)
         {   // If texture hasn't been loaded already, load it
             Texture texture;
-            texture.iId = TextureFromFile(str.C_Str(), sDirectory);
+            if (isModelCacheEnabled())
+            {
+                // Keep decoded image with its mip chain to write it into the model cache.
+                TextureImage image;
+                if (decodeTexture(sDirectory + '/' + std::string(str.C_Str()), isModelCacheCompression(), image))
+                    texture.iId = uploadTexture(image);
+                else
+                {
+                    std::cout << "Texture failed to load at path: " << str.C_Str() << std::endl;
+                    glGenTextures(1, &texture.iId);
+                    bCacheable = false;
+                }
+                vTextureImages.push_back(image);
+            }
+            else
+                texture.iId = TextureFromFile(str.C_Str(), sDirectory);
             texture.sType = typeName;
             texture.sPath = str.C_Str();
             textures.push_back(texture);
@@ -357,6 +492,19 @@ void Model::resetContainers()
     vMat4Container.clear();
 }
 
+void Model::clearContainers()
+{
+    vBooleanContainer.clear();
+    vIntegerContainer.clear();
+    vFloatContainer.clear();
+    vVec2Container.clear();
+    vVec3Container.clear();
+    vVec4Container.clear();
+    vMat2Container.clear();
+    vMat3Container.clear();
+    vMat4Container.clear();
+}
+
 unsigned int TextureFromFile(const char *path, const std::string &directory)
 {
     std::string filename = std::string(path);
@@ -7,6 +7,11 @@
 *
 * C.Date : 04/05/2021
 * Update : 04/05/2021 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Merging meshes which share the same material at load time. // @MGokcayK
+* Update : 19/10/2026 - Loading model from binary cache if it exists. // @MGokcayK
+* Update : 19/10/2026 - Virtual draw with camera frustum for derived drawables. // @MGokcayK
+* Update : 19/10/2026 - Frustum and distance culling of model and its meshes. // @MGokcayK
+* Update : 19/10/2026 - Bounds of parts rotated in vertex shader. // @MGokcayK
 */
 #ifndef MODEL_H
 #define MODEL_H
@@ -17,10 +22,20 @@
 #include <assimp/postprocess.h>
 
 #include "mesh.h"
+#include "model_cache.h"
+#include "frustum.h"
 #include <glm/gtx/string_cast.hpp> // for string handling of glm.
 
 unsigned int TextureFromFile(const char *path, const std::string &directory);
 
+// Vertices and indices of all meshes which share the same material. They are 
+// merged at load time so that each material is drawn with only one draw call.
+struct MeshBatch
+{
+    std::vector<Vertex> vVertices;
+    std::vector<unsigned int> vIndices;
+};
+
 template <typename T>
 struct container
 {
@@ -49,6 +64,17 @@ public:
     std::vector<container<glm::mat4>*> vMat4Container;
     Shader* shader;
 
+    // Bounding sphere of all meshes in model space.
+    glm::vec3 vBoundsCenter = glm::vec3(0.0f);
+    float fBoundsRadius = 0.0f;
+
+    // Maximum distance from camera to draw the model. Zero means no limit.
+    float fMaxDrawDistance = 0.0f;
+
+    // Number of drawn and culled parts (meshes or chunks) at the last draw.
+    int iDrawnCount = 0;
+    int iCulledCount = 0;
+
     // To have different shader for different objecs, shader should be created 
     // for each model. To handle it, shader should be created.
     void create_shader(std::string vertex_shader_file_path, std::string fragment_shader_file_path);
@@ -59,8 +85,11 @@ public:
           std::string fragment_shader_file_path
           );
 
-    // Draws the model, and thus all its meshes
-    void draw();
+    virtual ~Model() {}
+
+    // Draws the model, and thus all its meshes which are in the camera frustum 
+    // and the draw distance. Camera frustum and position are provided by the window.
+    virtual void draw(const Frustum& frustum, const glm::vec3& vCameraPosition);
     
     // Translate the model to `translation` points.
     void translate(glm::vec3 translation);
@@ -70,26 +99,66 @@ public:
 
     // Scale the model
     void scale(glm::vec3 scaling);
+
+    // Add model space pivot which vertex shader rotates parts of the model about (e.g. 
+    // rotor hubs). Bounds of the model enclose every rotation about its pivots. Meshes of 
+    // such model are not culled one by one, since shader selects rotated vertices by 
+    // position instead of mesh.
+    void addRotationPivot(glm::vec3 pivot);
     
+protected:
+    // Constructor for derived drawables which create their own geometry instead of loading a model file.
+    Model(std::string vertex_shader_file_path, std::string fragment_shader_file_path);
+
+    // Link uniform blocks of the shader to binding points of the window.
+    void bindUniformBlocks();
+
+    // Appling uniform containers which filled from Python side.
+    void applyContainers();
+
+    // Reset uniform containers which filled from Python side.
+    void resetContainers();
+
+    // Clear uniform containers without applying them when the model is culled.
+    void clearContainers();
+
+    // Check whether the model space sphere is in the frustum and the draw distance.
+    bool isSphereVisible(const Frustum& frustum, const glm::vec3& vCameraPosition, const glm::vec3& vCenter, float fRadius) const;
+
 private:
+    // Pivots of parts which are rotated in vertex shader.
+    std::vector<glm::vec3> vRotationPivots;
+
+    // Calculate bounding sphere of the model from its meshes and rotation pivots.
+    void calculateBounds();
+
     // Loads a model with supported ASSIMP extensions from file and stores the resulting meshes in the meshes vector.
     void loadModel(std::string const &path);
 
+    // Mesh batches w.r.t material index of meshes. It is only used during loading.
+    std::map<unsigned int, MeshBatch> mBatches;
+
+    // Decoded images of `vTexturesLoaded` to write them into the model cache. It is only used during loading.
+    std::vector<TextureImage> vTextureImages;
+
+    // Whether the model cache can be written after loading. It is false if any texture fails to load.
+    bool bCacheable = true;
+
+    // Load meshes and textures from the binary cache of the model. Returns false if the cache is not valid.
+    bool loadFromCache(std::string const &path, uint64_t modelHash);
+
     // Processes a node in a recursive fashion. Processes each individual mesh located at the node and repeats this process on its children nodes (if any).
     void processNode(aiNode *node, const aiScene *scene);
 
-    // Create mesh for the model.
-    Mesh processMesh(aiMesh *mesh, const aiScene *scene);
+    // Append vertices and indices of the mesh into the batch of its material.
+    void processMesh(aiMesh *mesh, const aiScene *scene);
+
+    // Create one mesh for each material batch of the model.
+    void processBatches(const aiScene *scene);
 
     // Checks all material textures of a given type and loads the textures if they're not loaded yet.
     // the required info is returned as a Texture struct.
     std::vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName);
-
-    // Appling uniform containers which filled from Python side.
-    void applyContainers();
-
-    // Reset uniform containers which filled from Python side.
-    void resetContainers();
 };
 
 #endif
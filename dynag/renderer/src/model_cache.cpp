@@ -0,0 +1,551 @@
+#define STB_DXT_IMPLEMENTATION
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "model_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include <GLFW/glfw3.h>
+#include <stb/stb_image.h>
+#include <stb/stb_image_resize.h>
+#include <stb/stb_dxt.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    // Cache file identity. Version should be increased if the layout or `Vertex` changes.
+    const char CACHE_MAGIC[4] = {'D', 'G', 'M', 'C'};
+    const uint32_t CACHE_VERSION = 1;
+
+    bool bCacheEnabled = true;
+    bool bCacheCompression = false;
+
+    // Cache blocks are aligned to 8 bytes to read vertices/indices in place.
+    uint64_t align8(uint64_t size) { return (size + 7) & ~uint64_t(7); }
+
+    // Sequential reader over the mapped cache with bounds checking.
+    struct CacheReader
+    {
+        const unsigned char* pData;
+        size_t iSize;
+        size_t iPos = 0;
+        bool bOk = true;
+
+        CacheReader(const unsigned char* data, size_t size) : pData(data), iSize(size) {}
+
+        const unsigned char* take(uint64_t size)
+        {
+            if (!bOk || size > iSize - iPos) { bOk = false; return nullptr; }
+            const unsigned char* p = pData + iPos;
+            iPos += (size_t)size;
+            return p;
+        }
+
+        template <typename T>
+        T read()
+        {
+            T value{};
+            const unsigned char* p = take(sizeof(T));
+            if (p) std::memcpy(&value, p, sizeof(T));
+            return value;
+        }
+
+        std::string readString()
+        {
+            uint32_t len = read<uint32_t>();
+            const unsigned char* p = take(len);
+            if (!p) return std::string();
+            std::string str((const char*)p, len);
+            align();
+            return str;
+        }
+
+        void align() { take(align8(iPos) - iPos); }
+    };
+
+    // Sequential writer of the cache.
+    struct CacheWriter
+    {
+        std::ofstream& out;
+        uint64_t iPos = 0;
+
+        explicit CacheWriter(std::ofstream& stream) : out(stream) {}
+
+        void bytes(const void* data, uint64_t size)
+        {
+            out.write((const char*)data, (std::streamsize)size);
+            iPos += size;
+        }
+
+        template <typename T>
+        void write(const T& value) { bytes(&value, sizeof(T)); }
+
+        void writeString(const std::string& str)
+        {
+            write<uint32_t>((uint32_t)str.size());
+            bytes(str.data(), str.size());
+            align();
+        }
+
+        void align()
+        {
+            static const char zeros[8] = {0};
+            bytes(zeros, align8(iPos) - iPos);
+        }
+    };
+
+    // Compress RGBA8 level into BC1/BC3 blocks. Edges are clamped for partial blocks.
+    void compressLevel(const unsigned char* rgba, int w, int h, bool alpha, std::vector<unsigned char>& out)
+    {
+        int bw = (w + 3) / 4;
+        int bh = (h + 3) / 4;
+        int blockSize = alpha ? 16 : 8;
+        out.resize((size_t)bw * bh * blockSize);
+
+        unsigned char block[64];
+        for (int by = 0; by < bh; by++)
+        {
+            for (int bx = 0; bx < bw; bx++)
+            {
+                for (int y = 0; y < 4; y++)
+                {
+                    int sy = std::min(by * 4 + y, h - 1);
+                    for (int x = 0; x < 4; x++)
+                    {
+                        int sx = std::min(bx * 4 + x, w - 1);
+                        std::memcpy(&block[(y * 4 + x) * 4], &rgba[((size_t)sy * w + sx) * 4], 4);
+                    }
+                }
+                stb_compress_dxt_block(&out[((size_t)by * bw + bx) * blockSize], block, alpha ? 1 : 0, STB_DXT_HIGHQUAL);
+            }
+        }
+    }
+}
+
+void setModelCacheEnabled(bool enabled) { bCacheEnabled = enabled; }
+bool isModelCacheEnabled() { return bCacheEnabled; }
+void setModelCacheCompression(bool compress) { bCacheCompression = compress; }
+bool isModelCacheCompression() { return bCacheCompression; }
+
+
+static void hashBytes(const char* data, size_t size, uint64_t& hash)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+static void hashStream(std::istream& in, uint64_t& hash)
+{
+    std::vector<char> buffer(1 << 16);
+    while (in)
+    {
+        in.read(buffer.data(), (std::streamsize)buffer.size());
+        hashBytes(buffer.data(), (size_t)in.gcount(), hash);
+    }
+}
+
+bool hashFile(const std::string& path, uint64_t& hash)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    hash = 14695981039346656037ULL;
+    hashStream(in, hash);
+    return true;
+}
+
+bool hashModelFile(const std::string& path, uint64_t& hash)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    // Model is hashed line by line to find its material libraries in the same pass.
+    hash = 14695981039346656037ULL;
+    std::vector<std::string> libraries;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        hashBytes(line.data(), line.size(), hash);
+        hashBytes("\n", 1, hash);
+        if (line.compare(0, 7, "mtllib ") != 0) continue;
+        std::istringstream names(line.substr(7));
+        std::string name;
+        while (names >> name) libraries.push_back(name);
+    }
+
+    // Missing library is hashed by its name only, so adding it later invalidates the cache.
+    std::string directory = path.substr(0, path.find_last_of('/'));
+    for (const std::string& name : libraries)
+    {
+        hashBytes(name.data(), name.size(), hash);
+        std::ifstream library(directory + '/' + name, std::ios::binary);
+        if (library) hashStream(library, hash);
+    }
+    return true;
+}
+
+
+bool decodeTexture(const std::string& filename, bool compress, TextureImage& image)
+{
+    int width, height, nrComponents;
+    unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
+    if (!data) return false;
+
+    hashFile(filename, image.iSourceHash);
+    image.iComponents = nrComponents;
+    image.vLevels.clear();
+    image.vStorage.clear();
+    image.pMapped = nullptr;
+
+    compress = compress && glfwExtensionSupported("GL_EXT_texture_compression_s3tc");
+    bool alpha = nrComponents == 4;
+    image.bCompressed = compress;
+    if (compress)
+        image.iFormat = alpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    else if (nrComponents == 1)
+        image.iFormat = GL_RED;
+    else if (nrComponents == 3)
+        image.iFormat = GL_RGB;
+    else
+        image.iFormat = GL_RGBA;
+
+    // Compression works on RGBA, so expand the source if needed.
+    int channels = nrComponents;
+    std::vector<unsigned char> level;
+    if (compress && nrComponents != 4)
+    {
+        level.resize((size_t)width * height * 4);
+        for (size_t p = 0; p < (size_t)width * height; p++)
+        {
+            for (int c = 0; c < 3; c++)
+                level[p * 4 + c] = data[p * nrComponents + (nrComponents == 1 ? 0 : c)];
+            level[p * 4 + 3] = 255;
+        }
+        channels = 4;
+    }
+    else
+        level.assign(data, data + (size_t)width * height * nrComponents);
+    stbi_image_free(data);
+
+    // Create mip chain down to 1x1.
+    int w = width, h = height;
+    std::vector<unsigned char> next, compressed;
+    while (true)
+    {
+        const std::vector<unsigned char>* levelData = &level;
+        if (compress)
+        {
+            compressLevel(level.data(), w, h, alpha, compressed);
+            levelData = &compressed;
+        }
+
+        TextureLevel info;
+        info.iWidth = w;
+        info.iHeight = h;
+        info.iSize = (uint32_t)levelData->size();
+        info.iOffset = image.vStorage.size();
+        image.vLevels.push_back(info);
+        image.vStorage.insert(image.vStorage.end(), levelData->begin(), levelData->end());
+
+        if (w == 1 && h == 1) break;
+
+        int nw = std::max(1, w / 2);
+        int nh = std::max(1, h / 2);
+        next.resize((size_t)nw * nh * channels);
+        stbir_resize_uint8(level.data(), w, h, 0, next.data(), nw, nh, 0, channels);
+        level.swap(next);
+        w = nw;
+        h = nh;
+    }
+    image.iDataSize = image.vStorage.size();
+
+    return true;
+}
+
+
+unsigned int uploadTexture(const TextureImage& image)
+{
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    // Rows of levels are tightly packed.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    const unsigned char* data = image.data();
+    for (size_t l = 0; l < image.vLevels.size(); l++)
+    {
+        const TextureLevel& level = image.vLevels[l];
+        if (image.bCompressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, (int)l, image.iFormat, level.iWidth, level.iHeight, 0, level.iSize, data + level.iOffset);
+        else
+            glTexImage2D(GL_TEXTURE_2D, (int)l, image.iFormat, level.iWidth, level.iHeight, 0, image.iFormat, GL_UNSIGNED_BYTE, data + level.iOffset);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (int)image.vLevels.size() - 1);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    return textureID;
+}
+
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) { CloseHandle(file); return false; }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) { CloseHandle(file); return false; }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+    hFile = file;
+    hMapping = mapping;
+    pData = (const unsigned char*)view;
+    iSize = (size_t)size.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    pData = (const unsigned char*)view;
+    iSize = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (!pData) return;
+#ifdef _WIN32
+    UnmapViewOfFile(pData);
+    CloseHandle(hMapping);
+    CloseHandle(hFile);
+    hMapping = nullptr;
+    hFile = nullptr;
+#else
+    munmap((void*)pData, iSize);
+#endif
+    pData = nullptr;
+    iSize = 0;
+}
+
+
+std::string ModelCache::cachePath(const std::string& modelPath)
+{
+    return modelPath + ".dgcache";
+}
+
+bool ModelCache::open(const std::string& modelPath, uint64_t modelHash, const std::string& directory)
+{
+    close();
+    if (!file.open(cachePath(modelPath))) return false;
+
+    CacheReader reader(file.data(), file.size());
+
+    // Header
+    const unsigned char* magic = reader.take(sizeof(CACHE_MAGIC));
+    if (!magic || std::memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        reader.read<uint32_t>() != CACHE_VERSION ||
+        reader.read<uint32_t>() != sizeof(Vertex) ||
+        reader.read<uint64_t>() != modelHash)
+    {
+        close();
+        return false;
+    }
+    uint32_t textureCount = reader.read<uint32_t>();
+    uint32_t meshCount = reader.read<uint32_t>();
+    reader.align();
+
+    bool s3tc = glfwExtensionSupported("GL_EXT_texture_compression_s3tc");
+
+    // Textures
+    vTextures.resize(textureCount);
+    for (uint32_t t = 0; t < textureCount && reader.bOk; t++)
+    {
+        CachedTexture& texture = vTextures[t];
+        TextureImage& image = texture.image;
+        image.iSourceHash = reader.read<uint64_t>();
+        texture.sPath = reader.readString();
+        image.iComponents = reader.read<int32_t>();
+        image.iFormat = reader.read<uint32_t>();
+        image.bCompressed = reader.read<uint32_t>() != 0;
+        uint32_t levelCount = reader.read<uint32_t>();
+        if (!reader.bOk || levelCount > 32) { reader.bOk = false; break; }
+        image.vLevels.resize(levelCount);
+        for (uint32_t l = 0; l < levelCount; l++)
+        {
+            image.vLevels[l].iWidth = reader.read<int32_t>();
+            image.vLevels[l].iHeight = reader.read<int32_t>();
+            image.vLevels[l].iSize = reader.read<uint32_t>();
+            reader.read<uint32_t>();
+            image.vLevels[l].iOffset = reader.read<uint64_t>();
+        }
+        image.iDataSize = reader.read<uint64_t>();
+        image.pMapped = reader.take(image.iDataSize);
+        reader.align();
+        for (size_t l = 0; l < image.vLevels.size() && reader.bOk; l++)
+            if (image.vLevels[l].iOffset + image.vLevels[l].iSize > image.iDataSize) reader.bOk = false;
+
+        // Compressed cache cannot be used without S3TC support.
+        if (image.bCompressed && !s3tc) reader.bOk = false;
+
+        // Texture source should be the same as the cached one.
+        uint64_t sourceHash;
+        if (reader.bOk && (!hashFile(directory + '/' + texture.sPath, sourceHash) || sourceHash != image.iSourceHash))
+            reader.bOk = false;
+    }
+
+    // Meshes
+    if (reader.bOk) vMeshes.resize(meshCount);
+    for (uint32_t m = 0; m < meshCount && reader.bOk; m++)
+    {
+        CachedMesh& mesh = vMeshes[m];
+        uint32_t refCount = reader.read<uint32_t>();
+        if (!reader.bOk || refCount > textureCount) { reader.bOk = false; break; }
+        mesh.vTextures.resize(refCount);
+        for (uint32_t r = 0; r < refCount; r++)
+        {
+            mesh.vTextures[r].iTexture = reader.read<uint32_t>();
+            mesh.vTextures[r].sType = reader.readString();
+            if (mesh.vTextures[r].iTexture >= textureCount) reader.bOk = false;
+        }
+        uint32_t opacityCount = reader.read<uint32_t>();
+        const unsigned char* opacity = reader.take((uint64_t)opacityCount * sizeof(float));
+        if (opacity)
+        {
+            mesh.vOpacity.resize(opacityCount);
+            std::memcpy(mesh.vOpacity.data(), opacity, (size_t)opacityCount * sizeof(float));
+        }
+        reader.align();
+        mesh.iVertexCount = reader.read<uint32_t>();
+        mesh.iIndexCount = reader.read<uint32_t>();
+        mesh.pVertices = (const Vertex*)reader.take((uint64_t)mesh.iVertexCount * sizeof(Vertex));
+        reader.align();
+        mesh.pIndices = (const unsigned int*)reader.take((uint64_t)mesh.iIndexCount * sizeof(unsigned int));
+        reader.align();
+    }
+
+    if (!reader.bOk)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool ModelCache::write(const std::string& modelPath, uint64_t modelHash,
+                       const std::vector<Mesh>& meshes,
+                       const std::vector<Texture>& textures,
+                       const std::vector<TextureImage>& images)
+{
+    // Write to a unique temporary file and rename it, so that other processes
+    // never map a partially written cache.
+    std::string path = cachePath(modelPath);
+    std::random_device rd;
+    std::string tmpPath = path + ".tmp" + std::to_string(rd());
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    CacheWriter writer(out);
+
+    // Header
+    writer.bytes(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writer.write<uint32_t>(CACHE_VERSION);
+    writer.write<uint32_t>((uint32_t)sizeof(Vertex));
+    writer.write<uint64_t>(modelHash);
+    writer.write<uint32_t>((uint32_t)textures.size());
+    writer.write<uint32_t>((uint32_t)meshes.size());
+    writer.align();
+
+    // Textures
+    for (size_t t = 0; t < textures.size(); t++)
+    {
+        const TextureImage& image = images[t];
+        writer.write<uint64_t>(image.iSourceHash);
+        writer.writeString(textures[t].sPath);
+        writer.write<int32_t>(image.iComponents);
+        writer.write<uint32_t>(image.iFormat);
+        writer.write<uint32_t>(image.bCompressed ? 1 : 0);
+        writer.write<uint32_t>((uint32_t)image.vLevels.size());
+        for (size_t l = 0; l < image.vLevels.size(); l++)
+        {
+            writer.write<int32_t>(image.vLevels[l].iWidth);
+            writer.write<int32_t>(image.vLevels[l].iHeight);
+            writer.write<uint32_t>(image.vLevels[l].iSize);
+            writer.write<uint32_t>(0);
+            writer.write<uint64_t>(image.vLevels[l].iOffset);
+        }
+        writer.write<uint64_t>(image.iDataSize);
+        writer.bytes(image.data(), image.iDataSize);
+        writer.align();
+    }
+
+    // Meshes
+    for (size_t m = 0; m < meshes.size(); m++)
+    {
+        const Mesh& mesh = meshes[m];
+        writer.write<uint32_t>((uint32_t)mesh.vTextures.size());
+        for (size_t r = 0; r < mesh.vTextures.size(); r++)
+        {
+            uint32_t index = 0;
+            for (size_t t = 0; t < textures.size(); t++)
+                if (textures[t].iId == mesh.vTextures[r].iId) { index = (uint32_t)t; break; }
+            writer.write<uint32_t>(index);
+            writer.writeString(mesh.vTextures[r].sType);
+        }
+        writer.write<uint32_t>((uint32_t)mesh.vOpacity.size());
+        writer.bytes(mesh.vOpacity.data(), mesh.vOpacity.size() * sizeof(float));
+        writer.align();
+        writer.write<uint32_t>((uint32_t)mesh.vVertices.size());
+        writer.write<uint32_t>((uint32_t)mesh.vIndices.size());
+        writer.bytes(mesh.vVertices.data(), mesh.vVertices.size() * sizeof(Vertex));
+        writer.align();
+        writer.bytes(mesh.vIndices.data(), mesh.vIndices.size() * sizeof(unsigned int));
+        writer.align();
+    }
+
+    out.close();
+    if (!out || std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ModelCache::close()
+{
+    vTextures.clear();
+    vMeshes.clear();
+    file.close();
+}
@@ -0,0 +1,160 @@
+/*
+* DynaG Renderer C++ / Model Cache
+*
+* Binary cache of processed models. Merged vertex/index blobs and decoded
+* texture mip chains are written on the first load of a model and memory
+* mapped on later loads to skip assimp parsing and image decoding.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Hashing material libraries into model hash. // @MGokcayK
+*/
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "mesh.h"
+
+// S3TC formats are not part of the core profile, so glad does not define them.
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+// Enable/disable the model cache. It is enabled by default.
+void setModelCacheEnabled(bool enabled);
+bool isModelCacheEnabled();
+
+// Enable/disable BCn (S3TC) compression of textures which are written to the cache.
+// It is disabled by default and only applied if the driver supports S3TC.
+void setModelCacheCompression(bool compress);
+bool isModelCacheCompression();
+
+// 64-bit FNV-1a hash of the file content. Returns false if the file cannot be read.
+bool hashFile(const std::string& path, uint64_t& hash);
+
+// Hash of the model file and material libraries (`mtllib`) which it references, so editing
+// materials invalidates the cache too. Returns false if the model file cannot be read.
+bool hashModelFile(const std::string& path, uint64_t& hash);
+
+// One level of the mip chain. `iOffset` is relative to the data of the texture image.
+struct TextureLevel
+{
+    int iWidth;
+    int iHeight;
+    uint32_t iSize;
+    uint64_t iOffset;
+};
+
+// Decoded texture with its whole mip chain. Data is owned by `vStorage` if the
+// image is decoded from its source, otherwise it points into the mapped cache.
+struct TextureImage
+{
+    uint64_t iSourceHash = 0;
+    int iComponents = 0;
+    unsigned int iFormat = 0;
+    bool bCompressed = false;
+    std::vector<TextureLevel> vLevels;
+    std::vector<unsigned char> vStorage;
+    const unsigned char* pMapped = nullptr;
+    uint64_t iDataSize = 0;
+
+    // Pointer to the first byte of level data.
+    const unsigned char* data() const { return pMapped ? pMapped : vStorage.data(); }
+};
+
+// Decode image from file and create its mip chain. If `compress` is true and S3TC
+// is supported, levels are compressed to BC1 (no alpha) or BC3 (alpha).
+bool decodeTexture(const std::string& filename, bool compress, TextureImage& image);
+
+// Create OpenGL texture from the image with its all levels and return its id.
+unsigned int uploadTexture(const TextureImage& image);
+
+// Read-only memory mapped file.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map the whole file. Returns false if it fails.
+    bool open(const std::string& path);
+
+    // Unmap the file.
+    void close();
+
+    const unsigned char* data() const { return pData; }
+    size_t size() const { return iSize; }
+
+private:
+    const unsigned char* pData = nullptr;
+    size_t iSize = 0;
+#ifdef _WIN32
+    void* hFile = nullptr;
+    void* hMapping = nullptr;
+#endif
+};
+
+// Texture reference of a cached mesh.
+struct CachedTextureRef
+{
+    uint32_t iTexture;
+    std::string sType;
+};
+
+// Mesh of a cached model. Vertex and index pointers point into the mapped cache.
+struct CachedMesh
+{
+    std::vector<CachedTextureRef> vTextures;
+    std::vector<float> vOpacity;
+    const Vertex* pVertices = nullptr;
+    uint32_t iVertexCount = 0;
+    const unsigned int* pIndices = nullptr;
+    uint32_t iIndexCount = 0;
+};
+
+// Texture of a cached model.
+struct CachedTexture
+{
+    std::string sPath;
+    TextureImage image;
+};
+
+// Cache file of a model which is stored next to the model as `<model path>.dgcache`.
+class ModelCache
+{
+public:
+    std::vector<CachedTexture> vTextures;
+    std::vector<CachedMesh> vMeshes;
+
+    // Path of the cache file of the model.
+    static std::string cachePath(const std::string& modelPath);
+
+    // Map cache of the model and parse it. Returns false if there is no cache,
+    // it is corrupted or the model/textures are changed after it is written.
+    bool open(const std::string& modelPath, uint64_t modelHash, const std::string& directory);
+
+    // Write cache of the model. Returns false if it cannot be written.
+    static bool write(const std::string& modelPath, uint64_t modelHash,
+                      const std::vector<Mesh>& meshes,
+                      const std::vector<Texture>& textures,
+                      const std::vector<TextureImage>& images);
+
+    // Release mapped cache.
+    void close();
+
+private:
+    MappedFile file;
+};
+
+#endif
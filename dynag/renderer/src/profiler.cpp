@@ -0,0 +1,64 @@
+#include "profiler.h"
+
+void RenderProfiler::init()
+{
+    glGenQueries(QUERY_LATENCY * GPU_PHASE_COUNT, &iQueries[0][0]);
+    bInitialized = true;
+}
+
+void RenderProfiler::beginPhase(RenderPhase phase)
+{
+    tpPhaseStart[phase] = std::chrono::steady_clock::now();
+
+    if (!bInitialized || phase >= GPU_PHASE_COUNT) return;
+    int iSlot = iFrame % QUERY_LATENCY;
+    glBeginQuery(GL_TIME_ELAPSED, iQueries[iSlot][phase]);
+}
+
+void RenderProfiler::endPhase(RenderPhase phase)
+{
+    if (bInitialized && phase < GPU_PHASE_COUNT)
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        bIssued[iFrame % QUERY_LATENCY][phase] = true;
+    }
+
+    std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - tpPhaseStart[phase];
+    accumulate(STAT_CPU_DRAW + phase, duration.count());
+}
+
+void RenderProfiler::endFrame()
+{
+    iFrame++;
+    if (!bInitialized) return;
+
+    // Slot of the next frame is the oldest one. Read its results if they are
+    // ready, otherwise drop them instead of waiting for the GPU.
+    int iSlot = iFrame % QUERY_LATENCY;
+    for (int p = 0; p < GPU_PHASE_COUNT; p++)
+    {
+        if (!bIssued[iSlot][p]) continue;
+        bIssued[iSlot][p] = false;
+
+        GLint iAvailable = 0;
+        glGetQueryObjectiv(iQueries[iSlot][p], GL_QUERY_RESULT_AVAILABLE, &iAvailable);
+        if (!iAvailable) continue;
+
+        GLuint64 iElapsed = 0;
+        glGetQueryObjectui64v(iQueries[iSlot][p], GL_QUERY_RESULT, &iElapsed);
+        accumulate(STAT_GPU_DRAW + p, iElapsed / 1e6f);
+    }
+}
+
+void RenderProfiler::setStat(RenderStat stat, float fValue)
+{
+    if (stat == STAT_DRAWN || stat == STAT_CULLED)
+        fStats[stat] = fValue;
+    else
+        accumulate(stat, fValue);
+}
+
+void RenderProfiler::accumulate(int iStat, float fValue)
+{
+    fStats[iStat] += fSmoothing * (fValue - fStats[iStat]);
+}
@@ -0,0 +1,85 @@
+/*
+* DynaG Renderer C++ / Profiler
+*
+* Per-frame render profiler which measures render phases with CPU timers and
+* GL_TIME_ELAPSED queries. Queries are ring-buffered over several frames and
+* their results are only read when they are available, so the profiler never
+* stalls the pipeline. Swap is only measured with CPU timer, since a query only
+* measures GPU work which is submitted in it and swap does not submit any.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Measuring swap only with CPU timer. // @MGokcayK
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <glad/glad.h>
+
+#include <chrono>
+
+// Measured phases of a frame. Phases before `GPU_PHASE_COUNT` are measured on GPU too.
+enum RenderPhase
+{
+    PHASE_DRAW = 0,
+    PHASE_GUI,
+    PHASE_SWAP,
+    PHASE_COUNT,
+    GPU_PHASE_COUNT = PHASE_SWAP
+};
+
+// Layout of render stats array which is exported to the API.
+enum RenderStat
+{
+    STAT_CPU_DRAW = 0,  // [ms] CPU time of draw submission
+    STAT_CPU_GUI,       // [ms] CPU time of ImGui frame and its draw data
+    STAT_CPU_SWAP,      // [ms] CPU time of buffer swap and event polling
+    STAT_GPU_DRAW,      // [ms] GPU time of draw
+    STAT_GPU_GUI,       // [ms] GPU time of ImGui
+    STAT_SLEEP,         // [ms] Sleep time for FPS limit
+    STAT_FRAME,         // [ms] Total frame time
+    STAT_DRAWN,         // Number of drawn meshes/chunks
+    STAT_CULLED,        // Number of culled meshes/chunks
+    STAT_COUNT
+};
+
+class RenderProfiler
+{
+public:
+    // Number of frames which queries are kept in flight before reading them.
+    static const int QUERY_LATENCY = 4;
+
+    // Smoothed (exponential moving average) stats. Layout is `RenderStat`.
+    float fStats[STAT_COUNT] = {0.0f};
+
+    // Smoothing factor of the moving average. One means no smoothing.
+    float fSmoothing = 0.1f;
+
+    // Create queries. It should be called after OpenGL context is created.
+    void init();
+
+    // Start/stop measuring the phase.
+    void beginPhase(RenderPhase phase);
+    void endPhase(RenderPhase phase);
+
+    // Finish the frame and collect available GPU results of previous frames.
+    void endFrame();
+
+    // Set a stat which is measured outside of the profiler.
+    void setStat(RenderStat stat, float fValue);
+
+private:
+    unsigned int iQueries[QUERY_LATENCY][GPU_PHASE_COUNT] = {{0}};
+    bool bIssued[QUERY_LATENCY][GPU_PHASE_COUNT] = {{false}};
+    bool bInitialized = false;
+    int iFrame = 0;
+    std::chrono::steady_clock::time_point tpPhaseStart[PHASE_COUNT];
+
+    // Update smoothed value of the stat.
+    void accumulate(int iStat, float fValue);
+};
+
+#endif
@@ -32,12 +32,28 @@ void terminateWindow()
 	glfwTerminate();
 }
 
+void setModelCache(bool enable, bool compress_textures)
+{
+	setModelCacheEnabled(enable);
+	setModelCacheCompression(compress_textures);
+}
+
 Model* createModel(char* model_path, char* vertex_shader_file_path, char* fragment_shader_file_path)
 {
 	return new Model(model_path, vertex_shader_file_path, fragment_shader_file_path);
 }
 
 
+Model* createTerrain(char* height_map_path, char* normal_map_path, char* texture_path,
+					 float north_span, float east_span, float max_height,
+					 char* vertex_shader_file_path, char* fragment_shader_file_path)
+{
+	return new Terrain(height_map_path, normal_map_path, texture_path, 
+					   north_span, east_span, max_height, 
+					   vertex_shader_file_path, fragment_shader_file_path);
+}
+
+
 void addPermanent2Window(Window* window, Model* model)
 {
 	window->addPermanentDrawables(model);
@@ -68,6 +84,38 @@ void scaleModel(Model* model, float x, float y, float z)
 }
 
 
+void setModelDrawDistance(Model* model, float distance)
+{
+	model->fMaxDrawDistance = distance;
+}
+
+
+void addModelRotationPivot(Model* model, float x, float y, float z)
+{
+	model->addRotationPivot(glm::vec3(x, y, z));
+}
+
+
+void getDrawCounts(Window* window, int* counts)
+{
+	counts[0] = window->iDrawnCount;
+	counts[1] = window->iCulledCount;
+}
+
+
+void getRenderStats(Window* window, float* out)
+{
+	for (int i = 0; i < STAT_COUNT; i++)
+		out[i] = window->rpProfiler.fStats[i];
+}
+
+
+void showRenderStats(Window* window, bool show)
+{
+	window->bShowRenderStats = show;
+}
+
+
 float getFps(Window* window)
 {
 	return window->fFPS;
@@ -9,6 +9,11 @@
 * C.Date : 04/05/2021
 * Update : 04/05/2021 - Initialization & Implementation // @MGokcayK
 * Update : 05/01/2022 - Adding new guiText methods // @MGokcayK
+* Update : 19/10/2026 - Adding model cache options // @MGokcayK
+* Update : 19/10/2026 - Adding chunked LOD terrain // @MGokcayK
+* Update : 19/10/2026 - Adding culling methods // @MGokcayK
+* Update : 19/10/2026 - Adding render stats methods // @MGokcayK
+* Update : 19/10/2026 - Adding addModelRotationPivot method // @MGokcayK
 */
 
 #ifdef _WIN32
@@ -23,6 +28,7 @@
 #endif
 
 #include "gWindow.h"
+#include "terrain.h"
 
 // RENDERER API for creating shared libraries to call methods from Python.
 
@@ -43,9 +49,18 @@ extern "C" RENDERER_API void render(Window* window);
 // Terminate the OpenGL.
 extern "C" RENDERER_API void terminateWindow();
 
+// Set model cache options. Cache is enabled and compression is disabled by default.
+extern "C" RENDERER_API void setModelCache(bool enable, bool compress_textures);
+
 // Create model with its shaders.
 extern "C" RENDERER_API Model* createModel(char* model_path, char* vertex_shader_file_path, char* fragment_shader_file_path);
 
+// Create chunked LOD terrain from height map, normal map and texture with its shaders.
+// Spans and max height should be in renderer units. It can be used as a model.
+extern "C" RENDERER_API Model* createTerrain(char* height_map_path, char* normal_map_path, char* texture_path,
+											 float north_span, float east_span, float max_height,
+											 char* vertex_shader_file_path, char* fragment_shader_file_path);
+
 // Add model as permanent drawables object to window.
 extern "C" RENDERER_API void addPermanent2Window(Window* window, Model* model);
 
@@ -61,6 +76,24 @@ extern "C" RENDERER_API void rotateModel(Model* model, float angle, float x, flo
 // Scale model to the ratios for each axis.
 extern "C" RENDERER_API void scaleModel(Model* model, float x, float y, float z);
 
+// Set maximum draw distance of the model. Zero means no limit.
+extern "C" RENDERER_API void setModelDrawDistance(Model* model, float distance);
+
+// Add model space pivot which vertex shader of the model rotates parts about. Model bounds 
+// enclose every rotation about it and meshes of the model are not culled one by one.
+extern "C" RENDERER_API void addModelRotationPivot(Model* model, float x, float y, float z);
+
+// Get number of drawn and culled parts (meshes or terrain chunks) at the last render as [drawn, culled].
+extern "C" RENDERER_API void getDrawCounts(Window* window, int* counts);
+
+// Get smoothed render stats of the window. `out` should have `STAT_COUNT` floats which are
+// CPU draw, gui and swap times, GPU draw and gui times, sleep time, frame time [ms],
+// and drawn and culled counts respectively.
+extern "C" RENDERER_API void getRenderStats(Window* window, float* out);
+
+// Show/hide render stats panel of the window.
+extern "C" RENDERER_API void showRenderStats(Window* window, bool show);
+
 // Get FPS from the window.
 extern "C" RENDERER_API float getFps(Window* window);
 
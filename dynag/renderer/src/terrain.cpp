@@ -0,0 +1,286 @@
+#include "terrain.h"
+
+#include <algorithm>
+#include <climits>
+
+Terrain::Terrain(std::string const &height_map_path,
+                 std::string const &normal_map_path,
+                 std::string const &texture_path,
+                 float fNorthSpan, float fEastSpan, float fMaxHeight,
+                 std::string vertex_shader_file_path,
+                 std::string fragment_shader_file_path)
+    : Model(vertex_shader_file_path, fragment_shader_file_path)
+{
+    // Height map is read as 16-bit like dynamics to have the same heights.
+    int iNrComponents;
+    unsigned short* shHeightMap = stbi_load_16(height_map_path.c_str(), &iMapWidth, &iMapHeight, &iNrComponents, 1);
+    std::vector<unsigned short> vFlat;
+    if (!shHeightMap)
+    {
+        std::cout << "Height map failed to load at path: " << height_map_path << std::endl;
+        iMapWidth = iMapHeight = 2;
+        vFlat.assign(4, 0);
+    }
+    const unsigned short* shHeights = shHeightMap ? shHeightMap : vFlat.data();
+
+    vPixelSize = glm::vec2(fNorthSpan / iMapHeight, fEastSpan / iMapWidth);
+    vMapCenter = glm::vec2(iMapHeight / 2.0f, iMapWidth / 2.0f);
+    fHeightScale = fMaxHeight;
+
+    // Rows of the maps are tightly packed.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glGenTextures(1, &iHeightMap);
+    glBindTexture(GL_TEXTURE_2D, iHeightMap);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R16, iMapWidth, iMapHeight, 0, GL_RED, GL_UNSIGNED_SHORT, shHeights);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    buildMinMax(shHeights);
+    if (shHeightMap) stbi_image_free(shHeightMap);
+
+    // Normal map
+    int iNormalWidth, iNormalHeight;
+    unsigned char* cNormalMap = stbi_load(normal_map_path.c_str(), &iNormalWidth, &iNormalHeight, &iNrComponents, 3);
+    glGenTextures(1, &iNormalMap);
+    glBindTexture(GL_TEXTURE_2D, iNormalMap);
+    if (cNormalMap)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, iNormalWidth, iNormalHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, cNormalMap);
+        stbi_image_free(cNormalMap);
+    }
+    else
+    {
+        std::cout << "Normal map failed to load at path: " << normal_map_path << std::endl;
+        unsigned char up[3] = {128, 128, 255};
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, up);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Diffuse texture
+    size_t iSeparator = texture_path.find_last_of('/');
+    iDiffuse = TextureFromFile(texture_path.substr(iSeparator + 1).c_str(), texture_path.substr(0, iSeparator));
+
+    buildPatch();
+
+    // Set uniforms which do not change.
+    shader->use();
+    shader->setInt("texture_diffuse", 0);
+    shader->setInt("height_map", 1);
+    shader->setInt("normal_map", 2);
+    shader->setFloat("opacity", 1.0f);
+    shader->setVec2("pixelSize", vPixelSize);
+    shader->setVec2("mapCenter", vMapCenter);
+    shader->setFloat("heightScale", fHeightScale);
+    iChunkOriginLoc = glGetUniformLocation(shader->ID, "chunkOrigin");
+    iChunkStepLoc = glGetUniformLocation(shader->ID, "chunkStep");
+    iSkirtDepthLoc = glGetUniformLocation(shader->ID, "skirtDepth");
+}
+
+Terrain::~Terrain()
+{
+    glDeleteVertexArrays(1, &iVao);
+    glDeleteBuffers(1, &iVbo);
+    glDeleteBuffers(1, &iEbo);
+    glDeleteTextures(1, &iHeightMap);
+    glDeleteTextures(1, &iNormalMap);
+    glDeleteTextures(1, &iDiffuse);
+}
+
+void Terrain::buildPatch()
+{
+    // Vertices are (x, y, skirt) where x and y are grid coordinates. The outer ring
+    // duplicates the border of the patch and it is lowered in the vertex shader
+    // to create skirts.
+    std::vector<glm::vec3> vVertices;
+    const int iSide = PATCH_SIZE + 3;
+    for (int j = -1; j <= PATCH_SIZE + 1; j++)
+    {
+        for (int i = -1; i <= PATCH_SIZE + 1; i++)
+        {
+            int x = std::min(std::max(i, 0), PATCH_SIZE);
+            int y = std::min(std::max(j, 0), PATCH_SIZE);
+            float fSkirt = (x != i || y != j) ? 1.0f : 0.0f;
+            vVertices.push_back(glm::vec3((float)x, (float)y, fSkirt));
+        }
+    }
+
+    // Triangles are counter-clockwise when they are seen from above.
+    std::vector<unsigned int> vIndices;
+    for (int j = 0; j < iSide - 1; j++)
+    {
+        for (int i = 0; i < iSide - 1; i++)
+        {
+            unsigned int i00 = j * iSide + i;
+            unsigned int i10 = i00 + 1;
+            unsigned int i01 = i00 + iSide;
+            unsigned int i11 = i01 + 1;
+            vIndices.push_back(i00); vIndices.push_back(i01); vIndices.push_back(i10);
+            vIndices.push_back(i10); vIndices.push_back(i01); vIndices.push_back(i11);
+        }
+    }
+    iIndexCount = (unsigned int)vIndices.size();
+
+    glGenVertexArrays(1, &iVao);
+    glGenBuffers(1, &iVbo);
+    glGenBuffers(1, &iEbo);
+
+    glBindVertexArray(iVao);
+    glBindBuffer(GL_ARRAY_BUFFER, iVbo);
+    glBufferData(GL_ARRAY_BUFFER, vVertices.size() * sizeof(glm::vec3), vVertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iEbo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, vIndices.size() * sizeof(unsigned int), vIndices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glBindVertexArray(0);
+}
+
+void Terrain::buildMinMax(const unsigned short* shHeightMap)
+{
+    // Root chunk should cover the whole map with power of two number of leaf chunks.
+    iMaxDepth = 0;
+    iRootSize = PATCH_SIZE;
+    while (iRootSize < std::max(iMapWidth, iMapHeight) - 1)
+    {
+        iRootSize *= 2;
+        iMaxDepth++;
+    }
+
+    // Invalid chunks which are out of the map have min > max.
+    const glm::vec2 vEmpty(1.0f, 0.0f);
+    vMinMax.assign(iMaxDepth + 1, std::vector<glm::vec2>());
+
+    // Leaf chunks from pixels. Chunks share their border pixels.
+    int iLeafCount = 1 << iMaxDepth;
+    std::vector<glm::vec2>& vLeaves = vMinMax[iMaxDepth];
+    vLeaves.assign((size_t)iLeafCount * iLeafCount, vEmpty);
+    for (int cy = 0; cy < iLeafCount; cy++)
+    {
+        for (int cx = 0; cx < iLeafCount; cx++)
+        {
+            int x0 = cx * PATCH_SIZE, y0 = cy * PATCH_SIZE;
+            if (x0 >= iMapWidth || y0 >= iMapHeight) continue;
+            int x1 = std::min(x0 + PATCH_SIZE, iMapWidth - 1);
+            int y1 = std::min(y0 + PATCH_SIZE, iMapHeight - 1);
+            unsigned short shMin = USHRT_MAX, shMax = 0;
+            for (int y = y0; y <= y1; y++)
+            {
+                for (int x = x0; x <= x1; x++)
+                {
+                    unsigned short h = shHeightMap[y * iMapWidth + x];
+                    shMin = std::min(shMin, h);
+                    shMax = std::max(shMax, h);
+                }
+            }
+            vLeaves[cy * iLeafCount + cx] = glm::vec2(shMin, shMax) / (float)USHRT_MAX * fHeightScale;
+        }
+    }
+
+    // Parents from their children.
+    for (int d = iMaxDepth - 1; d >= 0; d--)
+    {
+        int iCount = 1 << d;
+        const std::vector<glm::vec2>& vChildren = vMinMax[d + 1];
+        vMinMax[d].assign((size_t)iCount * iCount, vEmpty);
+        for (int cy = 0; cy < iCount; cy++)
+        {
+            for (int cx = 0; cx < iCount; cx++)
+            {
+                glm::vec2 vRange = vEmpty;
+                for (int k = 0; k < 4; k++)
+                {
+                    const glm::vec2& vChild = vChildren[(2 * cy + k / 2) * 2 * iCount + 2 * cx + k % 2];
+                    if (vChild.x > vChild.y) continue;
+                    vRange = (vRange.x > vRange.y) ? vChild : glm::vec2(std::min(vRange.x, vChild.x), std::max(vRange.y, vChild.y));
+                }
+                vMinMax[d][cy * iCount + cx] = vRange;
+            }
+        }
+    }
+}
+
+void Terrain::chunkBounds(int iDepth, int iX, int iY, glm::vec3& vMin, glm::vec3& vMax) const
+{
+    int iSize = iRootSize >> iDepth;
+    float x0 = (float)(iX * iSize), x1 = (float)std::min(iX * iSize + iSize, iMapWidth - 1);
+    float y0 = (float)(iY * iSize), y1 = (float)std::min(iY * iSize + iSize, iMapHeight - 1);
+    const glm::vec2& vRange = vMinMax[iDepth][iY * (1 << iDepth) + iX];
+
+    // Box in model space which includes skirts.
+    float fSkirt = (iSize / PATCH_SIZE) * vPixelSize.x;
+    glm::vec3 vLocalMin((x0 - vMapCenter.x) * vPixelSize.x, vRange.x - fSkirt, (y0 - vMapCenter.y) * vPixelSize.y);
+    glm::vec3 vLocalMax((x1 - vMapCenter.x) * vPixelSize.x, vRange.y, (y1 - vMapCenter.y) * vPixelSize.y);
+
+    // Transform box to world space.
+    transformBox(mModel, vLocalMin, vLocalMax, vMin, vMax);
+}
+
+void Terrain::selectChunk(int iDepth, int iX, int iY, const Frustum& frustum, const glm::vec3& vCameraPosition)
+{
+    const glm::vec2& vRange = vMinMax[iDepth][iY * (1 << iDepth) + iX];
+    if (vRange.x > vRange.y) return; // out of the map
+
+    glm::vec3 vMin, vMax;
+    chunkBounds(iDepth, iX, iY, vMin, vMax);
+    if (!frustum.isBoxVisible(vMin, vMax) || 
+        (fMaxDrawDistance > 0.0f && distanceToBox(vCameraPosition, vMin, vMax) > fMaxDrawDistance))
+    {
+        iCulledCount++;
+        return;
+    }
+
+    // Split chunk if camera is close enough w.r.t its size.
+    int iSize = iRootSize >> iDepth;
+    float fDistance = distanceToBox(vCameraPosition, vMin, vMax);
+    if (iDepth < iMaxDepth && fDistance < fLodDistanceFactor * iSize * vPixelSize.x)
+    {
+        for (int k = 0; k < 4; k++)
+            selectChunk(iDepth + 1, 2 * iX + k % 2, 2 * iY + k / 2, frustum, vCameraPosition);
+        return;
+    }
+
+    int iStep = iSize / PATCH_SIZE;
+    glUniform2f(iChunkOriginLoc, (float)(iX * iSize), (float)(iY * iSize));
+    glUniform1f(iChunkStepLoc, (float)iStep);
+    glUniform1f(iSkirtDepthLoc, iStep * vPixelSize.x);
+    glDrawElements(GL_TRIANGLES, (int)iIndexCount, GL_UNSIGNED_INT, 0);
+    iDrawnCount++;
+}
+
+void Terrain::draw(const Frustum& frustum, const glm::vec3& vCameraPosition)
+{
+    // Use terrain's shader and set some uniforms.
+    shader->use();
+
+    applyContainers();
+
+    shader->setMat4("model", mModel);
+    shader->setMat4("inversedTransposedModel", glm::inverseTranspose(mModel));
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, iDiffuse);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, iHeightMap);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, iNormalMap);
+
+    // Draw visible chunks.
+    iDrawnCount = 0;
+    iCulledCount = 0;
+    glBindVertexArray(iVao);
+    selectChunk(0, 0, 0, frustum, vCameraPosition);
+    glBindVertexArray(0);
+
+    glActiveTexture(GL_TEXTURE0);
+
+    mModel = mBaseModel;
+    shader->setMat4("model", mModel);
+
+    resetContainers();
+}
@@ -0,0 +1,89 @@
+/*
+* DynaG Renderer C++ / Terrain
+*
+* Chunked LOD terrain which is generated from the same height and normal maps
+* as the dynamics. Terrain is a quadtree of chunks. Each chunk is drawn with
+* the same grid patch whose vertices are displaced in the vertex shader by
+* fetching height map texels. Chunks are culled w.r.t camera frustum and their
+* level of detail is selected w.r.t distance to the camera.
+*
+* Author : @MGokcayK
+*
+* C.Date : 19/10/2026
+* Update : 19/10/2026 - Create & Implementation // @MGokcayK
+* Update : 19/10/2026 - Chunks are counted in draw counts of model // @MGokcayK
+*/
+
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include "model.h"
+
+class Terrain : public Model
+{
+public:
+    // Distance factor for LOD selection. Chunk is split into its children when
+    // camera is closer than `fLodDistanceFactor` times size of the chunk.
+    float fLodDistanceFactor = 2.0f;
+
+    // Constructor of terrain. Spans are sizes of terrain in north-south and
+    // east-west axes and max height is the height of the white pixel of the
+    // height map. They should be in renderer units (i.e. meters).
+    Terrain(std::string const &height_map_path,
+            std::string const &normal_map_path,
+            std::string const &texture_path,
+            float fNorthSpan, float fEastSpan, float fMaxHeight,
+            std::string vertex_shader_file_path,
+            std::string fragment_shader_file_path);
+
+    ~Terrain();
+
+    // Select visible chunks and draw them.
+    void draw(const Frustum& frustum, const glm::vec3& vCameraPosition) override;
+
+private:
+    // Number of grid quads in each axis of a chunk.
+    static const int PATCH_SIZE = 32;
+
+    // Height map size in pixels.
+    int iMapWidth, iMapHeight;
+
+    // Size of a pixel in north and east axes, map center in pixels and height of
+    // the white pixel. Columns of the map are along north axis and rows of the 
+    // map are along east axis as in `HelicopterDynamics::getGroundHeightNormal`.
+    glm::vec2 vPixelSize;
+    glm::vec2 vMapCenter;
+    float fHeightScale;
+
+    // Uniform locations which are set for each chunk.
+    int iChunkOriginLoc, iChunkStepLoc, iSkirtDepthLoc;
+
+    // Pixel size of the root chunk and depth of the leaf chunks whose grid step is one pixel.
+    int iRootSize;
+    int iMaxDepth;
+
+    // Textures of terrain.
+    unsigned int iHeightMap, iNormalMap, iDiffuse;
+
+    // Grid patch which is shared by all chunks.
+    unsigned int iVao, iVbo, iEbo;
+    unsigned int iIndexCount;
+
+    // Min/max heights of chunks for each depth of quadtree. Chunk (x, y) of
+    // depth d is stored at index y * 2^d + x.
+    std::vector<std::vector<glm::vec2>> vMinMax;
+
+    // Create grid patch with skirts to hide the cracks between different LODs.
+    void buildPatch();
+
+    // Create min/max heights of all chunks from the height map.
+    void buildMinMax(const unsigned short* shHeightMap);
+
+    // World space bounding box of the chunk.
+    void chunkBounds(int iDepth, int iX, int iY, glm::vec3& vMin, glm::vec3& vMax) const;
+
+    // Traverse the quadtree to cull and draw chunks.
+    void selectChunk(int iDepth, int iX, int iY, const Frustum& frustum, const glm::vec3& vCameraPosition);
+};
+
+#endif